@@ -160,6 +160,24 @@ macro(import_gtest)
     endif()
 endmacro()
 
+# Macro to import Google Benchmark
+macro(import_benchmark)
+    if(NOT TARGET benchmark::benchmark)  # Guard to prevent multiple inclusion
+        FetchContent_Declare(
+            googlebenchmark
+            GIT_REPOSITORY https://github.com/google/benchmark.git
+            GIT_TAG v1.8.3
+        )
+        
+        # Configure benchmark build options (gtest is already imported above)
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        
+        FetchContent_MakeAvailable(googlebenchmark)
+    endif()
+endmacro()
+
 # Macro to import all dependencies
 macro(importDependencies)
     message(STATUS "Starting to import dependencies...")
@@ -196,5 +214,9 @@ macro(importDependencies)
     import_gtest()
     message(STATUS "Google Test imported successfully.")
 
+    message(STATUS "Importing Google Benchmark...")
+    import_benchmark()
+    message(STATUS "Google Benchmark imported successfully.")
+
     message(STATUS "All dependencies have been imported successfully.")
 endmacro()
\ No newline at end of file
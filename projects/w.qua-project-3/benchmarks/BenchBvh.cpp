@@ -0,0 +1,149 @@
+/**
+ * @file BenchBvh.cpp
+ * @brief Benchmarks for the top-down and bottom-up BVH builders.
+ *
+ * Builders are parameterised over the object count, the object distribution and
+ * the bounding volume type. Run through the run_w.qua-project-3_benchmarks target
+ * to get JSON output (benchmark_results/w.qua-project-3.json) that can be diffed
+ * between commits.
+ */
+
+#include <benchmark/benchmark.h>
+#include "Registry.hpp"
+#include "Components.hpp"
+#include "Bvh.hpp"
+#include <random>
+
+namespace
+{
+    enum class Distribution
+    {
+        Uniform = 0,  // Small boxes spread evenly through the volume
+        Clustered,    // Gaussian clumps around a few centres
+        LongThin      // UNC-like pipes: one long axis, two thin ones
+    };
+
+    /**
+     * @brief Fills a registry with boxes that need no mesh resource.
+     *        The AABB, sphere and OBB are all precomputed so any volume type can be built.
+     * @param registry Registry to populate
+     * @param count Number of entities to create
+     * @param distribution Placement and shape of the boxes
+     * @return Created entities
+     */
+    std::vector<Registry::Entity> PopulateScene(Registry& registry, size_t count, Distribution distribution)
+    {
+        // Fixed seed so every run measures the same scene
+        std::mt19937 rng(1234u);
+        const float halfSize = 50.0f * std::cbrt(static_cast<float>(count) / 1000.0f);
+        std::uniform_real_distribution<float> position(-halfSize, halfSize);
+        std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+        std::vector<glm::vec3> clusterCentres(16);
+        for (auto& centre : clusterCentres)
+            centre = glm::vec3(position(rng), position(rng), position(rng));
+        std::normal_distribution<float> clusterOffset(0.0f, halfSize * 0.05f);
+        std::uniform_int_distribution<size_t> clusterIndex(0, clusterCentres.size() - 1);
+
+        std::uniform_real_distribution<float> pipeLength(5.0f, 40.0f);
+        std::uniform_real_distribution<float> pipeWidth(0.1f, 0.5f);
+        std::uniform_int_distribution<int> pipeAxis(0, 2);
+
+        std::vector<Registry::Entity> entities;
+        entities.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            glm::vec3 centre;
+            glm::vec3 extents;
+            switch (distribution)
+            {
+                case Distribution::Uniform:
+                    centre  = glm::vec3(position(rng), position(rng), position(rng));
+                    extents = glm::vec3(size(rng), size(rng), size(rng)) * 0.5f;
+                    break;
+
+                case Distribution::Clustered:
+                    centre  = clusterCentres[clusterIndex(rng)] +
+                              glm::vec3(clusterOffset(rng), clusterOffset(rng), clusterOffset(rng));
+                    extents = glm::vec3(size(rng), size(rng), size(rng)) * 0.5f;
+                    break;
+
+                case Distribution::LongThin:
+                    centre  = glm::vec3(position(rng), position(rng), position(rng));
+                    extents = glm::vec3(pipeWidth(rng), pipeWidth(rng), pipeWidth(rng));
+                    extents[pipeAxis(rng)] = pipeLength(rng) * 0.5f;
+                    break;
+            }
+
+            auto entity = registry.Create();
+            registry.AddComponent<TransformComponent>(entity, centre);
+            auto& bounds = registry.AddComponent<BoundingComponent>(entity);
+            bounds.m_AABB = Aabb(-extents, extents);
+            bounds.m_PCASphere = Sphere(glm::vec3(0.0f), glm::length(extents));
+            bounds.m_OBB.halfExtents = extents;
+            bounds.m_AABBComputed = true;
+            bounds.m_PCAComputed = true;
+            bounds.m_OBBComputed = true;
+            entities.push_back(entity);
+        }
+        return entities;
+    }
+
+    // Object counts 1k-1M for every distribution and volume type
+    void TopDownArgs(benchmark::internal::Benchmark* bench)
+    {
+        bench->ArgNames({ "objects", "distribution", "volume" });
+        for (int64_t count : { 1000, 10000, 100000, 1000000 })
+            for (int64_t distribution = 0; distribution <= 2; ++distribution)
+                for (int64_t volume = 0; volume <= 2; ++volume)
+                    bench->Args({ count, distribution, volume });
+    }
+
+    // The greedy bottom-up merge is cubic in the object count, so it stays small
+    void BottomUpArgs(benchmark::internal::Benchmark* bench)
+    {
+        bench->ArgNames({ "objects", "distribution", "volume" });
+        for (int64_t count : { 64, 256, 1024 })
+            for (int64_t distribution = 0; distribution <= 2; ++distribution)
+                for (int64_t volume = 0; volume <= 2; ++volume)
+                    bench->Args({ count, distribution, volume });
+    }
+}
+
+static void BM_BvhBuildTopDown(benchmark::State& state, TDSSplitStrategy strategy)
+{
+    Registry registry;
+    auto entities = PopulateScene(registry, static_cast<size_t>(state.range(0)), static_cast<Distribution>(state.range(1)));
+    BvhBuildConfig::s_BVType = static_cast<BvhVolumeType>(state.range(2));
+
+    Bvh bvh;
+    for (auto _ : state)
+    {
+        bvh.BuildTopDown(registry, entities, strategy, TDSTermination::SingleObject);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    BvhBuildConfig::s_BVType = BvhVolumeType::Aabb;
+}
+BENCHMARK_CAPTURE(BM_BvhBuildTopDown, MedianCenter, TDSSplitStrategy::MedianCenter)->Apply(TopDownArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BvhBuildTopDown, MedianExtent, TDSSplitStrategy::MedianExtent)->Apply(TopDownArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BvhBuildTopDown, KEven, TDSSplitStrategy::KEven)->Apply(TopDownArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_BvhBuildBottomUp(benchmark::State& state, BUSHeuristic heuristic)
+{
+    Registry registry;
+    auto entities = PopulateScene(registry, static_cast<size_t>(state.range(0)), static_cast<Distribution>(state.range(1)));
+    BvhBuildConfig::s_BVType = static_cast<BvhVolumeType>(state.range(2));
+
+    Bvh bvh;
+    for (auto _ : state)
+    {
+        bvh.BuildBottomUp(registry, entities, heuristic);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    BvhBuildConfig::s_BVType = BvhVolumeType::Aabb;
+}
+BENCHMARK_CAPTURE(BM_BvhBuildBottomUp, NearestCenter, BUSHeuristic::NearestCenter)->Apply(BottomUpArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BvhBuildBottomUp, MinCombinedVolume, BUSHeuristic::MinCombinedVolume)->Apply(BottomUpArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BvhBuildBottomUp, MinCombinedSurfaceArea, BUSHeuristic::MinCombinedSurfaceArea)->Apply(BottomUpArgs)->Unit(benchmark::kMillisecond);
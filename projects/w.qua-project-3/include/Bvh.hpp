@@ -16,6 +16,7 @@
 #include "Shapes.hpp"
 #include "Registry.hpp"
 #include "Components.hpp"
+#include "SpatialStats.hpp"
 #include <memory>
 #include <unordered_map>
 
@@ -201,6 +202,44 @@ public:
      */
     static int ChooseSplitAxis(const std::vector<glm::vec3>& extents);
 
+    /**
+     * @brief Collects every entity whose world AABB is not outside the frustum.
+     *
+     * Nodes are culled with the volume type the hierarchy was built with; OBB
+     * nodes are tested through their enclosing AABB.
+     *
+     * @param registry       ECS registry used to fetch the leaves' bounding data.
+     * @param planeNormals   The 6 frustum plane normals.
+     * @param planeDistances The 6 frustum plane distances.
+     * @param out            Receives the entities (appended).
+     */
+    void QueryFrustum(Registry& registry,
+                      const glm::vec3 planeNormals[6], const float planeDistances[6],
+                      std::vector<Entity>& out);
+
+    /**
+     * @brief Enables or disables counting the work done by queries.
+     */
+    void SetQueryStatsEnabled(bool enabled) { m_QueryStatsEnabled = enabled; }
+
+    /**
+     * @brief Checks whether query counters are being accumulated.
+     */
+    bool IsQueryStatsEnabled() const { return m_QueryStatsEnabled; }
+
+    /**
+     * @brief Zeroes the accumulated query counters.
+     */
+    void ResetQueryStats() { m_QueryStats = SpatialQueryStats(); }
+
+    /**
+     * @brief Walks the hierarchy and reports its shape, footprint and query counters.
+     *
+     * Depths are measured from the root, also for bottom-up builds whose nodes
+     * store their height instead.
+     */
+    SpatialTreeStats GetStats() const;
+
 private:
     /**
      * @brief Computes a world-space axis-aligned bounding box that encloses all
@@ -214,6 +253,17 @@ private:
 
     std::unique_ptr<TreeNode> m_Root = nullptr;            // root of new tree
 
+    // Volume type the nodes were built with; only that volume is valid per node
+    BvhVolumeType m_BuiltVolume = BvhVolumeType::Aabb;
+
+    bool              m_QueryStatsEnabled = false;
+    SpatialQueryStats m_QueryStats;
+
+    // Helper to recursively run a frustum query below a node
+    void QueryFrustumNode(Registry& registry, const TreeNode* node,
+                          const glm::vec3 planeNormals[6], const float planeDistances[6],
+                          std::vector<Entity>& out, SpatialQueryStats* stats) const;
+
     // Flat representation produced from m_Root for rendering convenience
     mutable std::vector<int> m_FlatDepths;                 // depth per renderable (parallel to CreateRenderables result)
 
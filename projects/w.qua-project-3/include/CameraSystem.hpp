@@ -277,6 +277,18 @@ public:
      */
     glm::vec3 GetFrustumTestColor(SideResult result) const;
     
+    /**
+     * @brief Gets the frustum plane normals from the last UpdateFrustumPlanes call.
+     * @return Array of 6 plane normals
+     */
+    const glm::vec3* GetFrustumNormals() const { return m_FrustumNormals; }
+    
+    /**
+     * @brief Gets the frustum plane distances from the last UpdateFrustumPlanes call.
+     * @return Array of 6 plane distances
+     */
+    const float* GetFrustumDistances() const { return m_FrustumDistances; }
+    
     /**
      * @brief Gets the view-projection matrix for visualization.
      * @param camera Camera component to get view-projection from
@@ -115,6 +115,11 @@ public:
      */
     void RenderBVHControls(Registry& registry);
 
+    /**
+     * @brief Renders BVH structure statistics and frustum query costs.
+     */
+    void RenderBVHStats();
+
 private:
     Window& m_Window;
     bool m_Initialized = false;
@@ -33,6 +33,11 @@ public:
      * @param shader Shared pointer to the shader program
      */
     RenderSystem(Registry& registry, Window& window, const std::shared_ptr<Shader>& shader);
+
+    /**
+     * @brief Stops the render system's change tracking.
+     */
+    ~RenderSystem();
     
     /**
      * @brief Initializes the render system and OpenGL resources.
@@ -187,6 +192,12 @@ public:
 
     void MarkBVHDirty() { m_BvhDirty = true; }
 
+    // BVH query statistics: an instrumented camera frustum query runs every frame while measuring
+    void SetMeasureBvhQueries(bool enable);
+    bool IsMeasuringBvhQueries() const { return m_MeasureBvhQueries; }
+    void ResetBvhQueryStats();
+    SpatialTreeStats GetBvhStats() const;
+
     // Light animation speed (radians per second)
     float GetLightRotationSpeed() const { return m_LightRotationSpeed; }
     void  SetLightRotationSpeed(float radiansPerSec) { m_LightRotationSpeed = radiansPerSec; }
@@ -260,4 +271,13 @@ private:
     std::vector<int> m_BvhRenderableDepths;
 
     bool m_BvhDirty = true;
+    Registry::ChangeConsumerId m_BvhChanges = 0; // Entities moved, added or removed since the last frame
+
+    /**
+     * @brief Refits the BVH leaves of entities that changed since last frame and marks it dirty.
+     */
+    void ConsumeBvhChanges();
+
+    bool m_MeasureBvhQueries = false;
+    std::vector<Registry::Entity> m_BvhQueryResults; // Reused scratch list
 }; 
\ No newline at end of file
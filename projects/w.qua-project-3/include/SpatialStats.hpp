@@ -0,0 +1,90 @@
+/**
+ * @file SpatialStats.hpp
+ * @brief Query counters and structural statistics reported by the BVH.
+ *
+ * Query counters are opt-in (Bvh::SetQueryStatsEnabled) so normal queries
+ * do no bookkeeping; structural statistics are computed on demand by GetStats.
+ */
+
+#pragma once
+
+#include "pch.h"
+
+/**
+ * @brief Work done by the queries run since the counters were last reset.
+ */
+struct SpatialQueryStats
+{
+    uint64_t m_Queries          = 0; ///< Queries run
+    uint64_t m_NodesVisited     = 0; ///< Nodes whose bounds were classified
+    uint64_t m_PrimitivesTested = 0; ///< Object bounds tested individually
+    uint64_t m_CulledSubtrees   = 0; ///< Early-outs: node outside, subtree skipped
+    uint64_t m_AcceptedSubtrees = 0; ///< Early-outs: node fully inside, subtree taken without tests
+    uint64_t m_Results          = 0; ///< Objects returned
+
+    /**
+     * @brief Averages a counter over the queries run.
+     * @param total Counter value
+     * @return Counter per query, 0 if no query ran
+     */
+    double PerQuery(uint64_t total) const
+    {
+        return m_Queries ? static_cast<double>(total) / static_cast<double>(m_Queries) : 0.0;
+    }
+};
+
+/**
+ * @brief Shape and size of a tree plus its accumulated query counters.
+ */
+struct SpatialTreeStats
+{
+    // Leaves holding this many objects or more share the last occupancy bucket
+    static constexpr size_t kOccupancyBuckets = 17;
+
+    size_t m_NodeCount        = 0;
+    size_t m_LeafCount        = 0;
+    size_t m_EmptyLeafCount   = 0;
+    size_t m_ObjectReferences = 0; ///< Entity references stored across all nodes
+    size_t m_MaxDepth         = 0;
+    size_t m_MemoryBytes      = 0; ///< Nodes plus the capacity of their object lists
+    std::vector<size_t> m_DepthHistogram;         ///< Nodes per depth
+    std::vector<size_t> m_LeafOccupancyHistogram; ///< Leaves per object count
+    SpatialQueryStats   m_Queries;
+
+    /**
+     * @brief Accounts for one node while walking a tree.
+     * @param depth Node depth, 0 for the root
+     * @param leaf True if the node has no children
+     * @param objectCount Objects stored in the node itself
+     * @param bytes Memory owned by the node
+     */
+    void AddNode(size_t depth, bool leaf, size_t objectCount, size_t bytes)
+    {
+        ++m_NodeCount;
+        m_ObjectReferences += objectCount;
+        m_MemoryBytes      += bytes;
+        m_MaxDepth          = std::max(m_MaxDepth, depth);
+
+        if (m_DepthHistogram.size() <= depth)
+            m_DepthHistogram.resize(depth + 1, 0);
+        ++m_DepthHistogram[depth];
+
+        if (!leaf)
+            return;
+
+        ++m_LeafCount;
+        if (objectCount == 0)
+            ++m_EmptyLeafCount;
+        m_LeafOccupancyHistogram.resize(kOccupancyBuckets, 0);
+        ++m_LeafOccupancyHistogram[std::min(objectCount, kOccupancyBuckets - 1)];
+    }
+
+    /**
+     * @brief Gets the fraction of leaves that hold no objects.
+     * @return Empty leaves / leaves, 0 for an empty tree
+     */
+    double GetEmptyLeafRatio() const
+    {
+        return m_LeafCount ? static_cast<double>(m_EmptyLeafCount) / static_cast<double>(m_LeafCount) : 0.0;
+    }
+};
@@ -2,6 +2,7 @@
 #include "CubeRenderer.hpp"
 #include "SphereRenderer.hpp"
 #include "Shader.hpp"
+#include "Geometry.hpp"
 
 // Forward declaration
 static std::unique_ptr<TreeNode> BuildTopDownTree(Registry& registry,
@@ -287,6 +288,7 @@ void Bvh::BuildTopDown(Registry& registry,
 {
     Clear();
     if (objects.empty()) return;
+    m_BuiltVolume = BvhBuildConfig::s_BVType;
 
     // Make a mutable copy so we can partition in-place with nth_element
     std::vector<Entity> objs = objects;
@@ -321,6 +323,7 @@ void Bvh::BuildBottomUp(Registry& registry,
 {
     Clear();
     if (objects.empty()) return;
+    m_BuiltVolume = BvhBuildConfig::s_BVType;
 
     // Active list owns its nodes via unique_ptr
     std::vector<std::unique_ptr<TreeNode>> active;
@@ -714,4 +717,118 @@ static std::unique_ptr<TreeNode> BuildTopDownTree(Registry& registry,
     }
 
     return node;
-} 
\ No newline at end of file
+}
+
+// Classifies a node against the frustum using the volume the hierarchy was built with
+static SideResult ClassifyNode(const TreeNode* node, BvhVolumeType volume,
+                               const glm::vec3 planeNormals[6], const float planeDistances[6])
+{
+    Vertex min{}, max{};
+    switch (volume)
+    {
+        case BvhVolumeType::Sphere:
+        {
+            Vertex center{};
+            center.m_Position = node->sphere.center;
+            return ClassifyFrustumSphereNaive(planeNormals, planeDistances, center, node->sphere.radius);
+        }
+        case BvhVolumeType::Obb:
+        {
+            // Enclosing AABB of the OBB: conservative, so culling stays correct
+            glm::vec3 reach(0.0f);
+            for (int i = 0; i < 3; ++i)
+                reach += glm::abs(node->obb.axes[i]) * node->obb.halfExtents[i];
+            min.m_Position = node->obb.center - reach;
+            max.m_Position = node->obb.center + reach;
+            break;
+        }
+        case BvhVolumeType::Aabb:
+        default:
+            min.m_Position = node->aabb.min;
+            max.m_Position = node->aabb.max;
+            break;
+    }
+    return ClassifyFrustumAabbNaive(planeNormals, planeDistances, min, max);
+}
+
+static void AppendSubtree(const TreeNode* node, std::vector<Registry::Entity>& out)
+{
+    if (!node) return;
+    out.insert(out.end(), node->objects.begin(), node->objects.end());
+    AppendSubtree(node->lChild.get(), out);
+    AppendSubtree(node->rChild.get(), out);
+}
+
+void Bvh::QueryFrustum(Registry& registry,
+                       const glm::vec3 planeNormals[6], const float planeDistances[6],
+                       std::vector<Entity>& out)
+{
+    SpatialQueryStats* stats = m_QueryStatsEnabled ? &m_QueryStats : nullptr;
+    size_t firstResult = out.size();
+    QueryFrustumNode(registry, m_Root.get(), planeNormals, planeDistances, out, stats);
+
+    if (stats)
+    {
+        ++stats->m_Queries;
+        stats->m_Results += out.size() - firstResult;
+    }
+}
+
+void Bvh::QueryFrustumNode(Registry& registry, const TreeNode* node,
+                           const glm::vec3 planeNormals[6], const float planeDistances[6],
+                           std::vector<Entity>& out, SpatialQueryStats* stats) const
+{
+    if (!node) return;
+
+    if (stats) ++stats->m_NodesVisited;
+    SideResult side = ClassifyNode(node, m_BuiltVolume, planeNormals, planeDistances);
+    if (side == SideResult::eOUTSIDE)
+    {
+        if (stats) ++stats->m_CulledSubtrees;
+        return;
+    }
+    if (side == SideResult::eINSIDE)
+    {
+        // Everything below is inside too; no further tests needed
+        if (stats) ++stats->m_AcceptedSubtrees;
+        AppendSubtree(node, out);
+        return;
+    }
+
+    for (Entity entity : node->objects)
+    {
+        if (stats) ++stats->m_PrimitivesTested;
+        Aabb box = ComputeAabbRange(registry, &entity, 1);
+        Vertex min{}, max{};
+        min.m_Position = box.min;
+        max.m_Position = box.max;
+        if (ClassifyFrustumAabbNaive(planeNormals, planeDistances, min, max) != SideResult::eOUTSIDE)
+        {
+            out.push_back(entity);
+        }
+    }
+
+    QueryFrustumNode(registry, node->lChild.get(), planeNormals, planeDistances, out, stats);
+    QueryFrustumNode(registry, node->rChild.get(), planeNormals, planeDistances, out, stats);
+}
+
+static void AccumulateTreeStats(const TreeNode* node, size_t depth, SpatialTreeStats& stats)
+{
+    if (!node) return;
+    AccumulateTreeStats(node->lChild.get(), depth + 1, stats);
+    AccumulateTreeStats(node->rChild.get(), depth + 1, stats);
+
+    bool leaf = !node->lChild && !node->rChild;
+    size_t bytes = sizeof(TreeNode) + node->objects.capacity() * sizeof(Registry::Entity);
+    stats.AddNode(depth, leaf, node->objects.size(), bytes);
+}
+
+SpatialTreeStats Bvh::GetStats() const
+{
+    SpatialTreeStats stats;
+    AccumulateTreeStats(m_Root.get(), 0, stats);
+    // The entity-to-leaf map is part of the structure's footprint too
+    stats.m_MemoryBytes += m_EntityToLeaf.size() * (sizeof(Entity) + sizeof(TreeNode*));
+    stats.m_Queries = m_QueryStats;
+    return stats;
+}
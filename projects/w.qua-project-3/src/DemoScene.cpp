@@ -190,6 +190,7 @@ namespace DemoScene
             auto &transform = registry.GetComponent<TransformComponent>(entity);
             transform.m_Scale = glm::vec3(scale);
             transform.UpdateModelMatrix();
+            registry.MarkChanged<TransformComponent>(entity);
             EventSystem::Get().FireEvent(EventType::TransformChanged, entity);
         }
     }
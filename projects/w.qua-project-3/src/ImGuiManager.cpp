@@ -146,6 +146,12 @@ void ImGuiManager::RenderMainWindow(Registry& registry)
     ImGui::Text("BVH Controls:");
     RenderBVHControls(registry);
 
+    // Walks the hierarchy, so only while the section is open
+    if (ImGui::CollapsingHeader("BVH Statistics"))
+    {
+        RenderBVHStats();
+    }
+
     ImGui::End();
 }
 
@@ -499,4 +505,56 @@ void ImGuiManager::RenderBVHControls(Registry& registry)
     }
 
     ImGui::Separator();
-} 
\ No newline at end of file
+}
+
+void ImGuiManager::RenderBVHStats()
+{
+    if (!Systems::g_RenderSystem)
+    {
+        ImGui::Text("Render system not available");
+        return;
+    }
+
+    bool measure = Systems::g_RenderSystem->IsMeasuringBvhQueries();
+    if (ImGui::Checkbox("Measure Frustum Queries", &measure))
+    {
+        Systems::g_RenderSystem->SetMeasureBvhQueries(measure);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Counters"))
+    {
+        Systems::g_RenderSystem->ResetBvhQueryStats();
+    }
+
+    SpatialTreeStats stats = Systems::g_RenderSystem->GetBvhStats();
+    if (stats.m_NodeCount == 0)
+    {
+        ImGui::Text("BVH not built");
+        return;
+    }
+
+    ImGui::Text("Nodes: %zu  Leaves: %zu  Max depth: %zu", stats.m_NodeCount, stats.m_LeafCount, stats.m_MaxDepth);
+    ImGui::Text("Empty leaves: %zu (%.1f%%)  Object refs: %zu", stats.m_EmptyLeafCount,
+                stats.GetEmptyLeafRatio() * 100.0, stats.m_ObjectReferences);
+    ImGui::Text("Memory: %.1f KB", static_cast<double>(stats.m_MemoryBytes) / 1024.0);
+
+    std::vector<float> depths(stats.m_DepthHistogram.begin(), stats.m_DepthHistogram.end());
+    ImGui::PlotHistogram("Nodes / depth", depths.data(), static_cast<int>(depths.size()), 0, nullptr,
+                         0.0f, FLT_MAX, ImVec2(0.0f, 50.0f));
+    std::vector<float> occupancy(stats.m_LeafOccupancyHistogram.begin(), stats.m_LeafOccupancyHistogram.end());
+    ImGui::PlotHistogram("Leaves / object count", occupancy.data(), static_cast<int>(occupancy.size()), 0, nullptr,
+                         0.0f, FLT_MAX, ImVec2(0.0f, 50.0f));
+
+    const SpatialQueryStats& q = stats.m_Queries;
+    if (q.m_Queries == 0)
+    {
+        ImGui::Text("No queries measured");
+        return;
+    }
+    ImGui::Text("Per query over %llu queries:", static_cast<unsigned long long>(q.m_Queries));
+    ImGui::Text("  Nodes visited:     %.1f", q.PerQuery(q.m_NodesVisited));
+    ImGui::Text("  Primitives tested: %.1f", q.PerQuery(q.m_PrimitivesTested));
+    ImGui::Text("  Subtrees culled:   %.1f", q.PerQuery(q.m_CulledSubtrees));
+    ImGui::Text("  Subtrees accepted: %.1f", q.PerQuery(q.m_AcceptedSubtrees));
+    ImGui::Text("  Results:           %.1f", q.PerQuery(q.m_Results));
+}
@@ -327,6 +327,7 @@ void PickingSystem::HandleMouseMove(const EventData& eventData)
         auto& transform = m_Registry.GetComponent<TransformComponent>(m_DraggingEntity);
         transform.m_Position = worldPos;
         transform.UpdateModelMatrix();
+        m_Registry.MarkChanged<TransformComponent>(m_DraggingEntity);
 
         // Notify systems of transform change for this entity
         EventSystem::Get().FireEvent(EventType::TransformChanged, m_DraggingEntity);
@@ -8,6 +8,12 @@
 
 #include "Registry.hpp"
 
+namespace
+{
+    // What sparse_set::current reports for a slot the set does not hold
+    constexpr auto kNoVersion = entt::to_version(static_cast<Registry::Entity>(entt::tombstone));
+}
+
 Registry::Entity Registry::Create() 
 {
     return m_Registry.create();
@@ -16,4 +22,74 @@ Registry::Entity Registry::Create()
 void Registry::Destroy(Entity entity) 
 {
     m_Registry.destroy(entity);
-} 
\ No newline at end of file
+}
+
+Registry::ChangeConsumerId Registry::RegisterChangeConsumer()
+{
+    for (size_t i = 0; i < m_ChangeConsumers.size(); ++i)
+    {
+        if (!m_ChangeConsumers[i].m_Active)
+        {
+            m_ChangeConsumers[i].m_Active = true;
+            return i;
+        }
+    }
+    
+    m_ChangeConsumers.emplace_back().m_Active = true;
+    return m_ChangeConsumers.size() - 1;
+}
+
+void Registry::UnregisterChangeConsumer(ChangeConsumerId consumer)
+{
+    if (consumer >= m_ChangeConsumers.size())
+        return;
+    
+    ChangeConsumer& state = m_ChangeConsumers[consumer];
+    state.m_Changed.clear();
+    state.m_Removed.clear();
+    state.m_Consumed.m_Changed.clear();
+    state.m_Consumed.m_Removed.clear();
+    state.m_Active = false;
+}
+
+const Registry::ChangeSet& Registry::ConsumeChanges(ChangeConsumerId consumer)
+{
+    ChangeConsumer& state = m_ChangeConsumers[consumer];
+    state.m_Consumed.m_Changed.assign(state.m_Changed.begin(), state.m_Changed.end());
+    state.m_Consumed.m_Removed.assign(state.m_Removed.begin(), state.m_Removed.end());
+    state.m_Changed.clear();
+    state.m_Removed.clear();
+    return state.m_Consumed;
+}
+
+size_t Registry::GetPendingChangeCount(ChangeConsumerId consumer) const
+{
+    const ChangeConsumer& state = m_ChangeConsumers[consumer];
+    return state.m_Changed.size() + state.m_Removed.size();
+}
+
+void Registry::OnTrackedChange(entt::registry&, Entity entity)
+{
+    for (ChangeConsumer& state : m_ChangeConsumers)
+    {
+        if (!state.m_Active || state.m_Changed.contains(entity))
+            continue;
+        state.m_Changed.push(entity);
+    }
+}
+
+void Registry::OnTrackedRemove(entt::registry&, Entity entity)
+{
+    for (ChangeConsumer& state : m_ChangeConsumers)
+    {
+        if (!state.m_Active)
+            continue;
+        // A removed entity no longer needs its change applied, only its removal
+        state.m_Changed.remove(entity);
+
+        // contains() also compares versions, but a recycled entity shares its slot with the
+        // destroyed one. Keep the version queued first; it is the one the consumer knows.
+        if (state.m_Removed.current(entity) == kNoVersion)
+            state.m_Removed.push(entity);
+    }
+}
@@ -25,6 +25,8 @@
 RenderSystem::RenderSystem(Registry& registry, Window& window, const std::shared_ptr<Shader>& shader)
     : m_Registry(registry), m_Window(window), m_Shader(shader), m_GlobalWireframe(false)
 {
+    m_BvhChanges = m_Registry.RegisterChangeConsumer();
+
     window.SetFramebufferSizeCallback([](int width, int height)
         {
         glViewport(0, 0, width, height);
@@ -43,28 +45,6 @@ RenderSystem::RenderSystem(Registry& registry, Window& window, const std::shared
         }
     });
 
-    // Listen for transform changes to rebuild BVH automatically
-    EventSystem::Get().SubscribeToEvent(EventType::TransformChanged, [this](const EventData& eventData) 
-        {
-        if (m_Bvh)
-        {
-            if (auto entPtr = std::get_if<entt::entity>(&eventData))
-            {
-                m_Bvh->RefitLeaf(m_Registry, *entPtr);
-                // Visualisation BVs are now stale; simplest is to mark dirty for rebuild of renderables only
-                m_BvhDirty = true;
-            }
-            else
-            {
-                m_BvhDirty = true;
-            }
-        }
-        else
-        {
-            m_BvhDirty = true;
-        }
-    });
-
     // Rebuild BVH when the entire scene is reset
     EventSystem::Get().SubscribeToEvent(EventType::SceneReset, [this](const EventData&) 
         {
@@ -74,6 +54,34 @@ RenderSystem::RenderSystem(Registry& registry, Window& window, const std::shared
     });
 }
 
+RenderSystem::~RenderSystem()
+{
+    m_Registry.UnregisterChangeConsumer(m_BvhChanges);
+}
+
+void RenderSystem::ConsumeBvhChanges()
+{
+    const Registry::ChangeSet& changes = m_Registry.ConsumeChanges(m_BvhChanges);
+    if (!changes.m_Removed.empty())
+    {
+        m_BvhDirty = true;
+    }
+
+    for (Registry::Entity entity : changes.m_Changed)
+    {
+        // Only entities with bounds are in the hierarchy; the light marker moves every frame
+        if (!m_Registry.HasComponent<BoundingComponent>(entity))
+            continue;
+
+        if (m_Bvh)
+        {
+            m_Bvh->RefitLeaf(m_Registry, entity);
+        }
+        // Visualisation BVs are now stale; simplest is to mark dirty for rebuild of renderables only
+        m_BvhDirty = true;
+    }
+}
+
 void RenderSystem::Initialize()
 {
     glViewport(0, 0, m_Window.GetWidth(), m_Window.GetHeight());
@@ -113,12 +121,14 @@ void RenderSystem::Render()
             auto& t = m_Registry.GetComponent<TransformComponent>(m_LightVisualizationEntity);
             t.m_Position = lightPos;
             t.UpdateModelMatrix();
+            m_Registry.MarkChanged<TransformComponent>(m_LightVisualizationEntity);
         }
 
         UpdateLighting();
     }
 
     // Rebuild BVH automatically if marked dirty (e.g., transforms changed)
+    ConsumeBvhChanges();
     if (m_BvhDirty)
     {
         BuildBVH(BvhBuildConfig::s_Method,
@@ -146,6 +156,13 @@ void RenderSystem::Render()
     if (m_CameraSystem) 
     {
         m_CameraSystem->UpdateFrustumPlanes(camera, aspectRatio);
+
+        if (m_MeasureBvhQueries && m_Bvh)
+        {
+            m_BvhQueryResults.clear();
+            m_Bvh->QueryFrustum(m_Registry, m_CameraSystem->GetFrustumNormals(),
+                                m_CameraSystem->GetFrustumDistances(), m_BvhQueryResults);
+        }
     }
     
     static GLenum s_CurrentPolyMode = GL_FILL;
@@ -561,6 +578,7 @@ void RenderSystem::BuildBVH(BvhBuildMethod method,
     if (entities.empty()) return;
 
     m_Bvh = std::make_unique<Bvh>();
+    m_Bvh->SetQueryStatsEnabled(m_MeasureBvhQueries);
 
     if (method == BvhBuildMethod::TopDown)
     {
@@ -579,4 +597,20 @@ void RenderSystem::BuildBVH(BvhBuildMethod method,
 
     // BVH up-to-date
     m_BvhDirty = false;
-} 
\ No newline at end of file
+}
+
+void RenderSystem::SetMeasureBvhQueries(bool enable)
+{
+    m_MeasureBvhQueries = enable;
+    if (m_Bvh) m_Bvh->SetQueryStatsEnabled(enable);
+}
+
+void RenderSystem::ResetBvhQueryStats()
+{
+    if (m_Bvh) m_Bvh->ResetQueryStats();
+}
+
+SpatialTreeStats RenderSystem::GetBvhStats() const
+{
+    return m_Bvh ? m_Bvh->GetStats() : SpatialTreeStats();
+}
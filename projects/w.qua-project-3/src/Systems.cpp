@@ -28,7 +28,10 @@ namespace Systems
 
     void InitializeSystems(Registry& registry, Window& window, const std::shared_ptr<Shader>& shader) 
     {
-        EventSystem::Get().Initialize();        
+        EventSystem::Get().Initialize();
+        // Spatial structures consume exact per-entity changes of these components
+        registry.TrackChanges<TransformComponent>();
+        registry.TrackChanges<BoundingComponent>();        
         g_InputSystem = std::make_unique<InputSystem>(registry, window);
         g_CameraSystem = std::make_unique<CameraSystem>(registry, window);
         g_RenderSystem = std::make_unique<RenderSystem>(registry, window, shader);
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include "Registry.hpp"
+#include "Components.hpp"
+
+// An entity slot destroyed, recycled and destroyed again before a drain is reported once
+TEST(RegistryTest, RecycledEntityDestroyedTwiceBeforeDrain)
+{
+    Registry registry;
+    registry.TrackChanges<TransformComponent>();
+    Registry::ChangeConsumerId consumer = registry.RegisterChangeConsumer();
+
+    Registry::Entity first = registry.Create();
+    registry.AddComponent<TransformComponent>(first);
+    registry.ConsumeChanges(consumer);
+    registry.Destroy(first);
+
+    Registry::Entity recycled = registry.Create();
+    ASSERT_EQ(entt::to_entity(recycled), entt::to_entity(first));
+    ASSERT_NE(recycled, first);
+    registry.AddComponent<TransformComponent>(recycled);
+    registry.Destroy(recycled);
+
+    const Registry::ChangeSet& changes = registry.ConsumeChanges(consumer);
+    EXPECT_TRUE(changes.m_Changed.empty());
+    ASSERT_EQ(changes.m_Removed.size(), 1u);
+    EXPECT_EQ(changes.m_Removed[0], first);
+
+    // The slot is free again for the next cycle
+    Registry::Entity third = registry.Create();
+    registry.AddComponent<TransformComponent>(third);
+    registry.Destroy(third);
+    ASSERT_EQ(registry.ConsumeChanges(consumer).m_Removed.size(), 1u);
+}
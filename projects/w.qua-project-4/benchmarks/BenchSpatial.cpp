@@ -0,0 +1,379 @@
+/**
+ * @file BenchSpatial.cpp
+ * @brief Benchmarks for the spatial structures, frustum classification and ray picking.
+ *
+ * Tree frustum query benchmarks also report nodes visited, primitives tested and
+ * tree shape as counters, from the trees' opt-in query statistics.
+ *
+ * Every benchmark is parameterised over the object count and the SceneGenerator
+ * distribution; the tree builders additionally sweep their subdivision limits.
+ * Run through the run_w.qua-project-4_benchmarks target to get JSON output
+ * (benchmark_results/w.qua-project-4.json) that can be diffed between commits.
+ */
+
+#include <benchmark/benchmark.h>
+#include "Registry.hpp"
+#include "Components.hpp"
+#include "Geometry.hpp"
+#include "Octree.hpp"
+#include "KDTree.hpp"
+#include "SpatialSnapshot.hpp"
+#include "PickingSystem.hpp"
+#include "EventSystem.hpp"
+#include "Window.hpp"
+#include "SceneGenerator.hpp"
+#include "JobSystem.hpp"
+
+namespace
+{
+    const int64_t kDefaultMaxObjects = 10;
+    const int64_t kDefaultMaxDepth   = 8;
+    const int64_t kDistributionCount = static_cast<int64_t>(SceneDistribution::Count);
+
+    /**
+     * @brief Fills a registry with a synthetic scene.
+     * @param registry Registry to populate
+     * @param count Number of entities to create
+     * @param distribution SceneDistribution index
+     */
+    void PopulateScene(Registry& registry, int64_t count, int64_t distribution)
+    {
+        SceneGeneratorConfig config;
+        config.m_ObjectCount  = static_cast<size_t>(count);
+        config.m_Distribution = static_cast<SceneDistribution>(distribution);
+        SceneGenerator::Generate(registry, config);
+    }
+
+    /**
+     * @brief Collects world-space AABBs of every bounded entity.
+     * @param registry Registry to read
+     * @param outMin Receives the box minima
+     * @param outMax Receives the box maxima
+     */
+    void CollectWorldAabbs(Registry& registry, std::vector<Vertex>& outMin, std::vector<Vertex>& outMax)
+    {
+        auto view = registry.View<TransformComponent, BoundingComponent>();
+        for (auto entity : view)
+        {
+            Aabb worldAabb = view.get<BoundingComponent>(entity).GetAABB();
+            worldAabb.Transform(view.get<TransformComponent>(entity).m_Model);
+
+            Vertex boxMin{}, boxMax{};
+            boxMin.m_Position = worldAabb.min;
+            boxMax.m_Position = worldAabb.max;
+            outMin.push_back(boxMin);
+            outMax.push_back(boxMax);
+        }
+    }
+
+    /**
+     * @brief Builds the frustum of a camera outside the scene looking at its centre.
+     * @param halfSize Half size of the scene cube
+     * @param fn Output frustum plane normals
+     * @param fd Output frustum plane distances
+     */
+    void SceneFrustum(float halfSize, glm::vec3 fn[6], float fd[6])
+    {
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, halfSize * 2.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 proj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, halfSize * 4.0f);
+        FrustumFromVp(proj * view, fn, fd);
+    }
+
+    // Object counts 1k-1M for every distribution, default tree limits
+    void ScalingArgs(benchmark::internal::Benchmark* bench)
+    {
+        bench->ArgNames({ "objects", "distribution", "maxObjects", "maxDepth" });
+        for (int64_t count : { 1000, 10000, 100000, 1000000 })
+            for (int64_t distribution = 0; distribution < kDistributionCount; ++distribution)
+                bench->Args({ count, distribution, kDefaultMaxObjects, kDefaultMaxDepth });
+    }
+
+    // Subdivision limit sweep at a fixed 100k objects
+    void SettingsArgs(benchmark::internal::Benchmark* bench)
+    {
+        bench->ArgNames({ "objects", "distribution", "maxObjects", "maxDepth" });
+        for (int64_t distribution = 0; distribution < kDistributionCount; ++distribution)
+            for (int64_t maxObjects : { 4, 16, 64 })
+                for (int64_t maxDepth : { 6, 8, 12 })
+                    bench->Args({ 100000, distribution, maxObjects, maxDepth });
+    }
+
+    // Job system worker counts at 1M objects, for build scaling across cores
+    void WorkerArgs(benchmark::internal::Benchmark* bench)
+    {
+        bench->ArgNames({ "objects", "distribution", "workers" });
+        for (int64_t distribution = 0; distribution < kDistributionCount; ++distribution)
+            for (int64_t workers : { 0, 1, 3, 7, 15 })
+                bench->Args({ 1000000, distribution, workers });
+    }
+
+    // Object counts and distributions only, for the query benchmarks
+    void QueryArgs(benchmark::internal::Benchmark* bench)
+    {
+        bench->ArgNames({ "objects", "distribution" });
+        for (int64_t count : { 1000, 10000, 100000, 1000000 })
+            for (int64_t distribution = 0; distribution < kDistributionCount; ++distribution)
+                bench->Args({ count, distribution });
+    }
+}
+
+static void BM_OctreeBuild(benchmark::State& state)
+{
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+    Octree octree(registry, static_cast<int>(state.range(2)), StraddlingMethod::UseCenter, static_cast<int>(state.range(3)));
+
+    for (auto _ : state)
+    {
+        octree.MarkDirty();
+        octree.Build();
+        benchmark::DoNotOptimize(octree.GetRoot());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OctreeBuild)->Apply(ScalingArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OctreeBuild)->Name("BM_OctreeBuildSettings")->Apply(SettingsArgs)->Unit(benchmark::kMillisecond);
+
+// Other benchmarks leave the job system uninitialized, i.e. single-threaded
+static void BM_OctreeBuildParallel(benchmark::State& state)
+{
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+    Octree octree(registry, static_cast<int>(kDefaultMaxObjects), StraddlingMethod::UseCenter, static_cast<int>(kDefaultMaxDepth));
+    JobSystem::Get().Initialize(static_cast<size_t>(state.range(2)));
+
+    for (auto _ : state)
+    {
+        octree.MarkDirty();
+        octree.Build();
+        benchmark::DoNotOptimize(octree.GetRoot());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    JobSystem::Get().Shutdown();
+}
+BENCHMARK(BM_OctreeBuildParallel)->Apply(WorkerArgs)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_KDTreeBuild(benchmark::State& state)
+{
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+    KDTree tree(registry, static_cast<int>(state.range(2)), KdSplitMethod::MedianCenter, static_cast<int>(state.range(3)));
+
+    for (auto _ : state)
+    {
+        tree.MarkDirty();
+        tree.Build();
+        benchmark::DoNotOptimize(tree.GetRoot());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_KDTreeBuild)->Apply(ScalingArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_KDTreeBuild)->Name("BM_KDTreeBuildSettings")->Apply(SettingsArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_KDTreeBuildParallel(benchmark::State& state)
+{
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+    KDTree tree(registry, static_cast<int>(kDefaultMaxObjects), KdSplitMethod::MedianCenter, static_cast<int>(kDefaultMaxDepth));
+    JobSystem::Get().Initialize(static_cast<size_t>(state.range(2)));
+
+    for (auto _ : state)
+    {
+        tree.MarkDirty();
+        tree.Build();
+        benchmark::DoNotOptimize(tree.GetRoot());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    JobSystem::Get().Shutdown();
+}
+BENCHMARK(BM_KDTreeBuildParallel)->Apply(WorkerArgs)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_FrustumClassifyAabb(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+
+    std::vector<Vertex> mins, maxs;
+    CollectWorldAabbs(registry, mins, maxs);
+
+    glm::vec3 fn[6];
+    float fd[6];
+    SceneFrustum(SceneGenerator::DefaultHalfSize(count), fn, fd);
+
+    for (auto _ : state)
+    {
+        size_t visible = 0;
+        for (size_t i = 0; i < mins.size(); ++i)
+        {
+            if (ClassifyFrustumAabbNaive(fn, fd, mins[i], maxs[i]) != SideResult::eOUTSIDE)
+                ++visible;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FrustumClassifyAabb)->Apply(QueryArgs)->Unit(benchmark::kMicrosecond);
+
+// Same test as BM_FrustumClassifyAabb over the structure-of-arrays snapshot, on the calling thread
+static void BM_FrustumClassifySnapshot(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+
+    SpatialSnapshot snapshot;
+    snapshot.Build(registry, false);
+
+    glm::vec3 fn[6];
+    float fd[6];
+    SceneFrustum(SceneGenerator::DefaultHalfSize(count), fn, fd);
+
+    std::vector<SideResult> results;
+    for (auto _ : state)
+    {
+        snapshot.ClassifyFrustum(fn, fd, results, false);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FrustumClassifySnapshot)->Apply(QueryArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_SpatialSnapshotBuild(benchmark::State& state)
+{
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+
+    SpatialSnapshot snapshot;
+    for (auto _ : state)
+    {
+        snapshot.Build(registry, false);
+        benchmark::DoNotOptimize(snapshot.GetMin(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialSnapshotBuild)->Apply(QueryArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_FrustumClassifySphere(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+
+    std::vector<Vertex> mins, maxs;
+    CollectWorldAabbs(registry, mins, maxs);
+
+    // Bounding spheres of the world boxes
+    std::vector<Vertex> centres(mins.size());
+    std::vector<float>  radii(mins.size());
+    for (size_t i = 0; i < mins.size(); ++i)
+    {
+        centres[i].m_Position = (mins[i].m_Position + maxs[i].m_Position) * 0.5f;
+        radii[i] = glm::length(maxs[i].m_Position - mins[i].m_Position) * 0.5f;
+    }
+
+    glm::vec3 fn[6];
+    float fd[6];
+    SceneFrustum(SceneGenerator::DefaultHalfSize(count), fn, fd);
+
+    for (auto _ : state)
+    {
+        size_t visible = 0;
+        for (size_t i = 0; i < centres.size(); ++i)
+        {
+            if (ClassifyFrustumSphereNaive(fn, fd, centres[i], radii[i]) != SideResult::eOUTSIDE)
+                ++visible;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FrustumClassifySphere)->Apply(QueryArgs)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Times uninstrumented frustum queries on a built tree, then reports the
+ *        per-query work and tree shape from one instrumented query as counters.
+ */
+template <typename Tree>
+static void RunTreeFrustumQuery(benchmark::State& state, Tree& tree)
+{
+    glm::vec3 fn[6];
+    float fd[6];
+    SceneFrustum(SceneGenerator::DefaultHalfSize(static_cast<size_t>(state.range(0))), fn, fd);
+
+    tree.Build();
+    std::vector<Registry::Entity> visible;
+    for (auto _ : state)
+    {
+        visible.clear();
+        tree.QueryFrustum(fn, fd, visible);
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    tree.SetQueryStatsEnabled(true);
+    visible.clear();
+    tree.QueryFrustum(fn, fd, visible);
+    SpatialTreeStats stats = tree.GetStats();
+    state.counters["nodesVisited"]     = static_cast<double>(stats.m_Queries.m_NodesVisited);
+    state.counters["primitivesTested"] = static_cast<double>(stats.m_Queries.m_PrimitivesTested);
+    state.counters["results"]          = static_cast<double>(stats.m_Queries.m_Results);
+    state.counters["nodes"]            = static_cast<double>(stats.m_NodeCount);
+    state.counters["emptyLeafRatio"]   = stats.GetEmptyLeafRatio();
+}
+
+static void BM_OctreeQueryFrustum(benchmark::State& state)
+{
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+    Octree octree(registry, static_cast<int>(kDefaultMaxObjects), StraddlingMethod::UseCenter, static_cast<int>(kDefaultMaxDepth));
+    RunTreeFrustumQuery(state, octree);
+}
+BENCHMARK(BM_OctreeQueryFrustum)->Apply(QueryArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_KDTreeQueryFrustum(benchmark::State& state)
+{
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+    KDTree tree(registry, static_cast<int>(kDefaultMaxObjects), KdSplitMethod::MedianCenter, static_cast<int>(kDefaultMaxDepth));
+    RunTreeFrustumQuery(state, tree);
+}
+BENCHMARK(BM_KDTreeQueryFrustum)->Apply(QueryArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_RayPick(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const float halfSize = SceneGenerator::DefaultHalfSize(count);
+
+    // Headless window: picking only needs the viewport size
+    Window window(1280, 720, "Benchmark", true);
+    EventSystem::Get().Initialize();
+
+    Registry registry;
+    PopulateScene(registry, state.range(0), state.range(1));
+
+    auto cameraEntity = registry.Create();
+    CameraComponent camera;
+    camera.m_Projection = Projection(45.0f, 0.1f, halfSize * 4.0f);
+    camera.m_FPS = FPSCamera(glm::vec3(0.0f, 0.0f, halfSize * 2.0f));
+    registry.AddComponent<CameraComponent>(cameraEntity, camera);
+
+    PickingSystem picking(registry, window);
+
+    // Rays through a fixed grid of screen positions
+    std::vector<glm::vec2> screenPositions;
+    for (int y = 1; y < 4; ++y)
+        for (int x = 1; x < 4; ++x)
+            screenPositions.emplace_back(window.GetWidth() * x / 4.0f, window.GetHeight() * y / 4.0f);
+
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(picking.Pick(screenPositions[next]));
+        next = (next + 1) % screenPositions.size();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    EventSystem::Get().Shutdown();
+}
+BENCHMARK(BM_RayPick)->Apply(QueryArgs)->Unit(benchmark::kMicrosecond);
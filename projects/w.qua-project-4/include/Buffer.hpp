@@ -18,6 +18,17 @@ struct Vertex
     glm::vec2 m_UV;       ///< (u, v) texture coordinates
 };
 
+/**
+ * @brief Per-instance data shared by the instanced and indirect draw paths.
+ *        Layout matches std430 so it can also back a shader storage buffer.
+ */
+struct InstanceData
+{
+    glm::mat4   m_Transform;    ///< Instance model transformation matrix
+    glm::mat3x4 m_NormalMatrix; ///< Normal matrix, columns padded to vec4 (mat3x4 in GLSL)
+    glm::vec4   m_Color;        ///< RGB colour, alpha unused
+};
+
 
 class Buffer 
 {
@@ -56,11 +67,31 @@ public:
      */
     size_t GetVertexCount() const;
     
+    /**
+     * @brief Gets the vertex array object ID.
+     * @return VAO ID, 0 before Setup
+     */
+    GLuint GetVertexArray() const;
+    
     /**
      * @brief Updates the vertex data in the buffer.
      * @param vertices New vertex data to upload
      */
     void UpdateVertices(const std::vector<Vertex>& vertices);
+    
+    // Instance buffer methods
+    /**
+     * @brief Uploads per-instance data and attaches it to the vertex array
+     *        (transform at locations 4-7, normal matrix at 8-10, colour at 11, one step per instance).
+     * @param instances Instance data to upload
+     */
+    void SetupInstances(const std::vector<InstanceData>& instances);
+    
+    /**
+     * @brief Gets the number of instances in the instance buffer.
+     * @return Number of uploaded instances
+     */
+    size_t GetInstanceCount() const;
 
     // Static methods 
     /**
@@ -97,6 +128,9 @@ private:
     GLuint m_vao;         ///< Vertex Array Object ID
     GLuint m_vbo;         ///< Vertex Buffer Object ID
     size_t m_vertexCount; ///< Number of vertices in the buffer
+    GLuint m_instanceVbo = 0;      ///< Per-instance data buffer (0 until SetupInstances)
+    size_t m_instanceCount = 0;    ///< Number of instances in the instance buffer
+    size_t m_instanceCapacity = 0; ///< Instance buffer size, in instances
     std::unordered_map<GLuint, GLuint> m_uniformBuffers; ///< Map of UBO IDs to binding points
 
     /**
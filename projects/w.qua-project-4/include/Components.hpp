@@ -27,6 +27,7 @@ struct TransformComponent
     glm::vec3 m_Rotation;
     glm::vec3 m_Scale;
     glm::mat4 m_Model;
+    glm::mat3 m_NormalMatrix;  // Inverse transpose of the model's 3x3, refreshed with m_Model
     
     /**
      * @brief Constructs a transform component with position, rotation, and scale.
@@ -38,13 +39,13 @@ struct TransformComponent
         const glm::vec3& pos = glm::vec3(0.0f),
         const glm::vec3& rot = glm::vec3(0.0f),
         const glm::vec3& scl = glm::vec3(1.0f))
-        : m_Position(pos), m_Rotation(rot), m_Scale(scl), m_Model(1.0f)
+        : m_Position(pos), m_Rotation(rot), m_Scale(scl), m_Model(1.0f), m_NormalMatrix(1.0f)
     {
         UpdateModelMatrix();
     }
     
     /**
-     * @brief Updates the model matrix from position, rotation, and scale.
+     * @brief Updates the model and normal matrices from position, rotation, and scale.
      */
     void UpdateModelMatrix();
 };
@@ -88,84 +89,48 @@ enum class BoundingVolumeType
     BSphere_PCA         
 };
 
+/**
+ * @brief World-independent bounding volumes of an entity, read every frame by culling,
+ *        LOD selection and the spatial snapshot.
+ *
+ * Only the volumes live here, packed without padding, so loops over many entities
+ * stream nothing else through the cache. They are resolved from the mesh resource
+ * once, on construction; the mesh handle stays with the entity's renderable.
+ */
 struct BoundingComponent
 {
-    // Bounding volume data
-    Aabb m_AABB;
+    Aabb   m_AABB;
     Sphere m_PCASphere;
-    // OBB data
-    Obb m_OBB;
-
-    // Wireframe renderables for visualization
-    std::shared_ptr<IRenderable> m_AABBRenderable;
-    std::shared_ptr<IRenderable> m_PCARenderable;
-    std::shared_ptr<IRenderable> m_OBBRenderable;
-    
-    // Lazy computation flags
-    bool m_AABBComputed = false;
-    bool m_PCAComputed = false;
-    bool m_OBBComputed = false;
-    
-    // Store mesh handle for lazy computation
-    ResourceHandle m_MeshHandle = INVALID_RESOURCE_HANDLE;
+    Obb    m_OBB;
 
     BoundingComponent() = default;
-    
-    /**
-     * @brief Constructs a bounding component from a mesh resource with lazy computation.
-     * @param resourceHandle Handle to the mesh resource for bounding volume calculation
-     */
-    BoundingComponent(const ResourceHandle& resourceHandle)
-        : m_MeshHandle(resourceHandle)
-    {
-        // Only compute AABB immediately (it's fast and often needed)
-        ComputeAABB();
-    }
-    
-    /**
-     * @brief Gets the AABB, computing it if necessary.
-     */
-    const Aabb& GetAABB() 
-    {
-        if (!m_AABBComputed) ComputeAABB();
-        return m_AABB;
-    }
-    
+
     /**
-     * @brief Gets the PCA sphere, computing it if necessary.
+     * @brief Constructs a bounding component from a mesh resource's precomputed volumes.
+     * @param resourceHandle Handle to the mesh resource; an invalid handle leaves the volumes empty
      */
-    const Sphere& GetPCASphere() 
-    {
-        if (!m_PCAComputed) ComputePCASphere();
-        return m_PCASphere;
-    }
-    
+    BoundingComponent(const ResourceHandle& resourceHandle);
+
     /**
-     * @brief Gets the OBB, computing it if necessary.
+     * @brief Gets the local-space AABB.
      */
-    const Obb& GetOBB() 
-    {
-        if (!m_OBBComputed) ComputeOBB();
-        return m_OBB;
-    }
-    
+    const Aabb& GetAABB() const { return m_AABB; }
+
     /**
-     * @brief Initializes renderable objects for visualizing bounding volumes.
-     * @param shader Shader to use for rendering the bounding volumes
+     * @brief Gets the local-space PCA sphere.
      */
-    void InitializeRenderables(const std::shared_ptr<Shader>& shader);
-    
+    const Sphere& GetPCASphere() const { return m_PCASphere; }
+
     /**
-     * @brief Cleans up all renderable objects for bounding volume visualization.
+     * @brief Gets the local-space OBB.
      */
-    void CleanupRenderables();
-
-private:
-    void ComputeAABB();
-    void ComputePCASphere();
-    void ComputeOBB();
+    const Obb& GetOBB() const { return m_OBB; }
 };
 
+// Anything added beyond the volumes is cold data and belongs in a component of its own
+static_assert(sizeof(BoundingComponent) == sizeof(Aabb) + sizeof(Sphere) + sizeof(Obb),
+              "BoundingComponent must hold only its packed volumes");
+
 // ==================== Camera Components ====================
 
 struct CameraComponent 
@@ -65,14 +65,11 @@ public:
     void Initialize(const std::shared_ptr<Shader>& shader) override;
     
     /**
-     * @brief Renders the cube with the given transformation matrices.
+     * @brief Renders the cube with the given model and normal matrices.
      * @param modelMatrix Model transformation matrix
-     * @param viewMatrix View transformation matrix
-     * @param projectionMatrix Projection transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
      */
-    void Render(const glm::mat4& modelMatrix, 
-               const glm::mat4& viewMatrix, 
-               const glm::mat4& projectionMatrix) override;
+    void Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix) override;
     
     /**
      * @brief Cleans up OpenGL resources.
@@ -127,7 +124,7 @@ public:
      * @brief Checks if the cube is rendered in wireframe mode.
      * @return True if wireframe, false if solid
      */
-    bool IsWireframe() const;
+    bool IsWireframe() const override;
     
     // Orientation control
     /**
@@ -142,6 +139,12 @@ public:
      */
     void SetHalfExtents(const glm::vec3& halfExtents);
     
+    /**
+     * @brief Creates vertex data for cube rendering from the current parameters.
+     * @return Vector of vertex data
+     */
+    std::vector<Vertex> CreateVertices();
+    
 private:
     glm::vec3 m_Center;
     glm::vec3 m_Size;
@@ -155,10 +158,4 @@ private:
         glm::vec3(0.0f, 0.0f, 1.0f)
     };
     glm::vec3 m_HalfExtents = glm::vec3(0.5f);
-
-    /**
-     * @brief Creates vertex data for cube rendering.
-     * @return Vector of vertex data
-     */
-    std::vector<Vertex> CreateVertices();
 }; 
\ No newline at end of file
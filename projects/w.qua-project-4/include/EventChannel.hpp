@@ -0,0 +1,299 @@
+/**
+ * @file EventChannel.hpp
+ * @brief Strongly-typed event channels used by EventSystem::Publish / Subscribe.
+ *
+ * Each event struct gets one EventChannel holding its subscribers contiguously as
+ * EventDelegates, small-buffer callables that never allocate. Publishing an event
+ * therefore neither builds a variant nor touches the heap. Channels also own the
+ * queue used when their event type is switched to queued dispatch.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+// When subscribers of an event type are invoked
+enum class EventDispatchMode : uint8_t
+{
+    Immediate, // Inside FireEvent / Publish
+    Queued     // At the next FlushEvents
+};
+
+// How queued events of one type are merged before the flush
+enum class EventCoalescing : uint8_t
+{
+    None,            // Every event is delivered
+    LatestPerEntity, // Entity events keep only the latest per entity, at its first position
+    LatestOnly       // Only the latest event is delivered
+};
+
+/**
+ * @brief Queue activity between two flushes.
+ */
+struct EventQueueStats
+{
+    size_t m_Queued     = 0; ///< Events fired into queues
+    size_t m_Coalesced  = 0; ///< Events merged into an already queued one
+    size_t m_Dispatched = 0; ///< Events delivered by the flush
+};
+
+/**
+ * @class EventDelegate
+ * @brief Type-erased callable stored inline, invoked with a const Event&.
+ *
+ * Callables must fit kInlineSize bytes, which holds a lambda capturing a few
+ * pointers or references; larger state should be captured by pointer.
+ */
+template<typename Event>
+class EventDelegate
+{
+public:
+    static constexpr size_t kInlineSize = 4 * sizeof(void*);
+
+    EventDelegate() = default;
+
+    template<typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, EventDelegate>>>
+    EventDelegate(Callable&& callable)
+    {
+        using Stored = std::decay_t<Callable>;
+        static_assert(sizeof(Stored) <= kInlineSize, "Event callback too large for inline storage; capture a pointer instead");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t), "Event callback over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Stored>, "Event callback must be nothrow movable");
+
+        new (m_Storage) Stored(std::forward<Callable>(callable));
+        m_Invoke = [](void* storage, const Event& event) { (*static_cast<Stored*>(storage))(event); };
+        if constexpr (!std::is_trivially_copyable_v<Stored> || !std::is_trivially_destructible_v<Stored>)
+        {
+            // Moves into destination (if any), then destroys the source
+            m_Relocate = [](void* destination, void* source) {
+                if (destination)
+                    new (destination) Stored(std::move(*static_cast<Stored*>(source)));
+                static_cast<Stored*>(source)->~Stored();
+            };
+        }
+    }
+
+    EventDelegate(EventDelegate&& other) noexcept { MoveFrom(other); }
+
+    EventDelegate& operator=(EventDelegate&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    ~EventDelegate() { Reset(); }
+
+    EventDelegate(const EventDelegate&) = delete;
+    EventDelegate& operator=(const EventDelegate&) = delete;
+
+    void operator()(const Event& event) const { m_Invoke(m_Storage, event); }
+
+    explicit operator bool() const { return m_Invoke != nullptr; }
+
+private:
+    void MoveFrom(EventDelegate& other)
+    {
+        if (other.m_Relocate)
+            other.m_Relocate(m_Storage, other.m_Storage);
+        else
+            std::memcpy(m_Storage, other.m_Storage, kInlineSize);
+        m_Invoke   = other.m_Invoke;
+        m_Relocate = other.m_Relocate;
+        other.m_Invoke   = nullptr;
+        other.m_Relocate = nullptr;
+    }
+
+    void Reset()
+    {
+        if (m_Relocate)
+            m_Relocate(nullptr, m_Storage);
+        m_Invoke   = nullptr;
+        m_Relocate = nullptr;
+    }
+
+    alignas(std::max_align_t) mutable unsigned char m_Storage[kInlineSize];
+    void (*m_Invoke)(void*, const Event&) = nullptr;
+    void (*m_Relocate)(void*, void*)      = nullptr;
+};
+
+/**
+ * @brief Type-independent channel interface so EventSystem can flush and clear all channels.
+ */
+class IEventChannel
+{
+public:
+    virtual ~IEventChannel() = default;
+
+    virtual void   Flush(EventQueueStats& stats) = 0;
+    virtual void   ClearSubscribers() = 0;
+    virtual size_t GetSubscriberCount() const = 0;
+    virtual size_t GetQueuedCount() const = 0;
+    virtual void   SetDispatchMode(EventDispatchMode mode, EventCoalescing coalescing) = 0;
+    virtual EventDispatchMode GetDispatchMode() const = 0;
+};
+
+/**
+ * @class EventChannel
+ * @brief Subscribers and pending queue of one event type.
+ */
+template<typename Event>
+class EventChannel : public IEventChannel
+{
+public:
+    /**
+     * @brief Adds a subscriber. From inside a callback of this channel the subscriber is
+     *        added once the dispatch ends, so it first receives the next event.
+     * @param callback Callable taking const Event&
+     */
+    template<typename Callable>
+    void Subscribe(Callable&& callback)
+    {
+        // Growing m_Subscribers now would move the delegate that is still running
+        if (m_DispatchDepth > 0)
+            m_AddedSubscribers.emplace_back(std::forward<Callable>(callback));
+        else
+            m_Subscribers.emplace_back(std::forward<Callable>(callback));
+    }
+
+    /**
+     * @brief Delivers an event now, or queues it if the channel is in queued mode.
+     * @param event Event to publish
+     * @param stats Queue counters updated when the event is queued
+     */
+    void Publish(const Event& event, EventQueueStats& stats)
+    {
+        if (m_Mode == EventDispatchMode::Queued)
+            Queue(event, stats);
+        else
+            Dispatch(event);
+    }
+
+    /**
+     * @brief Appends an event to the pending queue, merging it per the coalescing policy.
+     * @param event Event to queue
+     * @param stats Queue counters to update
+     */
+    void Queue(const Event& event, EventQueueStats& stats)
+    {
+        ++stats.m_Queued;
+
+        if (m_Coalescing == EventCoalescing::LatestOnly && !m_Pending.empty())
+        {
+            m_Pending.back() = event;
+            ++stats.m_Coalesced;
+            return;
+        }
+
+        if constexpr (kHasEntity)
+        {
+            if (m_Coalescing == EventCoalescing::LatestPerEntity && event.m_Entity != entt::null)
+            {
+                // Slot table indexed by entity id holds pending index + 1, 0 when none
+                size_t id = static_cast<size_t>(entt::to_entity(event.m_Entity));
+                if (id >= m_EntitySlots.size())
+                    m_EntitySlots.resize(id + 1, 0);
+
+                uint32_t& slot = m_EntitySlots[id];
+                if (slot != 0 && slot <= m_Pending.size() && m_Pending[slot - 1].m_Entity == event.m_Entity)
+                {
+                    m_Pending[slot - 1] = event;
+                    ++stats.m_Coalesced;
+                    return;
+                }
+                slot = static_cast<uint32_t>(m_Pending.size() + 1);
+            }
+        }
+
+        m_Pending.push_back(event);
+    }
+
+    /**
+     * @brief Invokes every subscriber with an event.
+     * @param event Event to deliver
+     */
+    void Dispatch(const Event& event)
+    {
+        // Callbacks may publish this event again, so only the outermost dispatch merges
+        ++m_DispatchDepth;
+        for (const EventDelegate<Event>& subscriber : m_Subscribers)
+        {
+            subscriber(event);
+        }
+        --m_DispatchDepth;
+
+        if (m_DispatchDepth == 0 && !m_AddedSubscribers.empty())
+        {
+            for (EventDelegate<Event>& subscriber : m_AddedSubscribers)
+            {
+                m_Subscribers.push_back(std::move(subscriber));
+            }
+            m_AddedSubscribers.clear();
+        }
+    }
+
+    void Flush(EventQueueStats& stats) override
+    {
+        if (m_Pending.empty())
+            return;
+
+        // Subscribers may publish more events of this type; those land in the fresh
+        // pending list and wait for the next flush instead of looping here
+        m_Dispatching.swap(m_Pending);
+        if constexpr (kHasEntity)
+        {
+            for (const Event& event : m_Dispatching)
+            {
+                if (event.m_Entity != entt::null)
+                    m_EntitySlots[static_cast<size_t>(entt::to_entity(event.m_Entity))] = 0;
+            }
+        }
+
+        for (const Event& event : m_Dispatching)
+        {
+            Dispatch(event);
+        }
+        stats.m_Dispatched += m_Dispatching.size();
+        m_Dispatching.clear();
+    }
+
+    void ClearSubscribers() override
+    {
+        assert(m_DispatchDepth == 0 && "Subscribers cleared from inside their own dispatch");
+        m_Subscribers.clear();
+        m_AddedSubscribers.clear();
+    }
+
+    size_t GetSubscriberCount() const override { return m_Subscribers.size() + m_AddedSubscribers.size(); }
+    size_t GetQueuedCount() const override     { return m_Pending.size(); }
+
+    void SetDispatchMode(EventDispatchMode mode, EventCoalescing coalescing) override
+    {
+        m_Mode       = mode;
+        m_Coalescing = coalescing;
+    }
+
+    EventDispatchMode GetDispatchMode() const override { return m_Mode; }
+
+private:
+    // Per-entity coalescing needs the event to name its entity
+    static constexpr bool kHasEntity = requires(const Event& event) { { event.m_Entity } -> std::convertible_to<entt::entity>; };
+
+    std::vector<EventDelegate<Event>> m_Subscribers;
+    std::vector<EventDelegate<Event>> m_AddedSubscribers; // Subscribed during a dispatch, merged after it
+    uint32_t                          m_DispatchDepth = 0;  // Nested dispatches of this channel in progress
+    std::vector<Event>                m_Pending;      // Capacity kept between frames
+    std::vector<Event>                m_Dispatching;  // Swapped with m_Pending during a flush
+    std::vector<uint32_t>             m_EntitySlots;  // Pending index + 1 per entity id (LatestPerEntity)
+    EventDispatchMode                 m_Mode       = EventDispatchMode::Immediate;
+    EventCoalescing                   m_Coalescing = EventCoalescing::None;
+};
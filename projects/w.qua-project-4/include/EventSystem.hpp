@@ -4,10 +4,22 @@
  *
  * This system handles event subscription, unsubscription and dispatching events 
  * to registered listeners across the application.
+ *
+ * Events are typed structs published through per-type channels
+ * (Publish<TransformChangedEvent>, Subscribe<TransformChangedEvent>) without
+ * building a variant or allocating. The EventType / EventData API is a thin
+ * adapter over the same channels for code that still uses it.
+ *
+ * Event types are dispatched immediately by default. A type switched to queued
+ * dispatch is buffered when fired, optionally coalesced (e.g. one TransformChanged
+ * per entity), and delivered by FlushEvents at a fixed point in the frame, so
+ * high-frequency sources such as mouse drags cause one reaction per frame.
  */
 
 #pragma once
 #include "pch.h"
+#include "EventChannel.hpp"
+#include <deque>
 
 // Forward declarations
 class Registry;
@@ -50,6 +62,16 @@ using EventData = std::variant<
 
 using EventFunction = std::function<void(const EventData&)>;
 
+// Typed events; kType links each to its EventType for the EventData adapter
+struct KeyPressEvent           { static constexpr EventType kType = EventType::KeyPress;           int m_Key; };
+struct KeyReleaseEvent         { static constexpr EventType kType = EventType::KeyRelease;         int m_Key; };
+struct MouseButtonPressEvent   { static constexpr EventType kType = EventType::MouseButtonPress;   int m_Button; };
+struct MouseButtonReleaseEvent { static constexpr EventType kType = EventType::MouseButtonRelease; int m_Button; };
+struct MouseMoveEvent          { static constexpr EventType kType = EventType::MouseMove;          glm::vec2 m_Position; };
+struct MouseScrollEvent        { static constexpr EventType kType = EventType::MouseScroll;        glm::vec2 m_Offset; };
+struct TransformChangedEvent   { static constexpr EventType kType = EventType::TransformChanged;   entt::entity m_Entity; };
+struct SceneResetEvent         { static constexpr EventType kType = EventType::SceneReset; };
+
 class EventSystem; // Forward declaration for macros
 
 
@@ -72,6 +94,51 @@ public:
      */
     void Shutdown();
     
+    /**
+     * @brief Subscribes a callable to a typed event. The callable is stored inline
+     *        (see EventDelegate::kInlineSize), so it should capture pointers or references.
+     * @tparam Event Event struct
+     * @param callback Callable taking const Event&
+     */
+    template<typename Event, typename Callable>
+    void Subscribe(Callable&& callback)
+    {
+        GetChannel<Event>().Subscribe(std::forward<Callable>(callback));
+    }
+
+    /**
+     * @brief Publishes a typed event: delivered now, or queued if its type is in queued mode.
+     * @param event Event to publish
+     */
+    template<typename Event>
+    void Publish(const Event& event)
+    {
+        if (EventChannel<Event>* channel = FindChannel<Event>())
+            channel->Publish(event, m_PendingStats);
+    }
+
+    /**
+     * @brief Queues a typed event for the next FlushEvents regardless of its dispatch mode.
+     * @param event Event to queue
+     */
+    template<typename Event>
+    void Queue(const Event& event)
+    {
+        GetChannel<Event>().Queue(event, m_PendingStats);
+    }
+
+    /**
+     * @brief Selects whether a typed event is dispatched immediately or queued until FlushEvents.
+     * @tparam Event Event struct
+     * @param mode Immediate or queued dispatch
+     * @param coalescing How queued events of this type are merged
+     */
+    template<typename Event>
+    void SetDispatchMode(EventDispatchMode mode, EventCoalescing coalescing = EventCoalescing::None)
+    {
+        GetChannel<Event>().SetDispatchMode(mode, coalescing);
+    }
+
     /**
      * @brief Subscribe a function to an event type.
      * @param eventType The type of event to subscribe to
@@ -80,11 +147,52 @@ public:
     void SubscribeToEvent(const EventType eventType, EventFunction&& eventFunction);
     
     /**
-     * @brief Fire an event of the specified type.
+     * @brief Fire an event of the specified type; converted to the matching typed event.
      * @param eventType The type of event to fire
      * @param eventData Optional data to send with the event
      */
     void FireEvent(const EventType eventType, EventData eventData = std::monostate());
+
+    /**
+     * @brief Queues an event for the next FlushEvents regardless of the type's dispatch mode.
+     * @param eventType The type of event to queue
+     * @param eventData Optional data to send with the event
+     */
+    void QueueEvent(const EventType eventType, EventData eventData = std::monostate());
+
+    /**
+     * @brief Selects whether an event type is dispatched immediately or queued until FlushEvents.
+     * @param eventType The event type to configure
+     * @param mode Immediate or queued dispatch
+     * @param coalescing How queued events of this type are merged
+     */
+    void SetDispatchMode(EventType eventType, EventDispatchMode mode, EventCoalescing coalescing = EventCoalescing::None);
+
+    /**
+     * @brief Gets the dispatch mode of an event type.
+     * @param eventType The event type to query
+     * @return Immediate unless the type was switched to queued dispatch
+     */
+    EventDispatchMode GetDispatchMode(EventType eventType) const;
+
+    /**
+     * @brief Delivers all queued events, channel by channel in queue order. Events
+     *        fired by subscribers during the flush are queued for the next flush.
+     */
+    void FlushEvents();
+
+    /**
+     * @brief Get the number of events of a type waiting for the next flush.
+     * @param eventType The event type to query
+     * @return The number of queued events after coalescing
+     */
+    size_t GetQueuedEventCount(EventType eventType) const;
+
+    /**
+     * @brief Gets the queue activity that led up to the last flush.
+     * @return Queued, coalesced and dispatched event counts
+     */
+    const EventQueueStats& GetLastFlushStats() const { return m_LastFlushStats; }
     
     /**
      * @brief Get the number of observers for a specific event type.
@@ -121,6 +229,53 @@ private:
     EventSystem(EventSystem&&) = delete;
     EventSystem& operator=(EventSystem&&) = delete;
     
-    std::unordered_map<EventType, std::vector<EventFunction>> m_EventMap;
+    /**
+     * @brief Hands out channel indices in first-use order.
+     * @return Next unused index
+     */
+    static size_t NextChannelIndex();
+
+    /**
+     * @brief Gets the dense channel index of an event type, assigned on first use.
+     * @return Index into m_Channels
+     */
+    template<typename Event>
+    static size_t GetChannelIndex()
+    {
+        static const size_t index = NextChannelIndex();
+        return index;
+    }
+
+    // Existing channel of an event type or nullptr; publishing never creates channels
+    template<typename Event>
+    EventChannel<Event>* FindChannel() const
+    {
+        size_t index = GetChannelIndex<Event>();
+        return index < m_Channels.size() ? static_cast<EventChannel<Event>*>(m_Channels[index].get()) : nullptr;
+    }
+
+    // Channel of an event type, created on first subscription or configuration
+    template<typename Event>
+    EventChannel<Event>& GetChannel()
+    {
+        size_t index = GetChannelIndex<Event>();
+        if (index >= m_Channels.size())
+            m_Channels.resize(index + 1);
+        if (!m_Channels[index])
+            m_Channels[index] = std::make_unique<EventChannel<Event>>();
+        return static_cast<EventChannel<Event>&>(*m_Channels[index]);
+    }
+
+    /**
+     * @brief Gets the channel behind an EventType, if it exists.
+     * @param eventType Event type
+     * @return Channel, nullptr if none was created or the type has no typed event
+     */
+    IEventChannel* FindChannel(EventType eventType) const;
+
+    std::vector<std::unique_ptr<IEventChannel>> m_Channels;           // Indexed by GetChannelIndex, may hold nulls
+    std::unordered_map<EventType, std::deque<EventFunction>> m_LegacySubscribers; // EventData callbacks per type; deques keep them in place
+    EventQueueStats m_PendingStats;
+    EventQueueStats m_LastFlushStats;
     bool m_Initialized = false;
 }; 
\ No newline at end of file
@@ -57,6 +57,13 @@ SideResult ClassifyFrustumAabbNaive(glm::vec3 const fn[6], float const fd[6], Ve
  */
 void TransformAabb(glm::vec3& min, glm::vec3& max, glm::mat4 const& transform);
 
+/**
+ * @brief Computes the matrix that transforms normals for a model matrix.
+ * @param model Model transformation matrix
+ * @return Inverse transpose of the upper-left 3x3 of the model matrix
+ */
+glm::mat3 ComputeNormalMatrix(glm::mat4 const& model);
+
 /**
  * @brief Extracts frustum planes from a view-projection matrix.
  * @param vp View-projection matrix
@@ -0,0 +1,171 @@
+/**
+ * @class GpuTimer
+ * @brief Measures GPU time per render pass with GL_TIME_ELAPSED queries.
+ *
+ * Each pass owns kFrameLatency query objects used round-robin, one per frame in
+ * flight. BeginFrame reads back the set about to be reused, which the GPU finished
+ * frames ago, so reading results never stalls the pipeline; a result that is still
+ * not available is dropped rather than waited on. Timings therefore lag the CPU by
+ * kFrameLatency - 1 frames. A pass that has produced no result for kFrameLatency
+ * frames (e.g. hidden debug geometry) drops out of the reported timings.
+ *
+ * Timer queries are core since GL 3.3 and are implemented by software rasterizers
+ * such as Mesa llvmpipe. Without a GL context (headless mode) the timer is
+ * unavailable and every call is a no-op.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include <array>
+
+/**
+ * @brief Latest and smoothed GPU time of one pass.
+ */
+struct GpuPassTiming
+{
+    const char* m_Name;      ///< Pass name as given to BeginPass
+    double      m_LastMs;    ///< Most recent result read back
+    double      m_AverageMs; ///< Exponential moving average of the results
+};
+
+class GpuTimer
+{
+public:
+    // Query sets in flight per pass: the frame being recorded plus two the GPU may still be working on
+    static constexpr size_t kFrameLatency = 3;
+
+    GpuTimer() = default;
+    ~GpuTimer() = default;
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /**
+     * @brief Enables the timer if a GL context supporting timer queries is current.
+     * @param hasContext False in headless mode, leaving the timer unavailable
+     */
+    void Initialize(bool hasContext);
+
+    /**
+     * @brief Deletes the query objects. The timer is unavailable afterwards.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Checks whether passes are actually measured.
+     * @return True if a context with timer query support was found
+     */
+    bool IsAvailable() const { return m_Available; }
+
+    /**
+     * @brief Enables or disables issuing queries; results already in flight are still read.
+     * @param enabled True to time passes
+     */
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+
+    /**
+     * @brief Checks whether passes are timed when available.
+     * @return True if enabled
+     */
+    bool IsEnabled() const { return m_Enabled; }
+
+    /**
+     * @brief Advances to the next query set, reading back the results it still holds.
+     *        Call once per frame before the first pass.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Starts timing a pass. Time-elapsed queries cannot nest, so a pass begun
+     *        while another is open is not timed.
+     * @param name Pass name; must outlive the timer (string literal)
+     * @return True if a query was started and EndPass must be called
+     */
+    bool BeginPass(const char* name);
+
+    /**
+     * @brief Stops timing the open pass.
+     */
+    void EndPass();
+
+    /**
+     * @brief Gets the timing of every pass with a recent result, in first-use order.
+     * @return Pass timings
+     */
+    std::vector<GpuPassTiming> GetTimings() const;
+
+    /**
+     * @brief Gets the sum of the latest results of the passes reported by GetTimings.
+     * @return GPU milliseconds per frame spent in timed passes
+     */
+    double GetTotalMs() const;
+
+    /**
+     * @brief Gets how many results were discarded because the GPU had not finished them in time.
+     * @return Dropped result count
+     */
+    uint64_t GetDroppedResults() const { return m_DroppedResults; }
+
+private:
+    struct Pass
+    {
+        const char*                       m_Name;
+        std::array<GLuint, kFrameLatency> m_Queries{};
+        std::array<bool, kFrameLatency>   m_Pending{};
+        double                            m_LastMs      = 0.0;
+        double                            m_AverageMs   = 0.0;
+        uint64_t                          m_ResultFrame = 0;     // m_Frame when m_LastMs was read
+        bool                              m_HasResult   = false;
+    };
+
+    /**
+     * @brief Checks whether a pass still reports its time.
+     * @param pass Pass state
+     * @return True if it received a result within the last kFrameLatency frames
+     */
+    bool IsCurrent(const Pass& pass) const { return pass.m_HasResult && m_Frame - pass.m_ResultFrame < kFrameLatency; }
+
+    /**
+     * @brief Finds a pass by name, creating its queries on first use.
+     * @param name Pass name
+     * @return Pass state
+     */
+    Pass& FindOrCreatePass(const char* name);
+
+    static constexpr size_t kNoPass = ~size_t(0);
+
+    std::vector<Pass> m_Passes;
+    size_t            m_OpenPass       = kNoPass; // Index into m_Passes
+    size_t            m_Slot           = 0;
+    uint64_t          m_Frame          = 0;       // BeginFrame calls so far
+    uint64_t          m_DroppedResults = 0;
+    bool              m_Available      = false;
+    bool              m_Enabled        = true;
+};
+
+/**
+ * @class GpuPassScope
+ * @brief Times the enclosing scope as one GPU pass.
+ */
+class GpuPassScope
+{
+public:
+    GpuPassScope(GpuTimer& timer, const char* name)
+        : m_Timer(timer), m_Active(timer.BeginPass(name))
+    {
+    }
+
+    ~GpuPassScope()
+    {
+        if (m_Active)
+            m_Timer.EndPass();
+    }
+
+    GpuPassScope(const GpuPassScope&) = delete;
+    GpuPassScope& operator=(const GpuPassScope&) = delete;
+
+private:
+    GpuTimer& m_Timer;
+    bool      m_Active;
+};
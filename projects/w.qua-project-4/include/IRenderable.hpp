@@ -29,14 +29,12 @@ public:
     virtual void Initialize(const std::shared_ptr<Shader>& shader) = 0;
     
     /**
-     * @brief Renders the object with the given transformation matrices.
+     * @brief Issues the draw call. The caller binds the shader, vertex array and polygon
+     *        mode (see RenderStateCache); view and projection come from the Camera block.
      * @param modelMatrix Model transformation matrix
-     * @param viewMatrix View transformation matrix
-     * @param projectionMatrix Projection transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix (see TransformComponent)
      */
-    virtual void Render(const glm::mat4& modelMatrix, 
-                       const glm::mat4& viewMatrix, 
-                       const glm::mat4& projectionMatrix) = 0;
+    virtual void Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix) = 0;
     
     /**
      * @brief Cleans up OpenGL resources.
@@ -60,10 +58,48 @@ public:
      * @return Editable reference to material properties
      */
     virtual Material& GetMaterialEditable() { return m_Material; }
+    
+    /**
+     * @brief Gets the number of detail levels this renderable can draw.
+     * @return Number of LOD levels (1 if the renderable has no simplified versions)
+     */
+    virtual int GetLODCount() const { return 1; }
+    
+    /**
+     * @brief Selects the detail level used by subsequent Render calls.
+     * @param level LOD level, 0 being full resolution
+     */
+    virtual void SetLODLevel(int level) {}
+    
+    /**
+     * @brief Gets the number of vertices submitted by a Render call.
+     * @return Vertex count of the currently selected geometry
+     */
+    virtual size_t GetVertexCount() const { return m_Buffer.GetVertexCount(); }
+    
+    /**
+     * @brief Gets the vertex array the next Render call draws from.
+     * @return Vertex array object ID
+     */
+    virtual GLuint GetVertexArray() const { return m_Buffer.GetVertexArray(); }
+    
+    /**
+     * @brief Checks if the renderable asks for wireframe drawing.
+     * @return True if wireframe, false if solid
+     */
+    virtual bool IsWireframe() const { return false; }
+    
+    /**
+     * @brief Gets the shader the renderable was initialized with.
+     * @return Shared pointer to the shader program
+     */
+    const std::shared_ptr<Shader>& GetShader() const { return m_Shader; }
 
 protected:
     Buffer m_Buffer;
     std::shared_ptr<Shader> m_Shader;
+    int m_ModelLocation = -1;        // "model" uniform location, resolved in Initialize
+    int m_NormalMatrixLocation = -1; // "normalMatrix" uniform location, resolved in Initialize
     glm::mat4 m_ModelMatrix{};
     Material m_Material; // Default material (white)
 }; 
\ No newline at end of file
@@ -111,6 +111,16 @@ public:
 
     void RenderAssignment4Controls(Registry& registry);
 
+    /**
+     * @brief Renders the frame profiler: frame time history, zone timeline and per-zone statistics.
+     */
+    void RenderProfilerWindow();
+
+    /**
+     * @brief Renders octree / KD-tree structure statistics and frustum query costs.
+     */
+    void RenderSpatialStatsWindow();
+
 private:
     Window& m_Window;
     bool m_Initialized = false;
@@ -118,6 +128,8 @@ private:
     int m_FrameCount = 0;
     float m_FrameRate = 0.0f;
     float m_FrameTimeAccumulator = 0.0f;
+    int m_ProfilerSelectedFrame = -1;  // History index shown in the timeline, -1 follows the latest
+    std::string m_ProfilerLastTrace;   // Last trace file saved from the panel
     
     /**
      * @brief Updates frame rate calculation.
@@ -0,0 +1,85 @@
+/**
+ * @class IndirectDrawBatch
+ * @brief Collects per-frame mesh draws and submits them with one multi-draw indirect call.
+ *
+ * Each queued draw contributes an indirect command pointing into the MeshArena and an
+ * entry in a shader storage buffer holding its model matrix and colour. The vertex
+ * shader looks its entry up through gl_BaseInstance.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Buffer.hpp"
+
+struct MeshArenaRange;
+
+/**
+ * @brief Layout of glMultiDrawElementsIndirect commands.
+ */
+struct DrawElementsIndirectCommand
+{
+    GLuint m_Count;         ///< Number of indices
+    GLuint m_InstanceCount; ///< Number of instances
+    GLuint m_FirstIndex;    ///< Offset into the index buffer, in indices
+    GLint  m_BaseVertex;    ///< Added to each index
+    GLuint m_BaseInstance;  ///< Index of the draw's InstanceData entry
+};
+
+class IndirectDrawBatch
+{
+public:
+    // Shader storage binding point of the per-draw data
+    static constexpr GLuint kInstanceBufferBinding = 2;
+
+    /**
+     * @brief Constructs an empty batch; GL buffers are created on first submission.
+     */
+    IndirectDrawBatch();
+
+    /**
+     * @brief Destructor that releases the command and instance buffers.
+     */
+    ~IndirectDrawBatch();
+
+    IndirectDrawBatch(const IndirectDrawBatch&) = delete;
+    IndirectDrawBatch& operator=(const IndirectDrawBatch&) = delete;
+
+    /**
+     * @brief Discards the draws queued for the previous frame.
+     */
+    void Begin();
+
+    /**
+     * @brief Queues one mesh draw.
+     * @param range Arena range of the mesh LOD to draw
+     * @param modelMatrix Model transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
+     * @param color Colour applied to the whole mesh
+     */
+    void Add(const MeshArenaRange& range, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix, const glm::vec3& color);
+
+    /**
+     * @brief Uploads the queued draws and issues them with a single glMultiDrawElementsIndirect.
+     *        The indirect shader and the MeshArena vertex array must already be bound.
+     */
+    void Submit();
+
+    /**
+     * @brief Gets the number of draws queued this frame.
+     * @return Number of queued draws
+     */
+    size_t GetDrawCount() const { return m_Commands.size(); }
+
+    /**
+     * @brief Releases the GL buffers.
+     */
+    void CleanUp();
+
+private:
+    std::vector<DrawElementsIndirectCommand> m_Commands;
+    std::vector<InstanceData>                m_Instances;
+
+    GLuint m_CommandBuffer  = 0; ///< GL_DRAW_INDIRECT_BUFFER
+    GLuint m_InstanceBuffer = 0; ///< GL_SHADER_STORAGE_BUFFER
+};
@@ -0,0 +1,126 @@
+/**
+ * @class InstancedPrimitiveRenderer
+ * @brief Draws many copies of a unit cube or unit sphere with one instanced call.
+ *
+ * The unit shape is uploaded once; each instance supplies a transform that places,
+ * orients and scales it, plus a colour. Used for bounding-volume and spatial-tree
+ * cell visualisation, where every box or sphere used to own its own vertex buffer.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "IRenderable.hpp"
+
+class Shader;
+
+/**
+ * @brief Unit shapes available for instancing.
+ */
+enum class PrimitiveShape
+{
+    Cube,   ///< Axis-aligned cube spanning [-0.5, 0.5] on each axis
+    Sphere  ///< Sphere of radius 1 centred at the origin
+};
+
+class InstancedPrimitiveRenderer : public IRenderable
+{
+public:
+    /**
+     * @brief Constructs an instanced renderer for a unit shape.
+     * @param shape Unit shape drawn for every instance
+     * @param wireframe Whether to render in wireframe mode
+     */
+    explicit InstancedPrimitiveRenderer(PrimitiveShape shape, bool wireframe = true);
+
+    /**
+     * @brief Destructor for the instanced renderer.
+     */
+    ~InstancedPrimitiveRenderer() override;
+
+    /**
+     * @brief Uploads the unit shape geometry.
+     * @param shader Instanced shader program (per-instance attributes at locations 4-8)
+     */
+    void Initialize(const std::shared_ptr<Shader>& shader) override;
+
+    /**
+     * @brief Draws every instance with a single instanced call.
+     *        Instances must have been uploaded with UploadInstances since the last change.
+     * @param modelMatrix Transform applied on top of every instance transform
+     * @param normalMatrix Normal matrix matching modelMatrix
+     */
+    void Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix) override;
+
+    /**
+     * @brief Cleans up OpenGL resources.
+     */
+    void CleanUp() override;
+
+    /**
+     * @brief Removes all instances.
+     */
+    void ClearInstances();
+
+    /**
+     * @brief Appends an instance; its normal matrix is computed here, once per instance.
+     * @param transform Transform mapping the unit shape into place
+     * @param color Instance colour
+     */
+    void AddInstance(const glm::mat4& transform, const glm::vec3& color);
+
+    /**
+     * @brief Uploads the instance data if it changed. Binds vertex arrays, so call it
+     *        before the draw pass rather than between cached state changes.
+     */
+    void UploadInstances();
+
+    /**
+     * @brief Checks if the instances are drawn in wireframe mode.
+     * @return True if wireframe, false if solid
+     */
+    bool IsWireframe() const override { return m_Wireframe; }
+
+    /**
+     * @brief Gets the number of instances queued for drawing.
+     * @return Number of instances
+     */
+    size_t GetInstanceCount() const { return m_Instances.size(); }
+
+    /**
+     * @brief Gets the number of vertices submitted by a Render call.
+     * @return Unit shape vertex count times the instance count
+     */
+    size_t GetVertexCount() const override { return m_Buffer.GetVertexCount() * m_Instances.size(); }
+
+    /**
+     * @brief Builds the instance transform of an axis-aligned box.
+     * @param center Box center
+     * @param size Full box size along each axis
+     * @return Transform mapping the unit cube onto the box
+     */
+    static glm::mat4 BoxTransform(const glm::vec3& center, const glm::vec3& size);
+
+    /**
+     * @brief Builds the instance transform of an oriented box.
+     * @param center Box center
+     * @param axes Orthonormal box axes
+     * @param halfExtents Half-extents along each axis
+     * @return Transform mapping the unit cube onto the box
+     */
+    static glm::mat4 OrientedBoxTransform(const glm::vec3& center, const glm::vec3 axes[3], const glm::vec3& halfExtents);
+
+    /**
+     * @brief Builds the instance transform of a sphere.
+     * @param center Sphere center
+     * @param radius Sphere radius
+     * @return Transform mapping the unit sphere onto the sphere
+     */
+    static glm::mat4 SphereTransform(const glm::vec3& center, float radius);
+
+private:
+    PrimitiveShape            m_Shape;
+    bool                      m_Wireframe;
+    std::vector<InstanceData> m_Instances;
+    bool                      m_InstancesDirty = true;
+};
@@ -0,0 +1,216 @@
+/**
+ * @class JobSystem
+ * @brief Work-stealing thread pool for engine tasks.
+ *
+ * Every worker thread owns a job deque; threads outside the pool (the main
+ * thread) share one more. A thread pushes and pops its own jobs at the back, so
+ * it keeps working on the most recently forked, cache-warm data, while idle
+ * workers steal from the front of other deques, taking the oldest and usually
+ * largest pieces of work.
+ *
+ * Jobs are joined through JobCounters. Wait does not block: the waiting thread
+ * runs queued jobs until its counter drops to zero, so a job may fork children
+ * onto a counter of its own and wait for them (recursive tree builds) without
+ * tying up a worker.
+ *
+ * Initialized with zero workers, or before Initialize, the system is
+ * single-threaded: Run executes the job immediately and ParallelFor visits its
+ * chunks in order, so results are deterministic and no thread is started.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class JobCounter
+ * @brief Number of unfinished jobs started against it; JobSystem::Wait joins them.
+ *
+ * Counters live on the stack of the code that forks the jobs and must outlive them.
+ */
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    /**
+     * @brief Checks whether every job started against this counter has finished.
+     * @return True if no job is pending
+     */
+    bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_Pending{ 0 };
+};
+
+using JobFunction   = std::function<void()>;
+using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+/**
+ * @brief Job counts since the last ResetStats.
+ */
+struct JobSystemStats
+{
+    uint64_t m_Executed = 0; ///< Jobs run, including those run inline in single-threaded mode
+    uint64_t m_Stolen   = 0; ///< Jobs taken from another thread's deque
+};
+
+class JobSystem
+{
+public:
+    // Initialize argument selecting one worker per hardware thread besides the caller
+    static constexpr size_t kAutoWorkerCount = ~size_t(0);
+
+    /**
+     * @brief Gets the singleton instance.
+     * @return Reference to the job system
+     */
+    static JobSystem& Get();
+
+    /**
+     * @brief Starts the worker threads, restarting the pool if it is running.
+     * @param workerCount Threads to start; 0 keeps everything on the calling thread
+     */
+    void Initialize(size_t workerCount = kAutoWorkerCount);
+
+    /**
+     * @brief Finishes queued jobs and joins the workers. The system is single-threaded afterwards.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return Worker count, 0 when single-threaded
+     */
+    size_t GetWorkerCount() const { return m_Workers.size(); }
+
+    /**
+     * @brief Gets how many threads can run jobs at once, counting the waiting caller.
+     * @return Worker count + 1
+     */
+    size_t GetThreadCount() const { return m_Workers.size() + 1; }
+
+    /**
+     * @brief Checks whether jobs run inline on the calling thread.
+     * @return True without workers
+     */
+    bool IsSingleThreaded() const { return m_Workers.empty(); }
+
+    /**
+     * @brief Queues a job on the calling thread's deque, or runs it now when single-threaded.
+     *        Jobs must not throw; keep captures small to stay within std::function's inline buffer.
+     * @param counter Counter to join the job with
+     * @param job Work to run
+     */
+    void Run(JobCounter& counter, JobFunction job);
+
+    /**
+     * @brief Runs queued jobs on the calling thread until every job of the counter has finished.
+     * @param counter Counter to join
+     */
+    void Wait(JobCounter& counter);
+
+    /**
+     * @brief Calls fn on consecutive ranges of [0, count) and returns once all have run.
+     *
+     * The range is cut into ceil(count / grainSize) chunks whose boundaries do not
+     * depend on the thread count. Chunks are forked by recursive halving, so thieves
+     * take large halves instead of single chunks; the caller works on the first one.
+     *
+     * @param count Number of items
+     * @param grainSize Items per chunk; large enough that a chunk outweighs queueing a job
+     * @param fn Called with [begin, end) of each chunk, possibly on several threads at once
+     */
+    void ParallelFor(size_t count, size_t grainSize, const RangeFunction& fn);
+
+    /**
+     * @brief Gets the job counts since the last reset.
+     * @return Statistics snapshot
+     */
+    JobSystemStats GetStats() const;
+
+    /**
+     * @brief Zeroes the job counts.
+     */
+    void ResetStats();
+
+private:
+    struct Job
+    {
+        JobFunction m_Function;
+        JobCounter* m_Counter = nullptr;
+    };
+
+    struct JobQueue
+    {
+        std::mutex      m_Mutex;
+        std::deque<Job> m_Jobs;
+    };
+
+    JobSystem() = default;
+    ~JobSystem();
+
+    // Delete copy and move constructors/operators
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    /**
+     * @brief Worker thread body: runs jobs, sleeping while none are queued.
+     * @param queueIndex Index of the worker's own deque
+     */
+    void WorkerLoop(size_t queueIndex);
+
+    /**
+     * @brief Pops the newest job of the given deque, or steals the oldest job of another.
+     * @param queueIndex Deque of the calling thread
+     * @param out_job Receives the job
+     * @return True if a job was taken
+     */
+    bool TryTakeJob(size_t queueIndex, Job& out_job);
+
+    /**
+     * @brief Runs a job and releases its counter.
+     * @param job Job to run
+     */
+    void Execute(Job& job);
+
+    // State shared by every chunk of one ParallelFor, on the caller's stack until all have run
+    struct ChunkRange
+    {
+        JobSystem*           m_Jobs;
+        JobCounter*          m_Counter;
+        size_t               m_Count;
+        size_t               m_GrainSize;
+        const RangeFunction* m_Function;
+    };
+
+    /**
+     * @brief Runs chunk firstChunk and forks the rest of [firstChunk, lastChunk) in halves.
+     *        Chunk indices are 32-bit so a fork captures only the range and two indices.
+     */
+    void RunChunks(const ChunkRange& range, uint32_t firstChunk, uint32_t lastChunk);
+
+    std::vector<std::unique_ptr<JobQueue>> m_Queues;  // One per worker plus the last for outside threads
+    std::vector<std::thread>               m_Workers;
+
+    std::atomic<size_t>     m_QueuedJobs{ 0 };       // Jobs sitting in any deque
+    std::atomic<size_t>     m_SleepingWorkers{ 0 };
+    std::mutex              m_SleepMutex;
+    std::condition_variable m_WakeCondition;
+    bool                    m_Stopping = false;      // Guarded by m_SleepMutex
+
+    std::atomic<uint64_t> m_Executed{ 0 };
+    std::atomic<uint64_t> m_Stolen{ 0 };
+};
@@ -6,6 +6,14 @@
  * This header declares the KDTree class which builds and maintains a k-d tree
  * over scene entities stored in an ECS registry. The tree can be rebuilt on
  * demand and provides helpers to visualise the partitions using CubeRenderers.
+ *
+ * Builds read every entity's world AABB from a SpatialSnapshot, shared by the
+ * caller or gathered by the tree, cache the centres once, then split a single
+ * array of (centre, snapshot index) pairs in place with nth_element on the split keys and
+ * partition on the centres, so each subtree owns a
+ * contiguous range and a leaf's objects are a span of the resulting entity
+ * array. Above a size threshold the left subtree is built as a JobSystem job
+ * while the caller builds the right one.
  */
 #pragma once
 
@@ -13,7 +21,11 @@
 #include "Shapes.hpp"
 #include "Components.hpp"
 #include "Registry.hpp"
-#include "CubeRenderer.hpp"
+#include "InstancedPrimitiveRenderer.hpp"
+#include "SpatialStats.hpp"
+#include "SpatialTreeUtils.hpp"
+#include "SpatialSnapshot.hpp"
+#include <span>
 
 // Split strategies for KD-Tree
 enum class KdSplitMethod
@@ -25,13 +37,14 @@ enum class KdSplitMethod
 struct KdNode
 {
     Aabb bounds;                       // Axis-aligned bounding box of this node
-    std::unique_ptr<KdNode> left;      // Child with values < split (nullptr if leaf)
-    std::unique_ptr<KdNode> right;     // Child with values >= split
-    std::vector<Registry::Entity> objects; // Entities stored in this node (leaf)
+    KdNode* left  = nullptr;           // Child with values < split (nullptr if leaf); owned by the tree's node arenas
+    KdNode* right = nullptr;           // Child with values >= split
+    std::span<const Registry::Entity> objects; // Entities stored in this node (leaf); a range of the tree's entity array
 
     int   level  = 0;     // Depth in tree – used for colouring
     int   axis   = 0;     // Axis this node splits on (0=X,1=Y,2=Z)
     float split  = 0.0f;  // Split position along axis (world units)
+    Aabb  contentBounds;  // World AABBs of every object in the subtree; objects may overhang the cell
 
     KdNode(const Aabb& b, int lvl = 0) : bounds(b), level(lvl) {}
 };
@@ -56,18 +69,19 @@ KDTree(Registry& registry,
  */
 ~KDTree() = default;
 
+KDTree(const KDTree&) = delete;
+KDTree& operator=(const KDTree&) = delete;
+
 /**
  * @brief Rebuilds the tree if marked dirty.
  */
 void Build();
 
 /**
- * @brief Collects CubeRenderer drawables for visualising each node.
- * @param shader Shader to be used when drawing the CubeRenderers.
- * @param out Vector to populate with CubeRenderer instances.
+ * @brief Collects one unit-cube instance per node for visualisation.
+ * @param out Instanced cube renderer to fill (existing instances are cleared).
  */
-void CollectRenderables(const std::shared_ptr<Shader>& shader,
-                        std::vector<std::shared_ptr<CubeRenderer>>& out);
+void CollectRenderables(InstancedPrimitiveRenderer& out);
 
 /**
  * @brief Sets the maximum number of objects allowed in a leaf node and marks tree dirty.
@@ -93,6 +107,26 @@ void SetMaxDepth(int depth)                 { m_MaxDepth = std::max(1, depth); m
  */
 int  GetMaxDepth() const                    { return m_MaxDepth; }
 
+/**
+ * @brief Enables or disables building large subtrees as parallel jobs. Does not dirty the tree,
+ *        since both modes build the same tree.
+ * @param parallel True to fork subtrees onto the job system.
+ */
+void SetParallelBuild(bool parallel)        { m_ParallelBuild = parallel; }
+
+/**
+ * @brief Checks whether builds fork subtrees onto the job system.
+ * @return True if parallel builds are enabled.
+ */
+bool IsParallelBuild() const                { return m_ParallelBuild; }
+
+/**
+ * @brief Builds from a snapshot owned by the caller instead of gathering one. A shared
+ *        snapshot that has been rebuilt since the last build triggers a rebuild.
+ * @param snapshot Snapshot to read, or nullptr to gather from the registry again.
+ */
+void SetSnapshot(const SpatialSnapshot* snapshot) { m_SharedSnapshot = snapshot; m_Dirty = true; }
+
 /**
  * @brief Marks the tree as dirty so it will be rebuilt on next access.
  */
@@ -102,35 +136,104 @@ void MarkDirty() { m_Dirty = true; }
  * @brief Returns a pointer to the root node of the tree.
  * @return Const pointer to KdNode root.
  */
-const KdNode* GetRoot() const { return m_Root.get(); }
+const KdNode* GetRoot() const { return m_Root; }
+
+/**
+ * @brief Collects every entity whose world AABB is not outside the frustum.
+ * @param planeNormals The 6 frustum plane normals.
+ * @param planeDistances The 6 frustum plane distances.
+ * @param out Receives the entities (appended).
+ */
+void QueryFrustum(const glm::vec3 planeNormals[6], const float planeDistances[6],
+                  std::vector<Registry::Entity>& out);
+
+/**
+ * @brief Enables or disables counting the work done by queries.
+ * @param enabled True to accumulate query counters.
+ */
+void SetQueryStatsEnabled(bool enabled)     { m_QueryStatsEnabled = enabled; }
+
+/**
+ * @brief Checks whether query counters are being accumulated.
+ * @return True if enabled.
+ */
+bool IsQueryStatsEnabled() const            { return m_QueryStatsEnabled; }
+
+/**
+ * @brief Zeroes the accumulated query counters.
+ */
+void ResetQueryStats()                      { m_QueryStats = SpatialQueryStats(); }
+
+/**
+ * @brief Walks the tree and reports its shape, footprint and query counters.
+ * @return Statistics for the current tree.
+ */
+SpatialTreeStats GetStats() const;
 
 private:
 /**
- * @brief Recursively builds the k-d tree.
- * @param entities List of entities to partition.
+ * @brief Recursively builds the k-d tree over a range of the item order.
+ * @param arena Node arena of the calling build task.
+ * @param begin First position of the node's items in m_Order.
+ * @param end One past the last position.
  * @param bounds Bounding box containing all entities.
  * @param level Current recursion depth.
- * @return Unique pointer to constructed node.
+ * @return The constructed node, stored in arena.
  */
-std::unique_ptr<KdNode> BuildKdTree(const std::vector<Registry::Entity>& entities,
-                                    const Aabb& bounds,
-                                    int level);
+KdNode* BuildKdTree(std::deque<KdNode>& arena,
+                    size_t begin, size_t end,
+                    const Aabb& bounds,
+                    int level);
 
 /**
  * @brief Determines the split position along the given axis according to current strategy.
- * @param entities Entities to examine for split.
+ * @param begin First position of the node's items in m_Order.
+ * @param end One past the last position.
  * @param axis Axis index (0 = X, 1 = Y, 2 = Z).
  * @return World-space coordinate of the split plane.
  */
-float ChooseSplitPosition(const std::vector<Registry::Entity>& entities,
-                          int axis);
+float ChooseSplitPosition(size_t begin, size_t end, int axis);
+
+/**
+ * @brief Recursively collects the entities of a node that intersect the frustum.
+ * @param node Node to test.
+ * @param planeNormals The 6 frustum plane normals.
+ * @param planeDistances The 6 frustum plane distances.
+ * @param out Receives the entities.
+ * @param stats Counters to update, or nullptr when query stats are disabled.
+ */
+void QueryFrustumNode(const KdNode* node,
+                      const glm::vec3 planeNormals[6], const float planeDistances[6],
+                      std::vector<Registry::Entity>& out, SpatialQueryStats* stats);
 
     Registry&                  m_Registry;
-    std::unique_ptr<KdNode>    m_Root;
+    KdNode*                    m_Root = nullptr;
 
     int                        m_MaxObjects;
     KdSplitMethod              m_SplitMethod;
     int                        m_MaxDepth;
 
     bool                       m_Dirty = true;
+    bool                       m_ParallelBuild = true;
+
+    SpatialSnapshot            m_OwnSnapshot;              // Gathered by Build when none is shared
+    const SpatialSnapshot*     m_SharedSnapshot = nullptr;
+    const SpatialSnapshot*     m_Snapshot = nullptr;       // Source of the current tree; m_Order indexes it
+    uint64_t                   m_SnapshotVersion = 0;
+
+    // Snapshot index moved by partitioning, with the centre cached next to it
+    struct BuildRef
+    {
+        glm::vec3 m_Center;
+        uint32_t  m_Item;
+    };
+
+    // Sized by the first build; later builds re-sort and refill them in place
+    std::vector<BuildRef>                    m_Order;    // Every subtree owns a contiguous range
+    std::vector<float>                       m_Keys;     // Split keys of a range, for nth_element
+    std::vector<Registry::Entity>            m_Entities; // m_Order resolved to entities; leaf object spans point here
+    SpatialTreeUtils::NodeArenas<KdNode>     m_NodeArenas;
+
+    bool                       m_QueryStatsEnabled = false;
+    SpatialQueryStats          m_QueryStats;
 }; 
\ No newline at end of file
@@ -32,6 +32,7 @@ namespace Keybinds
     static const int KEY_R = 82;
     static const int KEY_F = 70;  // Wireframe toggle
     static const int KEY_ESCAPE = 256;
+    static const int KEY_F9 = 298;  // Save profiler trace
     
     // Arrow keys
     static const int KEY_LEFT = 263;
@@ -2,8 +2,8 @@
  * @file Lighting.hpp
  * @brief Definitions for lighting and material properties in 3D rendering.
  *
- * This file defines structures for representing directional lights and material properties,
- * with proper memory alignment for GPU buffer usage in lighting calculations.
+ * This file defines structures for representing directional lights, material properties
+ * and per-frame camera data, with proper memory alignment for GPU uniform buffer usage.
  */
 
 #pragma once
@@ -88,4 +88,12 @@ struct Material
           m_Padding(0.0f)
     {
     }
-}; 
\ No newline at end of file
+}; 
+
+struct CameraUniforms
+{
+    glm::mat4 m_View;              ///< World to view space
+    glm::mat4 m_Projection;        ///< View to clip space
+    glm::mat4 m_ViewProjection;    ///< Projection * view, saves a multiply per vertex
+    glm::vec4 m_Position;          ///< Camera position (world space, w unused)
+};
@@ -0,0 +1,128 @@
+/**
+ * @class MeshArena
+ * @brief Shared vertex/index storage for every mesh drawn through the indirect path.
+ *
+ * Mesh resources are welded into indexed form and appended to one vertex buffer and one
+ * index buffer behind a single VAO. Each mesh LOD occupies a sub-range that can be
+ * addressed by a DrawElementsIndirectCommand, so many meshes can be drawn without
+ * rebinding vertex state.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Buffer.hpp"
+#include "ResourceSystem.hpp"
+
+/**
+ * @brief Location of one mesh LOD inside the arena buffers.
+ */
+struct MeshArenaRange
+{
+    GLuint m_FirstIndex = 0; ///< Offset of the first index, in indices
+    GLuint m_IndexCount = 0; ///< Number of indices to draw
+    GLint  m_BaseVertex = 0; ///< Value added to each index when fetching vertices
+};
+
+class MeshArena
+{
+public:
+    /**
+     * @brief Constructs an empty arena; GL buffers are created on first upload.
+     */
+    MeshArena();
+
+    /**
+     * @brief Destructor that releases the arena buffers.
+     */
+    ~MeshArena();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    /**
+     * @brief Gets the arena range of a mesh LOD, uploading every LOD of the mesh on first use.
+     * @param meshHandle Handle of the mesh resource
+     * @param lodLevel Detail level, clamped to the coarsest level available
+     * @return Range of the mesh LOD, or nullptr if the handle does not name a mesh
+     */
+    const MeshArenaRange* Acquire(const ResourceHandle& meshHandle, size_t lodLevel);
+
+    /**
+     * @brief Gets the arena range of a mesh LOD without uploading anything; safe to call from
+     *        several threads as long as no Acquire runs at the same time.
+     * @param meshHandle Handle of the mesh resource
+     * @param lodLevel Detail level, clamped to the coarsest level available
+     * @return Range of the mesh LOD, or nullptr if the mesh has not been acquired yet
+     */
+    const MeshArenaRange* Find(const ResourceHandle& meshHandle, size_t lodLevel) const;
+
+    /**
+     * @brief Binds the arena vertex array (vertex and index buffers).
+     */
+    void Bind() const;
+
+    /**
+     * @brief Unbinds the arena vertex array.
+     */
+    void Unbind() const;
+
+    /**
+     * @brief Releases all GL buffers and forgets every uploaded range.
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the number of vertices stored in the arena.
+     * @return Vertex count across all uploaded meshes
+     */
+    size_t GetVertexCount() const { return m_VertexCount; }
+
+    /**
+     * @brief Gets the number of indices stored in the arena.
+     * @return Index count across all uploaded meshes
+     */
+    size_t GetIndexCount() const { return m_IndexCount; }
+
+    /**
+     * @brief Gets the arena vertex array.
+     * @return VAO ID, 0 before the first upload
+     */
+    GLuint GetVertexArray() const { return m_vao; }
+
+private:
+    GLuint m_vao = 0;                 ///< Vertex array referencing both arena buffers
+    GLuint m_vbo = 0;                 ///< Arena vertex buffer
+    GLuint m_ebo = 0;                 ///< Arena index buffer
+    size_t m_VertexCapacity = 0;      ///< Vertex buffer size, in vertices
+    size_t m_IndexCapacity  = 0;      ///< Index buffer size, in indices
+    size_t m_VertexCount    = 0;      ///< Vertices in use
+    size_t m_IndexCount     = 0;      ///< Indices in use
+    bool   m_VertexArrayDirty = true; ///< Buffers were reallocated since the VAO was set up
+
+    // Ranges of each uploaded mesh, indexed by LOD level
+    std::unordered_map<ResourceHandle, std::vector<MeshArenaRange>> m_Ranges;
+
+    /**
+     * @brief Appends an indexed mesh to the arena buffers.
+     * @param vertices Unique vertices of the mesh
+     * @param indices Triangle indices relative to the first vertex
+     * @return Range describing where the mesh was stored
+     */
+    MeshArenaRange Append(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices);
+
+    /**
+     * @brief Reallocates a buffer so it can hold at least the required number of bytes.
+     * @param buffer Buffer to grow (replaced by the new buffer)
+     * @param capacity Capacity in elements (updated)
+     * @param used Elements already in use, copied into the new buffer
+     * @param required Elements the buffer must be able to hold
+     * @param elementSize Size of one element in bytes
+     */
+    void Reserve(GLuint& buffer, size_t& capacity, size_t used, size_t required, size_t elementSize);
+
+    /**
+     * @brief Points the vertex array at the current arena buffers.
+     */
+    void SetupVertexArray();
+};
@@ -47,12 +47,11 @@ public:
     void Initialize(const std::shared_ptr<Shader>& shader) override;
     
     /**
-     * @brief Renders the mesh with the given transformation matrices.
+     * @brief Renders the mesh with the given model and normal matrices.
      * @param modelMatrix Model transformation matrix
-     * @param viewMatrix View transformation matrix
-     * @param projectionMatrix Projection transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
      */
-    void Render(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) override;
+    void Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix) override;
     
     /**
      * @brief Cleans up OpenGL resources.
@@ -87,7 +86,43 @@ public:
      * @brief Checks if the mesh is rendered in wireframe mode.
      * @return True if wireframe, false if solid
      */
-    bool IsWireframe() const;
+    bool IsWireframe() const override;
+    
+    /**
+     * @brief Gets the mesh resource drawn by this renderer.
+     * @return Handle to the mesh resource
+     */
+    const ResourceHandle& GetMeshHandle() const { return m_MeshHandle; }
+    
+    /**
+     * @brief Gets the currently selected detail level.
+     * @return LOD level, 0 being full resolution
+     */
+    int GetLODLevel() const { return m_LODLevel; }
+    
+    /**
+     * @brief Gets the number of detail levels uploaded for the mesh.
+     * @return Number of LOD levels, including full resolution
+     */
+    int GetLODCount() const override;
+    
+    /**
+     * @brief Selects the detail level drawn by Render.
+     * @param level LOD level, clamped to the available range
+     */
+    void SetLODLevel(int level) override;
+    
+    /**
+     * @brief Gets the number of vertices drawn at the selected detail level.
+     * @return Vertex count of the active LOD buffer
+     */
+    size_t GetVertexCount() const override;
+    
+    /**
+     * @brief Gets the vertex array of the active LOD buffer.
+     * @return Vertex array object ID
+     */
+    GLuint GetVertexArray() const override;
     
 private:
     ResourceHandle m_MeshHandle;
@@ -95,6 +130,22 @@ private:
     bool m_Initialized = false;
     bool m_Wireframe = false;
     
+    // Buffers for LOD 1..N; LOD 0 lives in the inherited m_Buffer
+    std::vector<std::unique_ptr<Buffer>> m_LODBuffers;
+    int m_LODLevel = 0;
+    
+    /**
+     * @brief Gets the buffer for the currently selected detail level.
+     * @return Buffer to bind when drawing
+     */
+    const Buffer& GetActiveBuffer() const;
+    
+    /**
+     * @brief Uploads every detail level of the mesh with the current color applied.
+     * @param mesh Mesh resource providing the vertex data
+     */
+    void UploadLODs(const MeshResource& mesh);
+    
     /**
      * @brief Updates vertex colors to match current color setting.
      */
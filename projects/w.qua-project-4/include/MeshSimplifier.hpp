@@ -0,0 +1,22 @@
+/**
+ * @file MeshSimplifier.hpp
+ * @brief Quadric-error edge-collapse simplification for level-of-detail generation.
+ *
+ * Meshes are stored as non-indexed triangle lists, so the simplifier welds
+ * coincident positions first, collapses edges in order of increasing quadric
+ * error and expands the result back into the same triangle-list layout.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Buffer.hpp"
+
+/**
+ * @brief Simplifies a triangle list using quadric-error edge collapse.
+ * @param vertices Triangle list to simplify (three vertices per triangle)
+ * @param targetRatio Fraction of the input triangles to keep, in the range (0, 1]
+ * @return Simplified triangle list; may hold more triangles than requested when
+ *         further collapses would flip faces or erode open borders
+ */
+std::vector<Vertex> SimplifyMeshQuadric(const std::vector<Vertex>& vertices, float targetRatio);
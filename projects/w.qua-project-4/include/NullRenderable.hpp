@@ -0,0 +1,83 @@
+/**
+ * @class NullRenderable
+ * @brief Renderable that issues no GL calls and records what it would have drawn.
+ *
+ * Stands in for MeshRenderer and the primitive renderers in headless mode, so the
+ * whole frame pipeline (LOD selection, culling, draw sorting) runs without a GPU.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "IRenderable.hpp"
+#include "ResourceSystem.hpp"
+
+class NullRenderable : public IRenderable
+{
+public:
+    /**
+     * @brief Constructs a null renderable mirroring a mesh resource and its LODs.
+     * @param meshHandle Handle to the mesh resource
+     */
+    explicit NullRenderable(const ResourceHandle& meshHandle);
+
+    /**
+     * @brief Constructs a null renderable with a fixed vertex count.
+     * @param vertexCount Vertices a real renderer would submit per draw
+     */
+    explicit NullRenderable(size_t vertexCount);
+
+    /**
+     * @brief Stores the shader; no GL resources are created.
+     * @param shader Shared pointer to the shader program (may be null)
+     */
+    void Initialize(const std::shared_ptr<Shader>& shader) override;
+
+    /**
+     * @brief Records a draw of the selected detail level.
+     * @param modelMatrix Model transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
+     */
+    void Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix) override;
+
+    /**
+     * @brief Nothing to release.
+     */
+    void CleanUp() override {}
+
+    /**
+     * @brief Gets the number of detail levels of the mirrored mesh.
+     * @return Number of LOD levels
+     */
+    int GetLODCount() const override { return static_cast<int>(m_LODVertexCounts.size()); }
+
+    /**
+     * @brief Selects the detail level recorded by Render.
+     * @param level LOD level, clamped to the available range
+     */
+    void SetLODLevel(int level) override;
+
+    /**
+     * @brief Gets the number of vertices at the selected detail level.
+     * @return Vertex count a real renderer would submit
+     */
+    size_t GetVertexCount() const override { return m_LODVertexCounts[m_LODLevel]; }
+
+    /**
+     * @brief Gets the number of Render calls recorded.
+     * @return Draw count since construction
+     */
+    size_t GetDrawCount() const { return m_DrawCount; }
+
+    /**
+     * @brief Gets the total number of vertices recorded by Render calls.
+     * @return Vertex count since construction
+     */
+    size_t GetSubmittedVertexCount() const { return m_SubmittedVertexCount; }
+
+private:
+    std::vector<size_t> m_LODVertexCounts; ///< Vertex count per LOD, never empty
+    int    m_LODLevel = 0;
+    size_t m_DrawCount = 0;
+    size_t m_SubmittedVertexCount = 0;
+};
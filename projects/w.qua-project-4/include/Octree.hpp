@@ -7,6 +7,13 @@
  * accelerate spatial operations such as visibility testing, collision
  * detection, and rendering. The tree adapts to changing scene content and can
  * be visualised with CubeRenderers.
+ *
+ * Builds read every entity's world AABB from a SpatialSnapshot, either one the
+ * caller shares or one the octree gathers itself, then partition an array of
+ * snapshot indices in place: each subtree owns a contiguous range of it, and a
+ * node's objects are a span of the resulting entity array. Subtrees above a size threshold are built
+ * as JobSystem jobs into their own node arenas; the tree is identical whichever
+ * thread builds which subtree, and to the serial build.
  */
 #pragma once
 
@@ -14,9 +21,13 @@
 #include "Shapes.hpp"
 #include "Components.hpp"
 #include "Registry.hpp"
-#include "CubeRenderer.hpp"
+#include "InstancedPrimitiveRenderer.hpp"
+#include "SpatialStats.hpp"
+#include "SpatialTreeUtils.hpp"
+#include "SpatialSnapshot.hpp"
 #include <array>
 #include <memory>
+#include <span>
 
 enum class StraddlingMethod
 {
@@ -28,9 +39,10 @@ struct TreeNode
 {
     glm::vec3 center;                 // Cell centre
     float     halfwidth;              // Half the side length of the cubic cell
-    std::array<std::unique_ptr<TreeNode>, 8> children; // unique_ptr children (nullptr if leaf)
-    std::vector<Registry::Entity> pObjects; // Entities contained in this cell
+    std::array<TreeNode*, 8> children{};         // Child cells (nullptr if empty); owned by the octree's node arenas
+    std::span<const Registry::Entity> pObjects; // Entities contained in this cell; a range of the octree's entity array
     int level;                  // Depth level in the tree (for coloring)
+    Aabb contentBounds;         // World AABBs of every object in the subtree; objects may overhang the cell
 
     TreeNode(const glm::vec3& c, float hw, int lvl = 0)
         : center(c), halfwidth(hw), level(lvl)
@@ -57,6 +69,9 @@ public:
  */
     ~Octree() = default;
 
+    Octree(const Octree&) = delete;
+    Octree& operator=(const Octree&) = delete;
+
 /**
  * @brief Rebuilds the octree if it has been marked dirty.
  */
@@ -87,6 +102,26 @@ public:
  */
     int  GetMaxDepth() const                    { return m_MaxDepth; }
 
+/**
+ * @brief Enables or disables building large subtrees as parallel jobs. Does not dirty the tree,
+ *        since both modes build the same tree.
+ * @param parallel True to fork subtrees onto the job system.
+ */
+    void SetParallelBuild(bool parallel)        { m_ParallelBuild = parallel; }
+
+/**
+ * @brief Checks whether builds fork subtrees onto the job system.
+ * @return True if parallel builds are enabled.
+ */
+    bool IsParallelBuild() const                { return m_ParallelBuild; }
+
+/**
+ * @brief Builds from a snapshot owned by the caller instead of gathering one. A shared
+ *        snapshot that has been rebuilt since the last build triggers a rebuild.
+ * @param snapshot Snapshot to read, or nullptr to gather from the registry again.
+ */
+    void SetSnapshot(const SpatialSnapshot* snapshot) { m_SharedSnapshot = snapshot; m_Dirty = true; }
+
 /**
  * @brief Marks the octree as dirty so it will be rebuilt on next access.
  */
@@ -94,13 +129,10 @@ public:
     void MarkDirty() { m_Dirty = true; }
 
 /**
- * @brief Collects CubeRenderer drawables for visualising each octree cell.
- * @param shader Shader to be used when drawing the CubeRenderers.
- * @param out Vector to populate with CubeRenderer instances.
+ * @brief Collects one unit-cube instance per octree cell for visualisation.
+ * @param out Instanced cube renderer to fill (existing instances are cleared).
  */
-    // Collect CubeRenderer instances for drawing each cell.
-    void CollectRenderables(const std::shared_ptr<Shader>& shader,
-                            std::vector<std::shared_ptr<CubeRenderer>>& out);
+    void CollectRenderables(InstancedPrimitiveRenderer& out);
 
 /**
  * @brief Returns a pointer to the root node of the octree.
@@ -108,18 +140,52 @@ public:
  */
     const TreeNode* GetRoot() const;
 
+/**
+ * @brief Collects every entity whose world AABB is not outside the frustum.
+ * @param planeNormals The 6 frustum plane normals.
+ * @param planeDistances The 6 frustum plane distances.
+ * @param out Receives the entities (appended).
+ */
+    void QueryFrustum(const glm::vec3 planeNormals[6], const float planeDistances[6],
+                      std::vector<Registry::Entity>& out);
+
+/**
+ * @brief Enables or disables counting the work done by queries.
+ * @param enabled True to accumulate query counters.
+ */
+    void SetQueryStatsEnabled(bool enabled)     { m_QueryStatsEnabled = enabled; }
+
+/**
+ * @brief Checks whether query counters are being accumulated.
+ * @return True if enabled.
+ */
+    bool IsQueryStatsEnabled() const            { return m_QueryStatsEnabled; }
+
+/**
+ * @brief Zeroes the accumulated query counters.
+ */
+    void ResetQueryStats()                      { m_QueryStats = SpatialQueryStats(); }
+
+/**
+ * @brief Walks the tree and reports its shape, footprint and query counters.
+ * @return Statistics for the current tree.
+ */
+    SpatialTreeStats GetStats() const;
+
 private:
 /**
- * @brief Recursively builds the octree.
+ * @brief Recursively builds the subtree over a range of the partitioned item order.
+ * @param arena Node arena of the calling build task.
  * @param center Centre of the current cell.
  * @param halfWidth Half the side length of the current cell.
- * @param entities Entities contained in this cell.
+ * @param begin First position of the cell's objects in m_Order.
+ * @param end One past the last position.
  * @param level Current recursion depth.
- * @return Unique pointer to constructed TreeNode.
+ * @return The constructed node, stored in arena.
  */
-    std::unique_ptr<TreeNode> BuildOctree(const glm::vec3& center, float halfWidth, 
-                                                  const std::vector<Registry::Entity>& entities, int level);
-    
+    TreeNode* BuildOctree(std::deque<TreeNode>& arena, const glm::vec3& center, float halfWidth,
+                          size_t begin, size_t end, int level);
+
 /**
  * @brief Determines the child index for an object and whether it straddles multiple children.
  * @param pNode Pointer to current node.
@@ -133,26 +199,61 @@ private:
                        const glm::vec3& objCenter,
                        const glm::vec3& objExtents,
                        int& outIndex,
-                       bool& outStraddle);
-    
+                       bool& outStraddle) const;
+
 /**
- * @brief Distributes entities to the appropriate child vectors.
- * @param pNode Pointer to current node.
- * @param entities Entities contained in current node.
- * @param childEntities Output array of vectors for each child.
- * @param straddlingEntities Output vector for entities that straddle multiple children.
+ * @brief Reorders a range of m_Order so the node's own objects come first, followed by
+ *        the objects of child 0 to 7, each group keeping its input order.
+ * @param pNode Node owning the range.
+ * @param begin First position in m_Order.
+ * @param end One past the last position.
+ * @param outRanges Receives the group boundaries: own objects [0, 1), child i [i + 1, i + 2).
  */
-    void DistributeObjectsToChildren(const TreeNode* pNode,
-                                     const std::vector<Registry::Entity>& entities,
-                                     std::vector<Registry::Entity> childEntities[8],
-                                     std::vector<Registry::Entity>& straddlingEntities);
+    void PartitionObjects(const TreeNode* pNode, size_t begin, size_t end, std::array<size_t, 10>& outRanges);
+
+/**
+ * @brief Resolves a node's own objects to entities and computes its content bounds.
+ * @param node Node whose children are complete.
+ * @param begin First position of the node's own objects in m_Order.
+ * @param end One past the last position.
+ */
+    void FinishNode(TreeNode& node, size_t begin, size_t end);
+
+/**
+ * @brief Recursively collects the entities of a node that intersect the frustum.
+ * @param pNode Node to test.
+ * @param planeNormals The 6 frustum plane normals.
+ * @param planeDistances The 6 frustum plane distances.
+ * @param out Receives the entities.
+ * @param stats Counters to update, or nullptr when query stats are disabled.
+ */
+    void QueryFrustumNode(const TreeNode* pNode,
+                          const glm::vec3 planeNormals[6], const float planeDistances[6],
+                          std::vector<Registry::Entity>& out, SpatialQueryStats* stats);
 
     Registry&            m_Registry;
-    std::unique_ptr<TreeNode> m_Root;
+    TreeNode*            m_Root = nullptr;
 
     int                  m_MaxObjects;
     StraddlingMethod     m_Method;
     int                  m_MaxDepth;  
 
     bool                 m_Dirty = true;
+    bool                 m_ParallelBuild = true;
+
+    SpatialSnapshot              m_OwnSnapshot;              // Gathered by Build when none is shared
+    const SpatialSnapshot*       m_SharedSnapshot = nullptr;
+    const SpatialSnapshot*       m_Snapshot = nullptr;       // Source of the current tree; m_Order indexes it
+    uint64_t                     m_SnapshotVersion = 0;
+
+    // Reused by every Build; partitioning moves each range from m_Order to m_Scratch and back
+    std::vector<uint32_t>         m_Order;    // Snapshot indices; every subtree owns a contiguous range
+    std::vector<uint32_t>         m_Scratch;  // Partition target for the same ranges
+    std::vector<uint8_t>          m_Buckets;  // Group of each position during partitioning
+    std::vector<Registry::Entity> m_Entities; // m_Order resolved to entities; node object spans point here
+
+    SpatialTreeUtils::NodeArenas<TreeNode> m_NodeArenas;
+
+    bool                 m_QueryStatsEnabled = false;
+    SpatialQueryStats    m_QueryStats;
 }; 
\ No newline at end of file
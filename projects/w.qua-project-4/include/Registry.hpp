@@ -4,6 +4,13 @@
  *
  * This class implements a centralized registry for entity-component system (ECS) architecture,
  * handling entity creation, component attachment, and system registration.
+ *
+ * Change tracking: TrackChanges<T>() hooks EnTT's construct / update / destroy
+ * signals of a component type. Every registered change consumer (a spatial tree,
+ * the renderer) then collects the exact entities touched since its own last
+ * ConsumeChanges call, independently of the other consumers. In-place edits
+ * through GetComponent are invisible to EnTT, so code mutating a tracked
+ * component reports it with MarkChanged<T>().
  */
 
 #pragma once
@@ -14,8 +21,27 @@ class Registry
 {
 public:
     using Entity = entt::entity;
+    using ChangeConsumerId = size_t;
+
+    /**
+     * @brief Entities a consumer has not seen yet. Each entity appears at most once per
+     *        list; apply m_Removed before m_Changed, since an entity may be in both.
+     */
+    struct ChangeSet
+    {
+        std::vector<Entity> m_Changed; ///< Tracked component added or modified
+        std::vector<Entity> m_Removed; ///< Tracked component removed or entity destroyed
+
+        bool Empty() const { return m_Changed.empty() && m_Removed.empty(); }
+    };
     
     Registry() = default;
+
+    // Change-tracking listeners are bound to this instance
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+    Registry(Registry&&) = delete;
+    Registry& operator=(Registry&&) = delete;
     
     /**
      * @brief Creates a new entity in the registry.
@@ -89,6 +115,56 @@ public:
         return m_Registry.view<Components...>();
     }
     
+    /**
+     * @brief Reports changes of a component type to the change consumers.
+     * @tparam T Component type to track
+     */
+    template<typename T>
+    void TrackChanges()
+    {
+        // Connecting the same listener twice is a no-op in EnTT
+        m_Registry.on_construct<T>().template connect<&Registry::OnTrackedChange>(*this);
+        m_Registry.on_update<T>().template connect<&Registry::OnTrackedChange>(*this);
+        m_Registry.on_destroy<T>().template connect<&Registry::OnTrackedRemove>(*this);
+    }
+
+    /**
+     * @brief Reports an in-place modification of a component made through GetComponent.
+     * @tparam T Component type that changed
+     * @param entity Entity owning the component
+     */
+    template<typename T>
+    void MarkChanged(Entity entity)
+    {
+        m_Registry.patch<T>(entity);
+    }
+
+    /**
+     * @brief Registers a change consumer. It sees changes made from now on.
+     * @return Consumer ID for ConsumeChanges
+     */
+    ChangeConsumerId RegisterChangeConsumer();
+
+    /**
+     * @brief Stops collecting changes for a consumer and frees its ID.
+     * @param consumer Consumer ID
+     */
+    void UnregisterChangeConsumer(ChangeConsumerId consumer);
+
+    /**
+     * @brief Hands a consumer the entities changed since its previous call and starts a new tick.
+     * @param consumer Consumer ID
+     * @return Changes, valid until the consumer's next ConsumeChanges
+     */
+    const ChangeSet& ConsumeChanges(ChangeConsumerId consumer);
+
+    /**
+     * @brief Counts the changes a consumer has pending without consuming them.
+     * @param consumer Consumer ID
+     * @return Changed plus removed entities
+     */
+    size_t GetPendingChangeCount(ChangeConsumerId consumer) const;
+    
     /**
      * @brief Gets the underlying EnTT registry.
      * @return Reference to the EnTT registry
@@ -108,5 +184,18 @@ public:
     }
 
 private:
+    struct ChangeConsumer
+    {
+        entt::sparse_set m_Changed;  // Sets dedupe entities touched repeatedly
+        entt::sparse_set m_Removed;
+        ChangeSet        m_Consumed; // Lists handed out by ConsumeChanges, capacity reused
+        bool             m_Active = false;
+    };
+
+    void OnTrackedChange(entt::registry& registry, Entity entity);
+    void OnTrackedRemove(entt::registry& registry, Entity entity);
+
+    // Declared first so the consumers outlive any signal the registry emits while destroyed
+    std::vector<ChangeConsumer> m_ChangeConsumers; // Indexed by ChangeConsumerId
     entt::registry m_Registry;
 }; 
\ No newline at end of file
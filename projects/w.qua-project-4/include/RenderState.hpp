@@ -0,0 +1,181 @@
+/**
+ * @class RenderStateCache
+ * @brief Shadows the GL state the RenderSystem changes between draws.
+ *
+ * Program, vertex array and polygon mode changes go through the cache, which skips
+ * redundant calls instead of querying the driver (glGetIntegerv forces a sync) and
+ * counts the changes actually issued each frame. With the null backend (headless
+ * mode) changes are tracked and counted but never reach GL.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "MeshArena.hpp"
+
+class IRenderable;
+
+/**
+ * @brief State changes and draw calls issued during one frame.
+ */
+struct RenderStateStats
+{
+    size_t m_ProgramChanges     = 0; ///< glUseProgram calls
+    size_t m_VertexArrayChanges = 0; ///< glBindVertexArray calls
+    size_t m_PolygonModeChanges = 0; ///< glPolygonMode calls
+    size_t m_DrawCalls          = 0; ///< Draw submissions, an instanced or multi-draw call counting once
+};
+
+/**
+ * @brief One recorded draw command; sorting by key groups draws sharing the same state.
+ *
+ * Plain data, so draw lists can be recorded on any thread and replayed on the GL thread.
+ * Batched meshes carry their arena range and colour instead of a renderable, and sort
+ * ahead of every direct draw with the same key.
+ */
+struct DrawItem
+{
+    uint64_t       m_SortKey;                 ///< See MakeDrawSortKey
+    IRenderable*   m_Renderable = nullptr;    ///< Renderable issuing a direct draw
+    glm::mat4      m_Model;                   ///< Model transformation matrix
+    glm::mat3      m_Normal;                  ///< Normal matrix matching m_Model
+    bool           m_Indirect = false;        ///< Drawn through the multi-draw indirect batch
+    MeshArenaRange m_Range;                   ///< Arena range of a batched mesh
+    glm::vec3      m_Color = glm::vec3(1.0f); ///< Colour of a batched mesh
+
+    bool operator<(const DrawItem& other) const
+    {
+        if (m_SortKey != other.m_SortKey)
+            return m_SortKey < other.m_SortKey;
+        return m_Indirect && !other.m_Indirect;
+    }
+};
+
+/**
+ * @brief Merges consecutive runs of draws, each already sorted, into one sorted list.
+ *        Neighbouring runs are merged pairwise on the job system, level by level; draws
+ *        that compare equal keep their run order, so the result equals a stable sort.
+ * @param draws The runs back to back; sorted on return
+ * @param runOffsets Start of each run followed by draws.size(); left as { 0, draws.size() }
+ */
+void MergeDrawRuns(std::vector<DrawItem>& draws, std::vector<size_t>& runOffsets);
+
+/**
+ * @brief Render passes the sorted draw list is submitted in, in submission order.
+ *        Each pass is timed separately on the CPU and GPU.
+ */
+enum class RenderPass : uint8_t
+{
+    Meshes = 0,      ///< Scene meshes, including the indirect batch
+    BoundingVolumes, ///< AABB, OBB and sphere wireframes
+    OctreeCells,     ///< Octree node boxes
+    KDTreeCells,     ///< KD-tree node boxes
+    Count
+};
+
+/**
+ * @brief Gets the display name of a render pass, also used as its profiler zone name.
+ * @param pass Render pass
+ * @return Static name string
+ */
+inline const char* GetRenderPassName(RenderPass pass)
+{
+    switch (pass)
+    {
+    case RenderPass::Meshes:          return "Pass: Meshes";
+    case RenderPass::BoundingVolumes: return "Pass: Bounding Volumes";
+    case RenderPass::OctreeCells:     return "Pass: Octree Cells";
+    case RenderPass::KDTreeCells:     return "Pass: KD-Tree Cells";
+    default:                          return "Pass: Unknown";
+    }
+}
+
+/**
+ * @brief Builds a draw sort key ordered by pass, then polygon mode, then program, then vertex array.
+ *        Within a pass solid draws sort before wireframe ones so each mode is set once per pass.
+ *
+ * Layout: pass in bits 60-63, wireframe in bit 59, program in bits 32-58, vertex array in bits 0-31.
+ *
+ * @param wireframe Whether the draw uses GL_LINE
+ * @param program Shader program ID
+ * @param vertexArray Vertex array object ID
+ * @param pass Render pass the draw belongs to
+ * @return Sort key
+ */
+inline uint64_t MakeDrawSortKey(bool wireframe, GLuint program, GLuint vertexArray, RenderPass pass = RenderPass::Meshes)
+{
+    return (static_cast<uint64_t>(pass) << 60) |
+           (static_cast<uint64_t>(wireframe) << 59) |
+           (static_cast<uint64_t>(program & 0x07FFFFFFu) << 32) |
+           static_cast<uint64_t>(vertexArray);
+}
+
+/** @brief Extracts the render pass from a sort key. */
+inline RenderPass GetSortKeyPass(uint64_t key) { return static_cast<RenderPass>(key >> 60); }
+
+/** @brief Extracts the wireframe flag from a sort key. */
+inline bool GetSortKeyWireframe(uint64_t key) { return ((key >> 59) & 1u) != 0; }
+
+/** @brief Extracts the shader program ID from a sort key. */
+inline GLuint GetSortKeyProgram(uint64_t key) { return static_cast<GLuint>((key >> 32) & 0x07FFFFFFu); }
+
+class RenderStateCache
+{
+public:
+    /**
+     * @brief Selects whether state changes are only counted instead of issued.
+     * @param nullBackend True when no GL context exists
+     */
+    void SetNullBackend(bool nullBackend) { m_NullBackend = nullBackend; }
+
+    /**
+     * @brief Forgets the tracked state so the next change of each kind is always issued.
+     *        Call after code outside the cache (UI, uploads) may have touched GL state.
+     */
+    void Invalidate();
+
+    /**
+     * @brief Clears the per-frame counters.
+     */
+    void ResetStats();
+
+    /**
+     * @brief Binds a shader program if it is not already bound.
+     * @param program Shader program ID
+     */
+    void UseProgram(GLuint program);
+
+    /**
+     * @brief Binds a vertex array if it is not already bound.
+     * @param vertexArray Vertex array object ID
+     */
+    void BindVertexArray(GLuint vertexArray);
+
+    /**
+     * @brief Sets the front and back polygon mode if it differs from the current one.
+     * @param mode GL_FILL or GL_LINE
+     */
+    void SetPolygonMode(GLenum mode);
+
+    /**
+     * @brief Records a draw submission.
+     */
+    void CountDraw() { ++m_Stats.m_DrawCalls; }
+
+    /**
+     * @brief Gets the counters accumulated since the last ResetStats.
+     * @return State change and draw counts
+     */
+    const RenderStateStats& GetStats() const { return m_Stats; }
+
+private:
+    // Sentinels no real GL object or mode uses, so the first change is always issued
+    static constexpr GLuint kUnknownObject = ~0u;
+    static constexpr GLenum kUnknownMode   = 0;
+
+    GLuint           m_Program     = kUnknownObject;
+    GLuint           m_VertexArray = kUnknownObject;
+    GLenum           m_PolygonMode = kUnknownMode;
+    RenderStateStats m_Stats;
+    bool             m_NullBackend = false;
+};
@@ -12,9 +12,17 @@
 #include "Lighting.hpp"
 #include "Octree.hpp" 
 #include "KDTree.hpp"
+#include "SpatialSnapshot.hpp"
+#include "RenderState.hpp"
+#include "GpuTimer.hpp"
+#include "ResourceSystem.hpp"
+#include <array>
 class Shader;
 class Window;
 class CameraSystem;
+class IRenderable;
+class MeshArena;
+class IndirectDrawBatch;
 
 struct RenderComponent;
 struct TransformComponent;
@@ -35,6 +43,11 @@ public:
      */
     RenderSystem(Registry& registry, Window& window, const std::shared_ptr<Shader>& shader);
     
+    /**
+     * @brief Destructor; defined out of line for the forward-declared batch members.
+     */
+    ~RenderSystem();
+    
     /**
      * @brief Initializes the render system and OpenGL resources.
      */
@@ -56,6 +69,20 @@ public:
      */
     std::shared_ptr<Shader> GetShader() const { return m_Shader; }
     
+    /**
+     * @brief Checks if the system runs without a GL context (see Window::IsHeadless).
+     * @return True in headless mode
+     */
+    bool IsHeadless() const { return m_Headless; }
+    
+    /**
+     * @brief Creates the renderable for a mesh: a MeshRenderer, or a NullRenderable when headless.
+     * @param meshHandle Handle to the mesh resource
+     * @param color Color to apply to the mesh
+     * @return Renderable ready to be initialized by the render system
+     */
+    std::shared_ptr<IRenderable> CreateMeshRenderable(const ResourceHandle& meshHandle, const glm::vec3& color) const;
+    
     // Lighting control
     /**
      * @brief Toggles the directional light on or off.
@@ -205,6 +232,105 @@ public:
     void SetKDTreeMaxDepth(int maxDepth);
     int  GetKDTreeMaxDepth() const;
 
+    // Spatial query statistics
+    /**
+     * @brief Runs an instrumented camera frustum query on both trees every frame.
+     * @param enable True to measure query cost, false to stop counting
+     */
+    void SetMeasureSpatialQueries(bool enable);
+    
+    /**
+     * @brief Checks if frustum queries are being measured.
+     * @return True if measuring, false otherwise
+     */
+    bool IsMeasuringSpatialQueries() const { return m_MeasureSpatialQueries; }
+    
+    /**
+     * @brief Zeroes the query counters of both trees.
+     */
+    void ResetSpatialQueryStats();
+    
+    /**
+     * @brief Gets the octree's structure statistics and query counters.
+     * @return Octree statistics, empty before the first build
+     */
+    SpatialTreeStats GetOctreeStats() const;
+    
+    /**
+     * @brief Gets the KD-tree's structure statistics and query counters.
+     * @return KD-tree statistics, empty before the first build
+     */
+    SpatialTreeStats GetKDTreeStats() const;
+
+    // Level of detail controls
+    /**
+     * @brief Enables or disables per-entity level of detail selection.
+     * @param enable True to pick LODs from projected size, false to always draw full detail
+     */
+    void SetLODEnabled(bool enable);
+    
+    /**
+     * @brief Checks if level of detail selection is enabled.
+     * @return True if LOD selection is enabled, false otherwise
+     */
+    bool IsLODEnabled() const;
+    
+    /**
+     * @brief Sets the projected diameter (pixels) below which meshes drop to LOD 1.
+     *        Each further halving of the diameter drops one more level.
+     * @param pixels Projected bounding-sphere diameter threshold in pixels
+     */
+    void SetLODPixelThreshold(float pixels);
+    
+    /**
+     * @brief Gets the projected diameter threshold for the first LOD switch.
+     * @return Threshold in pixels
+     */
+    float GetLODPixelThreshold() const;
+    
+    // Indirect drawing controls
+    /**
+     * @brief Enables or disables batching meshes into one multi-draw indirect call.
+     * @param enable True to batch meshes, false to draw each renderable individually
+     */
+    void SetIndirectDrawEnabled(bool enable);
+    
+    /**
+     * @brief Checks if multi-draw indirect batching is enabled.
+     * @return True if meshes are batched, false otherwise
+     */
+    bool IsIndirectDrawEnabled() const;
+    
+    /**
+     * @brief Gets the number of meshes submitted through the indirect batch last frame.
+     * @return Number of batched draws
+     */
+    size_t GetLastFrameIndirectDrawCount() const { return m_LastFrameIndirectDrawCount; }
+    
+    /**
+     * @brief Gets the number of mesh vertices submitted during the last frame.
+     * @return Vertex count of the last rendered frame
+     */
+    size_t GetLastFrameVertexCount() const { return m_LastFrameVertexCount; }
+
+    /**
+     * @brief Gets the number of render-view entities handed to the submit pass last frame.
+     * @return Entities left after frustum culling (all visible ones while culling is off)
+     */
+    size_t GetLastFrameVisibleCount() const { return m_VisibleEntities.size(); }
+    
+    /**
+     * @brief Gets the GL state changes and draw calls issued during the last frame.
+     * @return Per-frame state change counters
+     */
+    const RenderStateStats& GetLastFrameStateStats() const { return m_LastFrameStateStats; }
+
+    /**
+     * @brief Gets the GPU timer measuring each render pass; other passes (UI) can be timed with it too.
+     * @return Per-pass GPU timer, unavailable in headless mode
+     */
+    GpuTimer& GetGpuTimer() { return m_GpuTimer; }
+
 private:
     /**
      * @brief Sets up lighting system and uniform buffer objects.
@@ -251,7 +377,7 @@ private:
     float m_LightRotationSpeed = glm::radians(15.0f); // 15 degrees per second
     
     // Frustum culling control
-    bool m_EnableFrustumCulling = false;
+    bool m_EnableFrustumCulling = true;
     CameraSystem* m_CameraSystem = nullptr;
     
     // Frustum visualization flag retained (no renderer instance)
@@ -259,6 +385,7 @@ private:
     
     // OpenGL buffer IDs
     GLuint m_MaterialUBO = 0;
+    GLuint m_CameraUBO = 0;
     
     // Default material used for regular objects; reapplied after bounding-volume draws
     Material m_DefaultMaterial;
@@ -268,7 +395,7 @@ private:
 
     // ---------------- Octree members ----------------
     std::unique_ptr<Octree>                      m_Octree;
-    std::vector<std::shared_ptr<CubeRenderer>>   m_OctreeRenderables;
+    std::unique_ptr<InstancedPrimitiveRenderer>  m_OctreeCells;
     bool                                         m_ShowOctreeCells = false;
     bool                                         m_OctreeDirty     = true;
     int                                          m_OctreeMaxObjects = 10;
@@ -279,7 +406,7 @@ private:
 
     // ---------------- KD-tree members ----------------
     std::unique_ptr<KDTree>                      m_KDTree;
-    std::vector<std::shared_ptr<CubeRenderer>>   m_KDTreeRenderables;
+    std::unique_ptr<InstancedPrimitiveRenderer>  m_KDTreeCells;
     bool                                         m_ShowKDTreeCells = false;
     bool                                         m_KDTreeDirty     = true;
     int                                          m_KDTreeMaxObjects = 10;
@@ -287,4 +414,178 @@ private:
     KdSplitMethod                                m_KdSplitMethod   = KdSplitMethod::MedianCenter;
 
     void                                         BuildKDTree();
+
+    // ---------------- Spatial snapshot ----------------
+    // World AABBs shared by both trees and AABB culling; the trees rebuild whenever it does
+    SpatialSnapshot                              m_SpatialSnapshot;
+    bool                                         m_SpatialSnapshotDirty = true;
+    std::vector<SideResult>                      m_FrustumResults; // Per snapshot index, reused every frame
+
+    void                                         BuildSpatialSnapshot();
+
+    // ---------------- Culling ----------------
+    // Bounding volume the render view is culled with
+    enum class CullVolume { None, AABB, OBB, Sphere };
+
+    std::vector<Registry::Entity>                m_CullCandidates; // Render view of the current frame
+    std::vector<uint8_t>                         m_CullFlags; // Cull result of each candidate
+    std::vector<size_t>                          m_CullChunkOffsets; // First visible slot of each cull chunk
+    std::vector<Registry::Entity>                m_VisibleEntities; // Candidates left to submit, in view order
+
+    /**
+     * @brief Picks the volume to cull with: the displayed one, else the snapshot AABB while culling is on.
+     * @return Volume tested against the frustum, None to keep every entity
+     */
+    CullVolume                                   GetCullVolume() const;
+
+    /**
+     * @brief Tests the render view against the camera frustum in parallel chunks and
+     *        compacts the entities to draw into m_VisibleEntities.
+     * @return Number of entities inside or overlapping the frustum
+     */
+    size_t                                       CullRenderView();
+
+    // ---------------- Change tracking ----------------
+    Registry::ChangeConsumerId                   m_SnapshotChanges = 0;
+
+    /**
+     * @brief Consumes the pending entity changes and reports whether any affect the snapshot.
+     * @return True if an entity with bounds changed or was removed
+     */
+    bool                                         ConsumeSnapshotChanges();
+
+    // ---------------- Spatial query statistics ----------------
+    bool                                         m_MeasureSpatialQueries = false;
+    std::vector<Registry::Entity>                m_SpatialQueryResults; // Reused scratch list
+
+    // ---------------- Instanced primitives ----------------
+    std::shared_ptr<Shader>                      m_InstancedShader;
+    std::unique_ptr<InstancedPrimitiveRenderer>  m_AABBInstances;
+    std::unique_ptr<InstancedPrimitiveRenderer>  m_OBBInstances;
+    std::unique_ptr<InstancedPrimitiveRenderer>  m_SphereInstances;
+
+    // ---------------- Indirect drawing ----------------
+    std::shared_ptr<Shader>                      m_IndirectShader;
+    std::unique_ptr<MeshArena>                   m_MeshArena;
+    std::unique_ptr<IndirectDrawBatch>           m_IndirectBatch;
+    bool                                         m_EnableIndirectDraw = true;
+    size_t                                       m_LastFrameIndirectDrawCount = 0;
+
+    /**
+     * @brief Draws recorded by one job over a range of the visible entities, or by the main thread.
+     */
+    struct DrawCommandList
+    {
+        std::vector<DrawItem>                 m_Draws;           ///< Sorted by key once recorded
+        std::array<std::vector<glm::mat4>, 3> m_VolumeInstances; ///< AABB, OBB and sphere instance transforms
+        std::vector<ResourceHandle>           m_MissingMeshes;   ///< Batchable meshes not in the arena yet
+        size_t                                m_VertexCount = 0; ///< Vertices of the recorded meshes
+
+        void Clear()
+        {
+            m_Draws.clear();
+            for (auto& instances : m_VolumeInstances)
+            {
+                instances.clear();
+            }
+            m_MissingMeshes.clear();
+            m_VertexCount = 0;
+        }
+    };
+
+    /**
+     * @brief Records a renderable as a batched mesh draw if it is a batchable mesh.
+     *        Only reads the arena, so jobs may call it concurrently.
+     * @param renderable Renderable to draw, with its LOD already selected
+     * @param modelMatrix Model transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
+     * @param commands List to record into; a mesh not in the arena yet is noted there for upload
+     * @return True if the draw was recorded, false if it must be rendered directly
+     */
+    bool RecordIndirectDraw(IRenderable& renderable, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix,
+                            DrawCommandList& commands) const;
+
+    /**
+     * @brief Binds whichever of the shared Material, DirectionalLight and Camera uniform
+     *        blocks a shader declares. Missing blocks are skipped.
+     * @param shader Shader program to configure
+     * @return True if the shader declares the Camera block
+     */
+    bool BindSharedUniformBlocks(const Shader& shader);
+
+    /**
+     * @brief Uploads the per-frame camera uniform block.
+     * @param viewMatrix View transformation matrix
+     * @param projectionMatrix Projection transformation matrix
+     * @param cameraPosition Camera position in world space
+     */
+    void UpdateCameraUBO(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& cameraPosition);
+
+    // Headless mode: no GL calls, renderables are NullRenderables
+    bool                                         m_Headless = false;
+
+    // ---------------- Draw submission ----------------
+    std::vector<DrawCommandList>                 m_CommandLists; // One per record chunk, the main thread's last
+    std::vector<size_t>                          m_DrawRuns; // Start of each list's draws in m_DrawList
+    std::vector<DrawItem>                        m_DrawList; // All recorded draws, merged by sort key
+    RenderStateCache                             m_StateCache;
+    RenderStateStats                             m_LastFrameStateStats;
+    GpuTimer                                     m_GpuTimer;
+
+    /**
+     * @brief Builds the direct draw command of a renderable.
+     * @param renderable Renderable to draw
+     * @param modelMatrix Model transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
+     * @param pass Render pass the draw is submitted and timed in
+     * @return Draw command keyed by the state it needs
+     */
+    DrawItem MakeDrawItem(IRenderable& renderable, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix,
+                          RenderPass pass = RenderPass::Meshes) const;
+
+    /**
+     * @brief Queues a direct draw into the main thread's command list.
+     * @param renderable Renderable to draw
+     * @param modelMatrix Model transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
+     * @param pass Render pass the draw is submitted and timed in
+     */
+    void QueueDraw(IRenderable& renderable, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix,
+                   RenderPass pass = RenderPass::Meshes);
+
+    /**
+     * @brief Records the draws, LOD choices and bounding-volume instances of the visible
+     *        entities into per-chunk command lists on the job system, without touching GL.
+     * @param cameraPosition Camera position in world space
+     * @param pixelsPerRadian Viewport height divided by tan(fov / 2)
+     */
+    void RecordDrawCommands(const glm::vec3& cameraPosition, float pixelsPerRadian);
+
+    /**
+     * @brief Sorts the main thread's list and merges every command list into m_DrawList.
+     */
+    void MergeDrawCommands();
+
+    /**
+     * @brief Replays the merged draw list through the state cache in one pass, one render
+     *        pass at a time, each timed on the CPU and GPU. Batched meshes lead the mesh pass
+     *        and go out in a single multi-draw indirect call.
+     */
+    void SubmitDrawList();
+
+    // ---------------- Level of detail ----------------
+    bool                                         m_EnableLOD           = true;
+    float                                        m_LODPixelThreshold   = 256.0f;
+    size_t                                       m_LastFrameVertexCount = 0;
+
+    /**
+     * @brief Picks a detail level from the projected size of a world-space bounding sphere.
+     * @param worldSphere Bounding sphere of the entity in world space
+     * @param cameraPosition Camera position in world space
+     * @param pixelsPerRadian Viewport height divided by tan(fov / 2)
+     * @param lodCount Number of levels the renderable provides
+     * @return Selected LOD level, 0 being full resolution
+     */
+    int SelectLODLevel(const Sphere& worldSphere, const glm::vec3& cameraPosition,
+                       float pixelsPerRadian, int lodCount) const;
 }; 
\ No newline at end of file
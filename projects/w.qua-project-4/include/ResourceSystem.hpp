@@ -9,6 +9,7 @@
 #pragma once
 
 #include "pch.h"
+#include "Shapes.hpp"
 #include <random>
 
 // Forward declarations
@@ -50,8 +51,68 @@ public:
      */
     const std::vector<Vertex>& GetVertexes() const { return m_Vertices; }
     
+    /**
+     * @brief Sets the simplified level-of-detail meshes (LOD 1 onwards, coarser each level).
+     * @param lods Vector of triangle lists to move into the resource
+     */
+    void SetLODs(std::vector<std::vector<Vertex>>&& lods) { m_LODs = std::move(lods); }
+    
+    /**
+     * @brief Gets the number of detail levels, including the full resolution mesh.
+     * @return Number of available LOD levels (at least 1)
+     */
+    size_t GetLODCount() const { return 1 + m_LODs.size(); }
+    
+    /**
+     * @brief Gets the vertex data for a detail level.
+     * @param level LOD level (0 = full resolution), clamped to the coarsest level
+     * @return Const reference to the vertex data of that level
+     */
+    const std::vector<Vertex>& GetLODVertexes(size_t level) const
+    {
+        if (level == 0 || m_LODs.empty()) return m_Vertices;
+        return m_LODs[std::min(level, m_LODs.size()) - 1];
+    }
+    
+    /**
+     * @brief Computes the local-space bounding volumes from the full resolution vertices.
+     *        Called once when the mesh is imported; cached resources reuse the result.
+     */
+    void ComputeBounds();
+    
+    /**
+     * @brief Checks if the bounding volumes have been computed.
+     * @return True once ComputeBounds has run on non-empty vertex data
+     */
+    bool HasBounds() const { return m_BoundsComputed; }
+    
+    /**
+     * @brief Gets the local-space axis-aligned bounding box.
+     * @return Const reference to the AABB
+     */
+    const Aabb& GetAABB() const { return m_AABB; }
+    
+    /**
+     * @brief Gets the local-space PCA bounding sphere.
+     * @return Const reference to the sphere
+     */
+    const Sphere& GetPCASphere() const { return m_PCASphere; }
+    
+    /**
+     * @brief Gets the local-space PCA oriented bounding box.
+     * @return Const reference to the OBB
+     */
+    const Obb& GetOBB() const { return m_OBB; }
+    
 private:
     std::vector<Vertex> m_Vertices;   // Vertex data
+    std::vector<std::vector<Vertex>> m_LODs; // Simplified meshes, LOD 1..N
+    
+    // Local-space bounding volumes, shared by every entity using this mesh
+    Aabb   m_AABB;
+    Sphere m_PCASphere;
+    Obb    m_OBB;
+    bool   m_BoundsComputed = false;
 };
 
 class ResourceSystem 
@@ -77,6 +138,15 @@ public:
      */
     ResourceHandle LoadMesh(const std::string& path);
     
+    /**
+     * @brief Loads a batch of meshes, post-processing the new ones in parallel.
+     *        Files are imported one after another (the importer is shared), then
+     *        bounding volumes and LODs of newly imported meshes are built concurrently.
+     * @param paths File paths of the mesh resources
+     * @return Handles in the same order as paths (INVALID_RESOURCE_HANDLE on failure)
+     */
+    std::vector<ResourceHandle> LoadMeshes(const std::vector<std::string>& paths);
+    
     /**
      * @brief Gets a mesh resource by its handle.
      * @param handle Handle to the mesh resource
@@ -145,4 +215,24 @@ private:
      * @return Vector of processed vertex data
      */
     std::vector<Vertex> ProcessAssimpMesh(const aiMesh* mesh);
+    
+    /**
+     * @brief Imports a mesh file into the cache without post-processing it.
+     * @param path File path to the mesh resource
+     * @param out_mesh Receives the newly imported mesh, or nullptr if it was already cached
+     * @return Handle to the mesh resource
+     */
+    ResourceHandle ImportMesh(const std::string& path, std::shared_ptr<MeshResource>* out_mesh);
+    
+    /**
+     * @brief Computes bounding volumes and LODs of a freshly imported mesh.
+     * @param mesh Mesh resource to post-process
+     */
+    void PostProcessMesh(MeshResource& mesh);
+    
+    /**
+     * @brief Generates the simplified detail levels of a freshly loaded mesh.
+     * @param mesh Mesh resource to populate with LODs
+     */
+    void GenerateLODs(MeshResource& mesh);
 }; 
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file SceneGenerator.hpp
+ * @brief Deterministic synthetic scenes for scaling tests of the spatial structures.
+ *
+ * Generated entities carry a TransformComponent and a BoundingComponent whose
+ * AABB, sphere and OBB are filled in directly, so no mesh resource, window or
+ * GL context is needed. The same configuration and seed always produce the
+ * same scene, independent of the standard library in use.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Registry.hpp"
+
+enum class SceneDistribution
+{
+    Uniform = 0,       // Small boxes spread evenly through the volume
+    GaussianClusters,  // Small boxes in Gaussian clumps around random centres
+    Grid,              // Regular lattice of equal boxes
+    City,              // Tall buildings and long horizontal beams on a ground plane (UNC-like)
+    MixedScales,       // Log-uniform sizes spanning three orders of magnitude
+    Count
+};
+
+struct SceneGeneratorConfig
+{
+    size_t            m_ObjectCount  = 1000;
+    SceneDistribution m_Distribution = SceneDistribution::Uniform;
+    uint32_t          m_Seed         = 1234u;
+    float             m_HalfSize     = 0.0f; ///< Half side of the populated cube; 0 keeps density constant as the count grows
+    int               m_ClusterCount = 16;   ///< Only used by GaussianClusters
+};
+
+namespace SceneGenerator
+{
+    /**
+     * @brief Gets the scene half size used when the configuration leaves it at 0.
+     * @param objectCount Number of objects in the scene
+     * @return Half side length giving roughly 1000 objects per 100^3 units
+     */
+    float DefaultHalfSize(size_t objectCount);
+
+    /**
+     * @brief Adds the configured number of synthetic entities to a registry.
+     * @param registry Registry to populate (existing entities are kept)
+     * @param config Object count, distribution, seed and extent
+     * @return Created entities in generation order
+     */
+    std::vector<Registry::Entity> Generate(Registry& registry, const SceneGeneratorConfig& config);
+
+    /**
+     * @brief Gets a printable name for a distribution.
+     * @param distribution Distribution to name
+     * @return Static name string
+     */
+    const char* GetDistributionName(SceneDistribution distribution);
+}
@@ -100,17 +100,40 @@ public:
      */
     void SetMat4(const std::string& name, const glm::mat4& mat) const;
     
-private:
-    unsigned int m_ID;  ///< Shader program ID
-    mutable std::unordered_map<std::string, int> m_uniformLocationCache;  ///< Cache for uniform locations
+    // Pre-resolved location setters for per-draw uniforms
+    /**
+     * @brief Sets a vec3 uniform variable by location.
+     * @param location Location returned by GetUniformLocation
+     * @param value vec3 value to set
+     */
+    void SetVec3(int location, const glm::vec3& value) const;
+    
+    /**
+     * @brief Sets a mat3 uniform variable by location.
+     * @param location Location returned by GetUniformLocation
+     * @param mat mat3 matrix to set
+     */
+    void SetMat3(int location, const glm::mat3& mat) const;
+    
+    /**
+     * @brief Sets a mat4 uniform variable by location.
+     * @param location Location returned by GetUniformLocation
+     * @param mat mat4 matrix to set
+     */
+    void SetMat4(int location, const glm::mat4& mat) const;
     
     /**
      * @brief Gets the location of a uniform variable, with caching.
+     *        Resolve once at initialization and use the location setters per draw.
      * @param name Name of the uniform variable
-     * @return Location of the uniform variable
+     * @return Location of the uniform variable, -1 if not found
      */
     int GetUniformLocation(const std::string& name) const;
     
+private:
+    unsigned int m_ID;  ///< Shader program ID
+    mutable std::unordered_map<std::string, int> m_uniformLocationCache;  ///< Cache for uniform locations
+    
     /**
      * @brief Checks for shader compilation or linking errors.
      * @param shader Shader ID to check
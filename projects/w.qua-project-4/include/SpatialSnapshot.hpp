@@ -0,0 +1,167 @@
+/**
+ * @class SpatialSnapshot
+ * @brief World AABBs of every bounded entity, stored as structure-of-arrays.
+ *
+ * One Build walks the TransformComponent/BoundingComponent view, transforms each
+ * local AABB by the entity's model matrix and writes the result to six separate
+ * cache-line aligned float arrays (min x/y/z, max x/y/z) next to a parallel
+ * entity array. Consumers index all of them with the same snapshot index:
+ * tree builds partition indices into the snapshot instead of re-reading
+ * components, and frustum culling streams the arrays plane by plane in loops
+ * the compiler can vectorise.
+ *
+ * Every Build bumps the version, so a tree built from a shared snapshot can
+ * tell when its indices no longer refer to the current contents.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Registry.hpp"
+#include "Shapes.hpp"
+#include "Geometry.hpp"
+#include <array>
+#include <limits>
+#include <new>
+#include <span>
+
+/**
+ * @brief Allocator returning storage aligned to Alignment bytes, for arrays read with SIMD loads.
+ */
+template<typename T, size_t Alignment>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* pointer, size_t)
+    {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+};
+
+class SpatialSnapshot
+{
+public:
+    // Alignment of every coordinate array; one cache line, and a multiple of any SIMD width in use
+    static constexpr size_t kAlignment = 64;
+    // FindIndex result for entities that are not in the snapshot
+    static constexpr size_t kInvalidIndex = std::numeric_limits<size_t>::max();
+
+    using FloatArray = std::vector<float, AlignedAllocator<float, kAlignment>>;
+
+    /**
+     * @brief Replaces the contents with the world AABB of every entity with a transform and bounds.
+     * @param registry Registry to read
+     * @param parallel True to transform the bounds on the job system
+     */
+    void Build(Registry& registry, bool parallel = true);
+
+    /**
+     * @brief Gets the number of entities captured.
+     * @return Entity count
+     */
+    size_t GetCount() const { return m_Entities.size(); }
+
+    /**
+     * @brief Checks whether the snapshot holds no entity.
+     * @return True if empty
+     */
+    bool IsEmpty() const { return m_Entities.empty(); }
+
+    /**
+     * @brief Gets the number of Build calls so far; changes whenever the indices may refer to other entities.
+     * @return Build counter
+     */
+    uint64_t GetVersion() const { return m_Version; }
+
+    /**
+     * @brief Gets the captured entities, in view order.
+     * @return Entity of each snapshot index
+     */
+    std::span<const Registry::Entity> GetEntities() const { return m_Entities; }
+
+    /**
+     * @brief Gets the entity at a snapshot index.
+     * @param index Snapshot index
+     * @return The entity
+     */
+    Registry::Entity GetEntity(size_t index) const { return m_Entities[index]; }
+
+    /**
+     * @brief Gets the minimum world coordinates along one axis.
+     * @param axis 0 = X, 1 = Y, 2 = Z
+     * @return GetCount() floats (followed by padding), aligned to kAlignment
+     */
+    const float* GetMin(int axis) const { return m_Min[axis].data(); }
+
+    /**
+     * @brief Gets the maximum world coordinates along one axis.
+     * @param axis 0 = X, 1 = Y, 2 = Z
+     * @return GetCount() floats (followed by padding), aligned to kAlignment
+     */
+    const float* GetMax(int axis) const { return m_Max[axis].data(); }
+
+    /**
+     * @brief Reassembles the world AABB at a snapshot index.
+     * @param index Snapshot index
+     * @return World-space AABB
+     */
+    Aabb GetBounds(size_t index) const
+    {
+        return Aabb(glm::vec3(m_Min[0][index], m_Min[1][index], m_Min[2][index]),
+                    glm::vec3(m_Max[0][index], m_Max[1][index], m_Max[2][index]));
+    }
+
+    /**
+     * @brief Gets the smallest cube around every captured AABB; a unit cube at the origin when empty.
+     * @return Cubic scene bounds
+     */
+    const Aabb& GetSceneBounds() const { return m_SceneBounds; }
+
+    /**
+     * @brief Looks up the snapshot index of an entity.
+     * @param entity Entity to find
+     * @return Its index, or kInvalidIndex if it was not captured
+     */
+    size_t FindIndex(Registry::Entity entity) const;
+
+    /**
+     * @brief Classifies every captured AABB against a frustum, with the same results as
+     *        ClassifyFrustumAabbNaive on the corresponding Aabb.
+     * @param planeNormals The 6 frustum plane normals
+     * @param planeDistances The 6 frustum plane distances
+     * @param out Resized to GetCount(); receives the result of each snapshot index
+     * @param parallel True to split the entities across the job system
+     */
+    void ClassifyFrustum(const glm::vec3 planeNormals[6], const float planeDistances[6],
+                         std::vector<SideResult>& out, bool parallel = true) const;
+
+private:
+    std::vector<Registry::Entity> m_Entities;
+    std::array<FloatArray, 3>     m_Min;
+    std::array<FloatArray, 3>     m_Max;
+    std::vector<uint32_t>         m_IndexOfEntity; // Snapshot index by entity identifier, UINT32_MAX if absent
+
+    Aabb                          m_SceneBounds = Aabb(glm::vec3(0.0f), 1.0f);
+    uint64_t                      m_Version = 0;
+};
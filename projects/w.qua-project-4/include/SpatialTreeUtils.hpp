@@ -4,10 +4,57 @@
 #include "Registry.hpp"
 #include "Components.hpp"
 #include "Geometry.hpp"
+#include "JobSystem.hpp"
+#include <deque>
+#include <limits>
+#include <mutex>
 
 namespace SpatialTreeUtils
 {
 
+    // Node storage of a tree build; every build job allocates from an arena of its own
+    template<typename Node>
+    class NodeArenas
+    {
+    public:
+        std::deque<Node>& Acquire()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            return *m_Arenas.emplace_back(std::make_unique<std::deque<Node>>());
+        }
+
+        void Clear() { m_Arenas.clear(); }
+
+    private:
+        std::vector<std::unique_ptr<std::deque<Node>>> m_Arenas;
+        std::mutex                                     m_Mutex;
+    };
+
+    // Runs fn over [0, count) in grain-sized chunks, on the job system when parallel is set
+    inline void ForEachChunk(bool parallel, size_t count, size_t grainSize, const RangeFunction& fn)
+    {
+        if (parallel && count > grainSize)
+            JobSystem::Get().ParallelFor(count, grainSize, fn);
+        else if (count > 0)
+            fn(0, count);
+    }
+
+    // Smallest cube around [minAll, maxAll]; a unit cube at the origin if the range is empty
+    inline void MakeCubicBounds(const glm::vec3& minAll, const glm::vec3& maxAll, Aabb& outBounds)
+    {
+        // Fallback if no entities
+        if (minAll.x > maxAll.x)
+        {
+            outBounds = Aabb(glm::vec3(0.0f), 1.0f);
+            return;
+        }
+
+        glm::vec3 center = (minAll + maxAll) * 0.5f;
+        glm::vec3 ext    = (maxAll - minAll) * 0.5f;
+        float maxExtent  = glm::compMax(ext);
+        outBounds = Aabb(center - glm::vec3(maxExtent), center + glm::vec3(maxExtent));
+    }
+
     inline void ComputeSceneBounds(Registry& registry, Aabb& outBounds)
     {
         glm::vec3 minAll( 1e30f);
@@ -25,17 +72,41 @@ namespace SpatialTreeUtils
             maxAll = glm::max(maxAll, box.max);
         }
 
-        // Fallback if no entities
-        if (minAll.x > maxAll.x)
-        {
-            outBounds = Aabb(glm::vec3(0.0f), 1.0f);
-            return;
-        }
+        MakeCubicBounds(minAll, maxAll, outBounds);
+    }
 
-        glm::vec3 center = (minAll + maxAll) * 0.5f;
-        glm::vec3 ext    = (maxAll - minAll) * 0.5f;
-        float maxExtent  = glm::compMax(ext);
-        outBounds = Aabb(center - glm::vec3(maxExtent), center + glm::vec3(maxExtent));
+    inline Aabb ComputeWorldAabb(Registry& registry, Registry::Entity entity)
+    {
+        auto& t  = registry.GetComponent<TransformComponent>(entity);
+        auto& bc = registry.GetComponent<BoundingComponent>(entity);
+        Aabb box = bc.GetAABB();
+        box.Transform(t.m_Model);
+        return box;
+    }
+
+    // Inverted box that any Expand call replaces; marks nodes with no content
+    inline Aabb EmptyBounds()
+    {
+        return Aabb(glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest()));
+    }
+
+    inline bool IsEmpty(const Aabb& box)
+    {
+        return box.min.x > box.max.x;
+    }
+
+    inline void Expand(Aabb& bounds, const Aabb& other)
+    {
+        bounds.min = glm::min(bounds.min, other.min);
+        bounds.max = glm::max(bounds.max, other.max);
+    }
+
+    inline SideResult ClassifyFrustumAabb(const glm::vec3 planeNormals[6], const float planeDistances[6], const Aabb& box)
+    {
+        Vertex min, max;
+        min.m_Position = box.min;
+        max.m_Position = box.max;
+        return ClassifyFrustumAabbNaive(planeNormals, planeDistances, min, max);
     }
 
     inline glm::vec3 LevelColor(int level)
@@ -52,14 +52,11 @@ public:
     void Initialize(const std::shared_ptr<Shader>& shader) override;
     
     /**
-     * @brief Renders the sphere with the given transformation matrices.
+     * @brief Renders the sphere with the given model and normal matrices.
      * @param modelMatrix Model transformation matrix
-     * @param viewMatrix View transformation matrix
-     * @param projectionMatrix Projection transformation matrix
+     * @param normalMatrix Normal matrix matching the model matrix
      */
-    void Render(const glm::mat4& modelMatrix, 
-               const glm::mat4& viewMatrix, 
-               const glm::mat4& projectionMatrix) override;
+    void Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix) override;
     
     /**
      * @brief Cleans up OpenGL resources.
@@ -114,17 +111,17 @@ public:
      * @brief Checks if the sphere is rendered in wireframe mode.
      * @return True if wireframe, false if solid
      */
-    bool IsWireframe() const;
+    bool IsWireframe() const override;
+    
+    /**
+     * @brief Creates vertex data for sphere rendering from the current parameters.
+     * @return Vector of vertex data
+     */
+    std::vector<Vertex> CreateVertices();
     
 private:
     glm::vec3 m_Center;
     float m_Radius;
     glm::vec3 m_Color;
     bool m_Wireframe = false;
-
-    /**
-     * @brief Creates vertex data for sphere rendering.
-     * @return Vector of vertex data
-     */
-    std::vector<Vertex> CreateVertices();
 }; 
\ No newline at end of file
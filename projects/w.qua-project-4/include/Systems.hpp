@@ -11,6 +11,7 @@
 #include "pch.h"
 #include "Components.hpp"
 #include "DemoScene.hpp"
+#include "JobSystem.hpp"
 
 // Forward declarations
 class Shader;
@@ -29,12 +30,14 @@ namespace Systems
     extern std::unique_ptr<RenderSystem> g_RenderSystem;
     extern DemoSceneType g_CurrentDemoScene;
     extern std::unique_ptr<PickingSystem> g_PickingSystem;
+    extern size_t g_JobWorkerCount; // Workers started by InitializeSystems; 0 keeps jobs on the main thread
 
     // Type-safe accessors (preferred over using the raw extern pointers)
     inline InputSystem* GetInputSystem()   { return g_InputSystem.get(); }
     inline CameraSystem* GetCameraSystem(){ return g_CameraSystem.get(); }
     inline RenderSystem* GetRenderSystem(){ return g_RenderSystem.get(); }
     inline PickingSystem* GetPickingSystem(){ return g_PickingSystem.get(); }
+    inline JobSystem& GetJobSystem()       { return JobSystem::Get(); }
 
     /**
      * @brief Initializes all engine systems.
@@ -0,0 +1,102 @@
+/**
+ * @class TraceRecorder
+ * @brief Ring buffer of profiled frames that can be saved as a Chrome trace.
+ *
+ * The Profiler hands every recorded frame to the recorder, which keeps the last
+ * few seconds of them. Saving writes the zones, counters and thread names in the
+ * Chrome trace-event JSON format, which chrome://tracing and ui.perfetto.dev
+ * open directly, so a capture taken right after a hitch can be shared and
+ * inspected without running the application.
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Profiler.hpp"
+#include <deque>
+#include <mutex>
+
+class TraceRecorder
+{
+public:
+    /**
+     * @brief Gets the singleton instance of the TraceRecorder.
+     * @return Reference to the TraceRecorder singleton
+     */
+    static TraceRecorder& Get();
+
+    /**
+     * @brief Sets how many seconds of frames the ring buffer keeps.
+     * @param seconds Capture window length
+     */
+    void SetWindowSeconds(double seconds);
+
+    /**
+     * @brief Gets the capture window length.
+     * @return Seconds of frames kept
+     */
+    double GetWindowSeconds() const { return m_WindowSeconds; }
+
+    /**
+     * @brief Appends a frame and drops frames that ended before the capture window.
+     * @param frame Profiled frame
+     */
+    void AddFrame(const ProfileFrame& frame);
+
+    /**
+     * @brief Drops all buffered frames.
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the number of buffered frames.
+     * @return Frame count
+     */
+    size_t GetFrameCount() const;
+
+    /**
+     * @brief Gets the time span covered by the buffered frames.
+     * @return Seconds between the first frame's start and the last frame's end
+     */
+    double GetBufferedSeconds() const;
+
+    /**
+     * @brief Writes the buffered frames to a Chrome trace JSON file.
+     * @param path Output file path
+     * @return True on success
+     */
+    bool Save(const std::string& path) const;
+
+    /**
+     * @brief Saves the buffer to a time-stamped file in the working directory.
+     * @return Path written, or an empty string on failure
+     */
+    std::string SaveTimestamped() const;
+
+    /**
+     * @brief Writes frames as Chrome trace-event JSON.
+     * @param out Output stream
+     * @param frames Frames to write, oldest first
+     * @param threadNames Thread names by thread index
+     */
+    static void WriteChromeTrace(std::ostream& out, const std::deque<ProfileFrame>& frames,
+                                 const std::vector<std::string>& threadNames);
+
+private:
+    TraceRecorder() = default;
+
+    // Delete copy and move constructors/operators
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+    TraceRecorder(TraceRecorder&&) = delete;
+    TraceRecorder& operator=(TraceRecorder&&) = delete;
+
+    /**
+     * @brief Drops frames older than the capture window. Caller holds m_Mutex.
+     */
+    void TrimToWindow();
+
+    mutable std::mutex       m_Mutex;
+    std::deque<ProfileFrame> m_Frames;
+    double                   m_WindowSeconds = 10.0;
+};
@@ -31,8 +31,10 @@ public:
      * @param width Window width in pixels
      * @param height Window height in pixels
      * @param title Window title string
+     * @param headless If true, no GLFW window or GL context is created; the window only
+     *                 provides its size, a clock and a close flag (benchmarking, CI)
      */
-    Window(int width, int height, const std::string& title);
+    Window(int width, int height, const std::string& title, bool headless = false);
     
     /**
      * @brief Destructor that cleans up the window resources.
@@ -58,6 +60,12 @@ public:
      */
     bool ShouldClose() const;
     
+    /**
+     * @brief Checks if the window runs without GLFW and a GL context.
+     * @return True for a headless window
+     */
+    bool IsHeadless() const { return m_Window == nullptr; }
+    
     /**
      * @brief Sets whether the window should close.
      * @param value True to mark window for closing, false otherwise
@@ -172,6 +180,10 @@ private:
     int m_Height;                 
     std::string m_Title;          
 
+    // Headless state, used when no GLFW window exists
+    mutable bool m_HeadlessShouldClose = false;
+    std::chrono::steady_clock::time_point m_StartTime;
+
     // Callback storage
     FramebufferSizeCallback m_FramebufferSizeCallback;
     KeyCallback m_KeyCallback;
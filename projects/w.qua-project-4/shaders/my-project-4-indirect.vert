@@ -0,0 +1,59 @@
+/**
+ * @file my-project-4-indirect.vert
+ * @brief Vertex shader for meshes submitted through glMultiDrawElementsIndirect.
+ *
+ * Identical outputs to my-project-4.vert, but the model matrix and colour come from
+ * a per-draw shader storage buffer indexed by gl_BaseInstance instead of uniforms.
+ */
+
+#version 460 core
+
+// Input vertex attributes
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aNormal;
+layout (location = 3) in vec2 aTexCoord;
+
+// Output to fragment shader
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 Color;
+out vec2 TexCoord;
+
+// Per-draw data, one entry per indirect command
+struct InstanceData
+{
+    mat4   model;
+    mat3x4 normalMatrix;
+    vec4   color;
+};
+
+layout(std430, binding = 2) readonly buffer Instances
+{
+    InstanceData instances[];
+};
+
+// Per-frame camera data, uploaded once by the RenderSystem
+layout(std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 position;
+} camera;
+
+void main()
+{
+    InstanceData instance = instances[gl_BaseInstance + gl_InstanceID];
+    mat4 model = instance.model;
+
+    FragPos = vec3(model * vec4(aPos, 1.0));
+
+    // Calculate normal in world space (excluding translation)
+    Normal = mat3(instance.normalMatrix) * aNormal;
+
+    Color = instance.color.rgb;
+    TexCoord = aTexCoord;
+
+    gl_Position = camera.viewProj * vec4(FragPos, 1.0);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file my-project-4-instanced.vert
+ * @brief Vertex shader for instanced unit primitives (bounding volumes, tree cells).
+ *
+ * Same outputs as my-project-4.vert; each instance supplies its own transform and
+ * colour through per-instance vertex attributes.
+ */
+
+#version 460 core
+
+// Input vertex attributes
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aNormal;
+layout (location = 3) in vec2 aTexCoord;
+
+// Per-instance attributes
+layout (location = 4) in mat4 aInstanceTransform;
+layout (location = 8) in mat3x4 aInstanceNormalMatrix;
+layout (location = 11) in vec4 aInstanceColor;
+
+// Output to fragment shader
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 Color;
+out vec2 TexCoord;
+
+// Per-frame camera data, uploaded once by the RenderSystem
+layout(std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 position;
+} camera;
+
+// Transform applied on top of every instance, with its normal matrix
+uniform mat4 model;
+uniform mat3 normalMatrix;
+
+void main()
+{
+    mat4 instanceModel = model * aInstanceTransform;
+
+    FragPos = vec3(instanceModel * vec4(aPos, 1.0));
+
+    // Calculate normal in world space (excluding translation)
+    Normal = normalMatrix * mat3(aInstanceNormalMatrix) * aNormal;
+
+    Color = aColor * aInstanceColor.rgb;
+    TexCoord = aTexCoord;
+
+    gl_Position = camera.viewProj * vec4(FragPos, 1.0);
+}
@@ -39,9 +39,14 @@ layout(std140) uniform DirectionalLight
     vec3 padding;
 } light;
 
-
-// Uniforms
-uniform vec3 viewPos;
+// Per-frame camera data, uploaded once by the RenderSystem
+layout(std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 position;
+} camera;
 
 vec3 CalcDirLight(vec3 normal, vec3 viewDir);
 
@@ -49,7 +54,7 @@ void main()
 {
     // Properties
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(camera.position.xyz - FragPos);
     
     vec3 result;
     if (light.enabled > 0.5)
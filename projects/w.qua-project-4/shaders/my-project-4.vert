@@ -20,20 +20,28 @@ out vec3 Normal;
 out vec3 Color;
 out vec2 TexCoord;
 
-// Transformation matrices
+// Per-frame camera data, uploaded once by the RenderSystem
+layout(std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 position;
+} camera;
+
+// Per-draw model matrix and its normal matrix (computed on the CPU)
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix;
 
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
     
     // Calculate normal in world space (excluding translation)
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = normalMatrix * aNormal;
     
     Color = aColor;
     TexCoord = aTexCoord;
     
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    gl_Position = camera.viewProj * vec4(FragPos, 1.0);
 } 
\ No newline at end of file
@@ -37,6 +37,11 @@ size_t Buffer::GetVertexCount() const
     return m_vertexCount;
 }
 
+GLuint Buffer::GetVertexArray() const
+{
+    return m_vao;
+}
+
 void Buffer::UpdateVertices(const std::vector<Vertex>& vertices) 
 {
     m_vertexCount = vertices.size();
@@ -46,6 +51,61 @@ void Buffer::UpdateVertices(const std::vector<Vertex>& vertices)
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
 }
 
+void Buffer::SetupInstances(const std::vector<InstanceData>& instances)
+{
+    m_instanceCount = instances.size();
+    
+    if (m_instanceVbo == 0)
+    {
+        glGenBuffers(1, &m_instanceVbo);
+        
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+        
+        // Instance transform (locations 4-7, one column each)
+        for (GLuint column = 0; column < 4; ++column)
+        {
+            glEnableVertexAttribArray(4 + column);
+            glVertexAttribPointer(4 + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                                  (void*)(offsetof(InstanceData, m_Transform) + column * sizeof(glm::vec4)));
+            glVertexAttribDivisor(4 + column, 1);
+        }
+        
+        // Instance normal matrix (locations 8-10, one padded column each)
+        for (GLuint column = 0; column < 3; ++column)
+        {
+            glEnableVertexAttribArray(8 + column);
+            glVertexAttribPointer(8 + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                                  (void*)(offsetof(InstanceData, m_NormalMatrix) + column * sizeof(glm::vec4)));
+            glVertexAttribDivisor(8 + column, 1);
+        }
+        
+        // Instance colour (location = 11)
+        glEnableVertexAttribArray(11);
+        glVertexAttribPointer(11, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, m_Color));
+        glVertexAttribDivisor(11, 1);
+        
+        glBindVertexArray(0);
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    if (instances.size() > m_instanceCapacity)
+    {
+        m_instanceCapacity = instances.size();
+        glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(InstanceData), instances.data(), GL_DYNAMIC_DRAW);
+    }
+    else if (!instances.empty())
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(InstanceData), instances.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+size_t Buffer::GetInstanceCount() const
+{
+    return m_instanceCount;
+}
+
 GLuint Buffer::CreateUniformBuffer(size_t size, GLuint bindingPoint)
 {
     GLuint ubo;
@@ -118,6 +178,13 @@ void Buffer::CleanUp()
         m_vbo = 0;
     }
     
+    if (m_instanceVbo != 0) {
+        glDeleteBuffers(1, &m_instanceVbo);
+        m_instanceVbo = 0;
+    }
+    m_instanceCount = 0;
+    m_instanceCapacity = 0;
+    
     if (m_vao != 0) {
         glDeleteVertexArrays(1, &m_vao);
         m_vao = 0;
@@ -7,8 +7,6 @@
  */
 
 #include "Components.hpp"
-#include "CubeRenderer.hpp"
-#include "SphereRenderer.hpp"
 #include "Geometry.hpp"
 
 void TransformComponent::UpdateModelMatrix()
@@ -20,92 +18,31 @@ void TransformComponent::UpdateModelMatrix()
     m_Model = glm::rotate(m_Model, glm::radians(m_Rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
     m_Model = glm::scale(m_Model, m_Scale);
 
+    // For rotation * scale the inverse transpose is rotation * scale^-1. Column i of the
+    // 3x3 is axis_i * s_i, so dividing it by s_i^2 gives it without a matrix inverse.
+    m_NormalMatrix = glm::mat3(m_Model);
+    for (int i = 0; i < 3; ++i)
+    {
+        m_NormalMatrix[i] /= std::max(m_Scale[i] * m_Scale[i], 1e-12f);
+    }
+
     // Local update; external systems should fire entity-specific events as needed.
 }
 
-void BoundingComponent::InitializeRenderables(const std::shared_ptr<Shader>& shader)
+BoundingComponent::BoundingComponent(const ResourceHandle& resourceHandle)
 {
-    // Using white color for all renderables so frustum culling colors will show properly
-    glm::vec3 neutralColor = glm::vec3(1.0f, 1.0f, 1.0f);
-    
-    // Get AABB (this will compute it if not already computed)
-    const auto& aabb = GetAABB();
-    m_AABBRenderable = std::make_shared<CubeRenderer>(
-        aabb.GetCenter(),
-        aabb.GetExtents() * 2.0f, 
-        neutralColor,
-        true // Wireframe mode
-    );
-    m_AABBRenderable->Initialize(shader);
-    
-    // Get PCA sphere (computed lazily)
-    const auto& pcaSphere = GetPCASphere();
-    m_PCARenderable = std::make_shared<SphereRenderer>(
-        pcaSphere.center, 
-        pcaSphere.radius,
-        neutralColor,
-        true 
-    );
-    m_PCARenderable->Initialize(shader);
-    
-    // Get OBB (computed lazily)
-    const auto& obb = GetOBB();
-    m_OBBRenderable = std::make_shared<CubeRenderer>(
-        obb.center,
-        obb.axes,
-        obb.halfExtents,
-        neutralColor,
-        true // Wireframe mode
-    );
-    m_OBBRenderable->Initialize(shader);
-}
+    if (resourceHandle == INVALID_RESOURCE_HANDLE) return;
 
-void BoundingComponent::CleanupRenderables()
-{
-    m_AABBRenderable.reset();
-    m_PCARenderable.reset();
-    m_OBBRenderable.reset();
-}
-
-void BoundingComponent::ComputeAABB()
-{
-    if (m_AABBComputed || m_MeshHandle == INVALID_RESOURCE_HANDLE) return;
-    
-    const auto& meshResource = ResourceSystem::GetInstance().GetMesh(m_MeshHandle);
+    const auto& meshResource = ResourceSystem::GetInstance().GetMesh(resourceHandle);
     if (!meshResource) return;
-    
-    Vertex min, max;
-    CreateAabbBruteForce(meshResource->GetVertexes().data(), meshResource->GetVertexes().size(), &min, &max);
-    m_AABB = Aabb(min.m_Position, max.m_Position);
-    m_AABBComputed = true;
-}
 
-void BoundingComponent::ComputePCASphere()
-{
-    if (m_PCAComputed || m_MeshHandle == INVALID_RESOURCE_HANDLE) return;
-    
-    const auto& meshResource = ResourceSystem::GetInstance().GetMesh(m_MeshHandle);
-    if (!meshResource) return;
-    
-    Vertex center;
-    float radius;
-    CreateSpherePCA(meshResource->GetVertexes().data(), meshResource->GetVertexes().size(), &center, &radius);
-    m_PCASphere = Sphere(center.m_Position, radius);
-    m_PCAComputed = true;
-}
+    // Meshes are normally post-processed on import; this covers hand-built resources
+    if (!meshResource->HasBounds())
+    {
+        meshResource->ComputeBounds();
+    }
 
-void BoundingComponent::ComputeOBB()
-{
-    if (m_OBBComputed || m_MeshHandle == INVALID_RESOURCE_HANDLE) return;
-    
-    const auto& meshResource = ResourceSystem::GetInstance().GetMesh(m_MeshHandle);
-    if (!meshResource) return;
-    
-    glm::vec3 obbCenter;
-    glm::vec3 obbAxes[3];
-    glm::vec3 obbHalfExtents;
-    CreateObbPCA(meshResource->GetVertexes().data(), meshResource->GetVertexes().size(), 
-                 &obbCenter, obbAxes, &obbHalfExtents);
-    m_OBB = Obb(obbCenter, obbAxes, obbHalfExtents);
-    m_OBBComputed = true;
-} 
\ No newline at end of file
+    m_AABB      = meshResource->GetAABB();
+    m_PCASphere = meshResource->GetPCASphere();
+    m_OBB       = meshResource->GetOBB();
+}
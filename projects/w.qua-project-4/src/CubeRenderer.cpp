@@ -36,44 +36,24 @@ CubeRenderer::~CubeRenderer()
 void CubeRenderer::Initialize(const std::shared_ptr<Shader>& shader)
 {
     m_Shader = shader;
+    m_ModelLocation = m_Shader->GetUniformLocation("model");
+    m_NormalMatrixLocation = m_Shader->GetUniformLocation("normalMatrix");
     
     // Always create solid vertices - wireframe handled by glPolygonMode
     std::vector<Vertex> vertices = CreateVertices();
     m_Buffer.Setup(vertices);
 }
 
-void CubeRenderer::Render(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix)
+void CubeRenderer::Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix)
 {
     if (!m_Shader)
         return;
         
-    m_Shader->Use();
-        
-    m_Shader->SetMat4("model", modelMatrix);
-    m_Shader->SetMat4("view", viewMatrix);
-    m_Shader->SetMat4("projection", projectionMatrix);
-    
-    // Preserve the existing polygon mode so higher-level systems (like the global
-    // wireframe toggle) remain in control after this renderer finishes.
-    GLint prevPolygonMode[2];
-    glGetIntegerv(GL_POLYGON_MODE, prevPolygonMode);
-
-    if (m_Wireframe)
-    {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    }
-
-    // Bind buffer
-    m_Buffer.Bind();
+    m_Shader->SetMat4(m_ModelLocation, modelMatrix);
+    m_Shader->SetMat3(m_NormalMatrixLocation, normalMatrix);
     
     // Always draw as triangles - glPolygonMode handles wireframe conversion
     glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_Buffer.GetVertexCount()));
-    
-    // Unbind
-    m_Buffer.Unbind();
-    
-    // Restore previous polygon mode
-    glPolygonMode(GL_FRONT_AND_BACK, prevPolygonMode[0]);
 }
 
 void CubeRenderer::CleanUp()
@@ -74,18 +74,14 @@ namespace DemoScene
 
     void SetupMeshScene(Registry& registry)
     {
-        auto shader = Systems::g_RenderSystem->GetShader();
-        
         const std::string baseUNCPath = "../projects/w.qua-project-4/models/unc/";
 
         auto loadSectionFromTxts = [&](const std::vector<std::string>& txtFiles, SectionId secId)
         {
             const float targetExtent = 0.5f; 
 
-            // First pass: load each mesh once, cache handle and compute largest extent
-            float maxExtent = 0.0f;
-            struct MeshInfo { std::string path; ResourceHandle handle; glm::vec3 centre; glm::vec3 extents; };
-            std::vector<MeshInfo> meshes;
+            // Gather every mesh path of the section so they can be loaded as one batch
+            std::vector<std::string> paths;
             for (const auto& txt : txtFiles)
             {
                 std::ifstream fin(baseUNCPath + txt);
@@ -98,16 +94,26 @@ namespace DemoScene
                 while (std::getline(fin, relPath))
                 {
                     if (relPath.empty()) continue;
-                    std::string fullPath = baseUNCPath + relPath;
-                    ResourceHandle meshHandle = ResourceSystem::GetInstance().LoadMesh(fullPath);
+                    paths.push_back(baseUNCPath + relPath);
+                }
+            }
 
-                    BoundingComponent tmpBC(meshHandle);
-                    const Aabb& aabb = tmpBC.GetAABB();
-                    float ext = glm::compMax(aabb.GetExtents());
-                    maxExtent = std::max(maxExtent, ext);
+            // First pass: load each mesh once (bounds are precomputed on the resource) and find largest extent
+            std::vector<ResourceHandle> handles = ResourceSystem::GetInstance().LoadMeshes(paths);
 
-                    meshes.push_back({fullPath, meshHandle, aabb.GetCenter(), aabb.GetExtents()});
-                }
+            float maxExtent = 0.0f;
+            struct MeshInfo { std::string path; ResourceHandle handle; glm::vec3 centre; glm::vec3 extents; };
+            std::vector<MeshInfo> meshes;
+            for (size_t i = 0; i < paths.size(); ++i)
+            {
+                auto mesh = ResourceSystem::GetInstance().GetMesh(handles[i]);
+                if (!mesh) continue;
+
+                const Aabb& aabb = mesh->GetAABB();
+                float ext = glm::compMax(aabb.GetExtents());
+                maxExtent = std::max(maxExtent, ext);
+
+                meshes.push_back({paths[i], handles[i], aabb.GetCenter(), aabb.GetExtents()});
             }
 
             if (maxExtent <= 0.0f) maxExtent = 1.0f;
@@ -125,11 +131,8 @@ namespace DemoScene
                 auto e = registry.Create();
                 registry.AddComponent<TransformComponent>(e, TransformComponent(finalPos, glm::vec3(0.0f), finalScale));
 
-                auto meshRenderer = std::make_shared<MeshRenderer>(meshHandle, glm::vec3(0.0f,1.0f,0.0f));
-                BoundingComponent bc(meshHandle);
-                bc.InitializeRenderables(shader);
-
-                registry.AddComponent<BoundingComponent>(e, bc);
+                auto meshRenderer = Systems::g_RenderSystem->CreateMeshRenderable(meshHandle, glm::vec3(0.0f,1.0f,0.0f));
+                registry.AddComponent<BoundingComponent>(e, BoundingComponent(meshHandle));
 
                 // Remember baseScale for future global scaling updates
                 s_EntityBaseScale[e] = baseScale;
@@ -178,10 +181,7 @@ namespace DemoScene
         //            TransformComponent(finalPos, glm::vec3(0.0f), glm::vec3(scale)));
         //        
         //        auto meshRenderer = std::make_shared<MeshRenderer>(meshHandle, glm::vec3(0.0f, 1.0f, 0.0f));
-        //        BoundingComponent bc(meshHandle);
-        //        bc.InitializeRenderables(shader);
-        //        
-        //        registry.AddComponent<BoundingComponent>(entity, bc);
+        //        registry.AddComponent<BoundingComponent>(entity, BoundingComponent(meshHandle));
         //        registry.AddComponent<RenderComponent>(entity, RenderComponent(meshRenderer));
         //        
         //        s_SectionEntities[static_cast<int>(SectionId::Section5)].push_back(entity);
@@ -205,7 +205,7 @@ namespace DemoScene
                 // Keep baked positions => translation remains zero
                 t.m_Position = glm::vec3(0.0f);
                 t.UpdateModelMatrix();
-                EventSystem::Get().FireEvent(EventType::TransformChanged, entity);
+                registry.MarkChanged<TransformComponent>(entity);
             }
         }
     }
@@ -2,6 +2,74 @@
 #include "EventSystem.hpp"
 #include "Registry.hpp"
 #include "Window.hpp"
+#include "Profiler.hpp"
+#include <cassert>
+
+namespace
+{
+    /**
+     * @brief Calls visitor with std::type_identity of the typed event behind an EventType.
+     * @return False if the type has no typed event
+     */
+    template<typename Visitor>
+    bool VisitEventType(EventType eventType, Visitor&& visitor)
+    {
+        switch (eventType)
+        {
+        case EventType::KeyPress:           visitor(std::type_identity<KeyPressEvent>{});           return true;
+        case EventType::KeyRelease:         visitor(std::type_identity<KeyReleaseEvent>{});         return true;
+        case EventType::MouseButtonPress:   visitor(std::type_identity<MouseButtonPressEvent>{});   return true;
+        case EventType::MouseButtonRelease: visitor(std::type_identity<MouseButtonReleaseEvent>{}); return true;
+        case EventType::MouseMove:          visitor(std::type_identity<MouseMoveEvent>{});          return true;
+        case EventType::MouseScroll:        visitor(std::type_identity<MouseScrollEvent>{});        return true;
+        case EventType::TransformChanged:   visitor(std::type_identity<TransformChangedEvent>{});   return true;
+        case EventType::SceneReset:         visitor(std::type_identity<SceneResetEvent>{});         return true;
+        default:                            return false;
+        }
+    }
+
+    // Typed event -> EventData for subscribers registered through SubscribeToEvent
+    EventData ToEventData(const KeyPressEvent& event)           { return event.m_Key; }
+    EventData ToEventData(const KeyReleaseEvent& event)         { return event.m_Key; }
+    EventData ToEventData(const MouseButtonPressEvent& event)   { return event.m_Button; }
+    EventData ToEventData(const MouseButtonReleaseEvent& event) { return event.m_Button; }
+    EventData ToEventData(const MouseMoveEvent& event)          { return event.m_Position; }
+    EventData ToEventData(const MouseScrollEvent& event)        { return event.m_Offset; }
+    EventData ToEventData(const TransformChangedEvent& event)   { return event.m_Entity; }
+    EventData ToEventData(const SceneResetEvent&)               { return std::monostate(); }
+
+    /**
+     * @brief Copies the payload a typed event expects out of EventData.
+     * @return False if the data holds a different alternative
+     */
+    template<typename Payload, typename Member>
+    bool ReadPayload(const EventData& data, Member& out)
+    {
+        if (auto value = std::get_if<Payload>(&data))
+        {
+            out = *value;
+            return true;
+        }
+        return false;
+    }
+
+    bool FromEventData(const EventData& data, KeyPressEvent& event)           { return ReadPayload<int>(data, event.m_Key); }
+    bool FromEventData(const EventData& data, KeyReleaseEvent& event)         { return ReadPayload<int>(data, event.m_Key); }
+    bool FromEventData(const EventData& data, MouseButtonPressEvent& event)   { return ReadPayload<int>(data, event.m_Button); }
+    bool FromEventData(const EventData& data, MouseButtonReleaseEvent& event) { return ReadPayload<int>(data, event.m_Button); }
+    bool FromEventData(const EventData& data, MouseMoveEvent& event)          { return ReadPayload<glm::vec2>(data, event.m_Position); }
+    bool FromEventData(const EventData& data, MouseScrollEvent& event)        { return ReadPayload<glm::vec2>(data, event.m_Offset); }
+    bool FromEventData(const EventData& data, TransformChangedEvent& event)   { return ReadPayload<entt::entity>(data, event.m_Entity); }
+    bool FromEventData(const EventData&, SceneResetEvent&)                    { return true; }
+
+    // Subscribers used to receive the raw variant and could ignore a wrong payload; now it is
+    // never delivered, so a caller passing the wrong type should notice in debug builds
+    void ReportPayloadMismatch(EventType eventType)
+    {
+        std::cerr << "EventSystem: unexpected data for event type " << static_cast<int>(eventType) << std::endl;
+        assert(false && "EventData payload does not match the event type");
+    }
+}
 
 // Static singleton instance
 static EventSystem* s_Instance = nullptr;
@@ -25,6 +93,12 @@ EventSystem::~EventSystem()
     Shutdown();
 }
 
+size_t EventSystem::NextChannelIndex()
+{
+    static size_t s_NextIndex = 0;
+    return s_NextIndex++;
+}
+
 void EventSystem::Initialize()
 {
     if (m_Initialized) 
@@ -32,8 +106,11 @@ void EventSystem::Initialize()
         return;
     }
     
-    // Clear any existing event subscriptions
-    ClearAllEventSubscriptions();
+    // Drop any existing subscriptions, queues and dispatch modes
+    m_Channels.clear();
+    m_LegacySubscribers.clear();
+    m_PendingStats = EventQueueStats();
+    m_LastFlushStats = EventQueueStats();
     
     m_Initialized = true;
 }
@@ -45,51 +122,123 @@ void EventSystem::Shutdown()
         return;
     }
     
-    // Clear all event subscriptions
-    ClearAllEventSubscriptions();
+    // Queued events are dropped undelivered
+    m_Channels.clear();
+    m_LegacySubscribers.clear();
     
     m_Initialized = false;
 }
 
 void EventSystem::SubscribeToEvent(const EventType eventType, EventFunction&& eventFunction)
 {
-    m_EventMap[eventType].push_back(eventFunction);
+    // The std::function is too large for a delegate; the delegate captures its address
+    std::deque<EventFunction>& callbacks = m_LegacySubscribers[eventType];
+    const EventFunction* callback = &callbacks.emplace_back(std::move(eventFunction));
+    
+    bool known = VisitEventType(eventType, [this, callback](auto tag) {
+        using Event = typename decltype(tag)::type;
+        Subscribe<Event>([callback](const Event& event) { (*callback)(ToEventData(event)); });
+    });
+    
+    if (!known)
+    {
+        callbacks.pop_back();
+        std::cerr << "EventSystem: cannot subscribe to event type " << static_cast<int>(eventType) << std::endl;
+    }
 }
 
 void EventSystem::FireEvent(const EventType eventType, EventData eventData)
 {
-    // Check if the event type exists in the map
-    auto it = m_EventMap.find(eventType);
-    if (it == m_EventMap.end()) 
+    VisitEventType(eventType, [this, eventType, &eventData](auto tag) {
+        using Event = typename decltype(tag)::type;
+        Event event{};
+        if (FromEventData(eventData, event))
+            Publish(event);
+        else
+            ReportPayloadMismatch(eventType);
+    });
+}
+
+void EventSystem::QueueEvent(const EventType eventType, EventData eventData)
+{
+    VisitEventType(eventType, [this, eventType, &eventData](auto tag) {
+        using Event = typename decltype(tag)::type;
+        Event event{};
+        if (FromEventData(eventData, event))
+            Queue(event);
+        else
+            ReportPayloadMismatch(eventType);
+    });
+}
+
+void EventSystem::SetDispatchMode(EventType eventType, EventDispatchMode mode, EventCoalescing coalescing)
+{
+    VisitEventType(eventType, [this, mode, coalescing](auto tag) {
+        SetDispatchMode<typename decltype(tag)::type>(mode, coalescing);
+    });
+}
+
+EventDispatchMode EventSystem::GetDispatchMode(EventType eventType) const
+{
+    const IEventChannel* channel = FindChannel(eventType);
+    return channel ? channel->GetDispatchMode() : EventDispatchMode::Immediate;
+}
+
+void EventSystem::FlushEvents()
+{
+    PROFILE_SCOPE("EventSystem::FlushEvents");
+    EventQueueStats stats = m_PendingStats;
+    m_PendingStats = EventQueueStats();
+    
+    // Indexed: a subscriber may create channels while we flush
+    for (size_t i = 0; i < m_Channels.size(); ++i)
     {
-        return; // No subscribers for this event type
+        if (m_Channels[i])
+            m_Channels[i]->Flush(stats);
     }
     
-    const auto& subscribers = it->second;
-    for (const auto& subscriber : subscribers) {
-        subscriber(eventData);
-    }
+    m_LastFlushStats = stats;
+    PROFILE_COUNTER("Events Dispatched", stats.m_Dispatched);
+    PROFILE_COUNTER("Events Coalesced", stats.m_Coalesced);
+}
+
+size_t EventSystem::GetQueuedEventCount(EventType eventType) const
+{
+    const IEventChannel* channel = FindChannel(eventType);
+    return channel ? channel->GetQueuedCount() : 0;
 }
 
 size_t EventSystem::GetObserverCount(EventType eventType) const
 {
-    auto it = m_EventMap.find(eventType);
-    if (it == m_EventMap.end()) {
-        return 0;
-    }
-    
-    return it->second.size();
+    const IEventChannel* channel = FindChannel(eventType);
+    return channel ? channel->GetSubscriberCount() : 0;
 }
 
 void EventSystem::ClearEventSubscriptions(EventType eventType)
 {
-    auto it = m_EventMap.find(eventType);
-    if (it != m_EventMap.end()) {
-        it->second.clear();
+    if (IEventChannel* channel = FindChannel(eventType))
+    {
+        channel->ClearSubscribers();
     }
+    // Only the cleared channel's delegates pointed at these
+    m_LegacySubscribers.erase(eventType);
 }
 
 void EventSystem::ClearAllEventSubscriptions()
 {
-    m_EventMap.clear();
-} 
\ No newline at end of file
+    for (auto& channel : m_Channels)
+    {
+        if (channel)
+            channel->ClearSubscribers();
+    }
+    m_LegacySubscribers.clear();
+}
+
+IEventChannel* EventSystem::FindChannel(EventType eventType) const
+{
+    IEventChannel* found = nullptr;
+    VisitEventType(eventType, [this, &found](auto tag) {
+        found = FindChannel<typename decltype(tag)::type>();
+    });
+    return found;
+}
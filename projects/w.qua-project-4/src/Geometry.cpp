@@ -1,5 +1,7 @@
 #include "Geometry.hpp"
+#include "JobSystem.hpp"
 #include <Eigen/Dense>
+#include <array>
 
 constexpr float kEpsilon = 1e-5f; // Custom epsilon for floating-point comparisons
 
@@ -151,6 +153,11 @@ void TransformAabb(glm::vec3& min, glm::vec3& max, glm::mat4 const& transform)
     max = newMax;
 }
 
+glm::mat3 ComputeNormalMatrix(glm::mat4 const& model)
+{
+    return glm::transpose(glm::inverse(glm::mat3(model)));
+}
+
 void FrustumFromVp(glm::mat4 const& vp, glm::vec3 fn[6], float fd[6])
 {
     // Extract frustum planes from view-projection matrix
@@ -214,67 +221,213 @@ void CreateAabbBruteForce(Vertex const* vertices, size_t count, Vertex* out_min,
 }
 
 
-void CreateSpherePCA(Vertex const* vertices, size_t count, Vertex* out_c, float* out_r)
+namespace
 {
-    if (count == 0 || !vertices || !out_c || !out_r) return;
-    
-    // Create Eigen matrix from vertex data
-    Eigen::MatrixXf pointMatrix(count, 3);
-    for (size_t i = 0; i < count; ++i) {
-        pointMatrix(i, 0) = vertices[i].m_Position.x;
-        pointMatrix(i, 1) = vertices[i].m_Position.y;
-        pointMatrix(i, 2) = vertices[i].m_Position.z;
+    // Meshes below this many vertices are reduced on the calling thread
+    constexpr size_t kParallelVertexThreshold = 1 << 16;
+    constexpr size_t kMaxReductionChunks = 8;
+
+    /**
+     * @brief Running mean and co-moment matrix (Welford), mergeable across chunks.
+     *        M2 is stored as the upper triangle xx, xy, xz, yy, yz, zz.
+     */
+    struct CovarianceAccumulator
+    {
+        double    n = 0.0;
+        glm::dvec3 mean = glm::dvec3(0.0);
+        double    m2[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+        void Add(const glm::vec3& p)
+        {
+            n += 1.0;
+            glm::dvec3 delta = glm::dvec3(p) - mean;
+            mean += delta / n;
+            glm::dvec3 delta2 = glm::dvec3(p) - mean;
+
+            m2[0] += delta.x * delta2.x;
+            m2[1] += delta.x * delta2.y;
+            m2[2] += delta.x * delta2.z;
+            m2[3] += delta.y * delta2.y;
+            m2[4] += delta.y * delta2.z;
+            m2[5] += delta.z * delta2.z;
+        }
+
+        void Merge(const CovarianceAccumulator& other)
+        {
+            if (other.n == 0.0) return;
+            if (n == 0.0) { *this = other; return; }
+
+            double total = n + other.n;
+            glm::dvec3 delta = other.mean - mean;
+            double weight = n * other.n / total;
+
+            m2[0] += other.m2[0] + delta.x * delta.x * weight;
+            m2[1] += other.m2[1] + delta.x * delta.y * weight;
+            m2[2] += other.m2[2] + delta.x * delta.z * weight;
+            m2[3] += other.m2[3] + delta.y * delta.y * weight;
+            m2[4] += other.m2[4] + delta.y * delta.z * weight;
+            m2[5] += other.m2[5] + delta.z * delta.z * weight;
+
+            mean += delta * (other.n / total);
+            n = total;
+        }
+    };
+
+    /**
+     * @brief Min / max of positions projected onto a fixed orthonormal frame.
+     */
+    struct ProjectedExtents
+    {
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+        void Merge(const ProjectedExtents& other)
+        {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+    };
+
+    /**
+     * @brief Runs chunkFn over contiguous ranges of [0, count) and folds the results.
+     *        Large inputs are split into one chunk per job system thread; partial
+     *        results live on the stack so no per-call buffers are allocated, and
+     *        are merged in chunk order whichever thread produced them.
+     */
+    template <typename Result, typename ChunkFn>
+    Result ParallelReduce(size_t count, ChunkFn chunkFn)
+    {
+        JobSystem& jobs = JobSystem::Get();
+
+        size_t chunkCount = 1;
+        if (count >= kParallelVertexThreshold)
+        {
+            chunkCount = std::clamp<size_t>(jobs.GetThreadCount(), 1, kMaxReductionChunks);
+        }
+
+        if (chunkCount == 1)
+        {
+            return chunkFn(size_t(0), count);
+        }
+
+        std::array<Result, kMaxReductionChunks> partials{};
+        const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+        jobs.ParallelFor(chunkCount, 1, [&](size_t firstChunk, size_t lastChunk)
+        {
+            for (size_t c = firstChunk; c < lastChunk; ++c)
+            {
+                size_t begin = std::min(count, c * chunkSize);
+                size_t end   = std::min(count, begin + chunkSize);
+                partials[c] = chunkFn(begin, end);
+            }
+        });
+
+        Result result = partials[0];
+        for (size_t c = 1; c < chunkCount; ++c)
+        {
+            result.Merge(partials[c]);
+        }
+        return result;
     }
-    
-    // Step 1: Compute Centroid
-    Eigen::Vector3f centroid = pointMatrix.colwise().mean();
-    
-    // Step 2: Center the data
-    Eigen::MatrixXf centered = pointMatrix.rowwise() - centroid.transpose();
-    
-    // Step 3: Compute Covariance Matrix
-    Eigen::Matrix3f covariance = (centered.adjoint() * centered) / float(count);
-    
-    // Step 4: Eigen Decomposition
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> eigensolver(covariance);
-    Eigen::Vector3f eigenvalues = eigensolver.eigenvalues();
-    Eigen::Matrix3f eigenvectors = eigensolver.eigenvectors();
-    
-    // Step 5: Radius Estimation
-    // Find the extents along each principal axis
-    Eigen::Vector3f minExtents = Eigen::Vector3f::Constant(std::numeric_limits<float>::max());
-    Eigen::Vector3f maxExtents = Eigen::Vector3f::Constant(-std::numeric_limits<float>::max());
-    
-    for (size_t i = 0; i < count; ++i) {
-        // Project centered point onto each eigenvector (principal axis)
-        Eigen::Vector3f point;
-        point << centered(i, 0), centered(i, 1), centered(i, 2);
-        Eigen::Vector3f projections = eigenvectors.transpose() * point;
-        
-        minExtents = minExtents.cwiseMin(projections);
-        maxExtents = maxExtents.cwiseMax(projections);
+
+    /**
+     * @brief Single streaming pass computing centroid and principal axes of the positions.
+     * @param vertices Array of vertices to process
+     * @param count Number of vertices
+     * @param out_centroid Output mean position
+     * @param out_axes Output eigenvectors of the covariance matrix (columns, ascending eigenvalue)
+     */
+    void ComputePrincipalFrame(Vertex const* vertices, size_t count, glm::vec3* out_centroid, glm::mat3* out_axes)
+    {
+        CovarianceAccumulator acc = ParallelReduce<CovarianceAccumulator>(count,
+            [vertices](size_t begin, size_t end)
+            {
+                CovarianceAccumulator local;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    local.Add(vertices[i].m_Position);
+                }
+                return local;
+            });
+
+        // Population covariance, as in the original batched implementation
+        Eigen::Matrix3f covariance;
+        const double invN = 1.0 / acc.n;
+        covariance << float(acc.m2[0] * invN), float(acc.m2[1] * invN), float(acc.m2[2] * invN),
+                      float(acc.m2[1] * invN), float(acc.m2[3] * invN), float(acc.m2[4] * invN),
+                      float(acc.m2[2] * invN), float(acc.m2[4] * invN), float(acc.m2[5] * invN);
+
+        // Fixed-size 3x3 solve: no dynamic allocation
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> solver(covariance);
+        const Eigen::Matrix3f& eigenVectors = solver.eigenvectors();
+
+        for (int c = 0; c < 3; ++c)
+        {
+            (*out_axes)[c] = glm::normalize(glm::vec3(eigenVectors(0, c), eigenVectors(1, c), eigenVectors(2, c)));
+        }
+        *out_centroid = glm::vec3(acc.mean);
     }
+
+    /**
+     * @brief Projects every position (relative to origin) onto the given frame and tracks extents.
+     */
+    ProjectedExtents ComputeProjectedExtents(Vertex const* vertices, size_t count, const glm::vec3& origin, const glm::mat3& axes)
+    {
+        const glm::mat3 toFrame = glm::transpose(axes);
+        return ParallelReduce<ProjectedExtents>(count,
+            [&](size_t begin, size_t end)
+            {
+                ProjectedExtents local;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    glm::vec3 projected = toFrame * (vertices[i].m_Position - origin);
+                    local.min = glm::min(local.min, projected);
+                    local.max = glm::max(local.max, projected);
+                }
+                return local;
+            });
+    }
+}
+
+void CreateSpherePCA(Vertex const* vertices, size_t count, Vertex* out_c, float* out_r)
+{
+    if (count == 0 || !vertices || !out_c || !out_r) return;
     
-    // Calculate the optimal sphere center in principal component space
-    Eigen::Vector3f centerInPCA = (minExtents + maxExtents) * 0.5f;
+    // Step 1: Centroid and principal axes in a single streaming pass
+    glm::vec3 centroid;
+    glm::mat3 axes;
+    ComputePrincipalFrame(vertices, count, &centroid, &axes);
     
-    // Transform back to world space
-    Eigen::Vector3f optimalCenter = centroid + eigenvectors * centerInPCA;
+    // Step 2: Extents along each principal axis
+    ProjectedExtents extents = ComputeProjectedExtents(vertices, count, centroid, axes);
     
-    // Calculate radius - farthest point defines the radius
-    float radius = 0.0f;
-    for (size_t i = 0; i < count; ++i) {
-        Eigen::Vector3f pos;
-        pos << vertices[i].m_Position.x, vertices[i].m_Position.y, vertices[i].m_Position.z;
-        float distance = (pos - optimalCenter).norm();
-        radius = std::max(radius, distance);
-    }
+    // Sphere center is the middle of the PCA-space extents, transformed back to world space
+    glm::vec3 optimalCenter = centroid + axes * ((extents.min + extents.max) * 0.5f);
     
-    out_c->m_Position = glm::vec3(optimalCenter(0), optimalCenter(1), optimalCenter(2));
+    // Step 3: Radius - farthest point from the center (squared distances, one sqrt)
+    struct MaxDistance
+    {
+        float distanceSq = 0.0f;
+        void Merge(const MaxDistance& other) { distanceSq = std::max(distanceSq, other.distanceSq); }
+    };
+    MaxDistance farthest = ParallelReduce<MaxDistance>(count,
+        [&](size_t begin, size_t end)
+        {
+            MaxDistance local;
+            for (size_t i = begin; i < end; ++i)
+            {
+                glm::vec3 d = vertices[i].m_Position - optimalCenter;
+                local.distanceSq = std::max(local.distanceSq, glm::dot(d, d));
+            }
+            return local;
+        });
+    
+    out_c->m_Position = optimalCenter;
     out_c->m_Color = vertices[0].m_Color;
     out_c->m_Normal = vertices[0].m_Normal;
     out_c->m_UV = vertices[0].m_UV;
-    *out_r = radius;
+    *out_r = std::sqrt(farthest.distanceSq);
 }
 
 
@@ -283,51 +436,24 @@ void CreateObbPCA(Vertex const* vertices, size_t count, glm::vec3* out_center, g
 {
     if (count == 0 || !vertices || !out_center || !out_axes || !out_halfExtents) return;
     
-    // Step 1: Convert vertices to a matrix for computation
-    Eigen::MatrixXf points(count, 3);
-    for (size_t i = 0; i < count; ++i) {
-        points(i, 0) = vertices[i].m_Position.x;
-        points(i, 1) = vertices[i].m_Position.y;
-        points(i, 2) = vertices[i].m_Position.z;
-    }
-    
-    // Step 2: Compute the centroid (mean position)
-    Eigen::Vector3f centroid = points.colwise().mean();
-    
-    // Step 3: Center the data by subtracting the centroid
-    Eigen::MatrixXf centered = points.rowwise() - centroid.transpose();
+    // Step 1: Centroid and principal axes in a single streaming pass
+    glm::vec3 centroid;
+    glm::mat3 axes;
+    ComputePrincipalFrame(vertices, count, &centroid, &axes);
     
-    // Step 4: Compute the covariance matrix
-    Eigen::Matrix3f covariance = (centered.adjoint() * centered) / float(count);
-    
-    // Step 5: Compute eigenvalues and eigenvectors of the covariance matrix
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> solver(covariance);
-    
-    Eigen::Matrix3f eigenVectors = solver.eigenvectors();
-        
-    // Step 6: Set OBB axes (principal directions)
     for (int i = 0; i < 3; ++i) 
     {
-        Eigen::Vector3f axis = eigenVectors.col(i);
-        out_axes[i] = glm::normalize(glm::vec3(axis(0), axis(1), axis(2)));
+        out_axes[i] = axes[i];
     }
-        
-    // Step 7: Rotate points into the PCA-aligned frame
-    Eigen::MatrixXf rotated = centered * eigenVectors;
-        
-    // Step 8: Compute extents in the PCA-aligned space
-    Eigen::Vector3f minExtents = rotated.colwise().minCoeff();
-    Eigen::Vector3f maxExtents = rotated.colwise().maxCoeff();
-    Eigen::Vector3f halfExtents = (maxExtents - minExtents) * 0.5f;
-        
-    // Step 9: Set half-extents
-    *out_halfExtents = glm::vec3(halfExtents(0), halfExtents(1), halfExtents(2));
-        
-    // Step 10: Compute OBB center in world space
-    Eigen::Vector3f centerOffset = eigenVectors * (minExtents + halfExtents);
-    Eigen::Vector3f obbCenter = centroid + centerOffset;
-    *out_center = glm::vec3(obbCenter(0), obbCenter(1), obbCenter(2));
     
+    // Step 2: Extents in the PCA-aligned frame
+    ProjectedExtents extents = ComputeProjectedExtents(vertices, count, centroid, axes);
+    glm::vec3 halfExtents = (extents.max - extents.min) * 0.5f;
+    
+    *out_halfExtents = halfExtents;
+    
+    // Step 3: OBB center in world space
+    *out_center = centroid + axes * (extents.min + halfExtents);
 }
 
 
@@ -0,0 +1,143 @@
+/**
+ * @file GpuTimer.cpp
+ * @brief Implementation of the per-pass GPU timer.
+ */
+
+#include "GpuTimer.hpp"
+#include "Profiler.hpp"
+#include <cstring>
+
+namespace
+{
+    // Weight of a new result in the moving average; about a 10 frame time constant
+    constexpr double kAverageWeight = 0.1;
+}
+
+void GpuTimer::Initialize(bool hasContext)
+{
+    m_Available = hasContext && (GLEW_VERSION_3_3 || GLEW_ARB_timer_query);
+    if (hasContext && !m_Available)
+    {
+        std::cerr << "GpuTimer: timer queries are not supported; GPU pass timings disabled" << std::endl;
+    }
+}
+
+void GpuTimer::Shutdown()
+{
+    if (m_OpenPass != kNoPass)
+    {
+        EndPass();
+    }
+
+    if (m_Available)
+    {
+        for (Pass& pass : m_Passes)
+        {
+            glDeleteQueries(static_cast<GLsizei>(kFrameLatency), pass.m_Queries.data());
+        }
+    }
+
+    m_Passes.clear();
+    m_Available = false;
+}
+
+void GpuTimer::BeginFrame()
+{
+    if (!m_Available)
+        return;
+
+    m_Slot = (m_Slot + 1) % kFrameLatency;
+    ++m_Frame;
+
+    for (Pass& pass : m_Passes)
+    {
+        if (!pass.m_Pending[m_Slot])
+            continue;
+        pass.m_Pending[m_Slot] = false;
+
+        // Issued kFrameLatency frames ago; if the GPU is still behind, drop it instead of waiting
+        GLuint query = pass.m_Queries[m_Slot];
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            ++m_DroppedResults;
+            continue;
+        }
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+
+        pass.m_LastMs    = static_cast<double>(elapsedNs) * 1e-6;
+        // A pass that was hidden for a while restarts its average rather than blending in old times
+        pass.m_AverageMs = IsCurrent(pass) ? pass.m_AverageMs + (pass.m_LastMs - pass.m_AverageMs) * kAverageWeight
+                                           : pass.m_LastMs;
+        pass.m_ResultFrame = m_Frame;
+        pass.m_HasResult = true;
+    }
+
+    // Every frame, not only when a result arrived, so the trace shows stale passes dropping out
+    if (!m_Passes.empty())
+    {
+        PROFILE_COUNTER("GPU ms", GetTotalMs());
+    }
+}
+
+bool GpuTimer::BeginPass(const char* name)
+{
+    if (!m_Available || !m_Enabled || m_OpenPass != kNoPass)
+        return false;
+
+    Pass& pass = FindOrCreatePass(name);
+    glBeginQuery(GL_TIME_ELAPSED, pass.m_Queries[m_Slot]);
+    m_OpenPass = static_cast<size_t>(&pass - m_Passes.data());
+    return true;
+}
+
+void GpuTimer::EndPass()
+{
+    if (m_OpenPass == kNoPass)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    m_Passes[m_OpenPass].m_Pending[m_Slot] = true;
+    m_OpenPass = kNoPass;
+}
+
+std::vector<GpuPassTiming> GpuTimer::GetTimings() const
+{
+    std::vector<GpuPassTiming> timings;
+    timings.reserve(m_Passes.size());
+    for (const Pass& pass : m_Passes)
+    {
+        if (IsCurrent(pass))
+            timings.push_back({ pass.m_Name, pass.m_LastMs, pass.m_AverageMs });
+    }
+    return timings;
+}
+
+double GpuTimer::GetTotalMs() const
+{
+    double total = 0.0;
+    for (const Pass& pass : m_Passes)
+    {
+        if (IsCurrent(pass))
+            total += pass.m_LastMs;
+    }
+    return total;
+}
+
+GpuTimer::Pass& GpuTimer::FindOrCreatePass(const char* name)
+{
+    // A handful of passes, compared by content so equal names from different literals match
+    for (Pass& pass : m_Passes)
+    {
+        if (std::strcmp(pass.m_Name, name) == 0)
+            return pass;
+    }
+
+    Pass& pass = m_Passes.emplace_back();
+    pass.m_Name = name;
+    glGenQueries(static_cast<GLsizei>(kFrameLatency), pass.m_Queries.data());
+    return pass;
+}
@@ -19,6 +19,8 @@
 #include "Keybinds.hpp"
 #include "Octree.hpp" 
 #include "KDTree.hpp"
+#include "Profiler.hpp"
+#include "TraceRecorder.hpp"
 
 ImGuiManager::ImGuiManager(Window& window)
     : m_Window(window)
@@ -146,6 +148,17 @@ void ImGuiManager::RenderMainWindow(Registry& registry)
     RenderAssignment4Controls(registry);
     ImGui::End();
 
+    ImGui::Begin("Profiler");
+    RenderProfilerWindow();
+    ImGui::End();
+
+    // Walks both trees, so skip it while the window is collapsed
+    if (ImGui::Begin("Spatial Statistics"))
+    {
+        RenderSpatialStatsWindow();
+    }
+    ImGui::End();
+
     // (BVH UI removed)
 }
 
@@ -269,6 +282,33 @@ void ImGuiManager::RenderWireframeControls(Registry& registry)
     {
         Systems::g_RenderSystem->SetGlobalWireframe(wireframeEnabled);
     }
+
+    bool indirectEnabled = Systems::g_RenderSystem->IsIndirectDrawEnabled();
+    if (ImGui::Checkbox("Multi-Draw Indirect", &indirectEnabled))
+    {
+        Systems::g_RenderSystem->SetIndirectDrawEnabled(indirectEnabled);
+    }
+
+    bool cullingEnabled = Systems::g_RenderSystem->IsFrustumCullingEnabled();
+    if (ImGui::Checkbox("Frustum Culling", &cullingEnabled))
+    {
+        Systems::g_RenderSystem->EnableFrustumCulling(cullingEnabled);
+    }
+
+    bool lodEnabled = Systems::g_RenderSystem->IsLODEnabled();
+    if (ImGui::Checkbox("Level of Detail", &lodEnabled))
+    {
+        Systems::g_RenderSystem->SetLODEnabled(lodEnabled);
+    }
+
+    if (lodEnabled)
+    {
+        float lodThreshold = Systems::g_RenderSystem->GetLODPixelThreshold();
+        if (ImGui::SliderFloat("LOD Threshold (px)", &lodThreshold, 32.0f, 1024.0f, "%.0f"))
+        {
+            Systems::g_RenderSystem->SetLODPixelThreshold(lodThreshold);
+        }
+    }
 }
 
 void ImGuiManager::RenderObjectVisibilityControls(Registry& registry)
@@ -303,6 +343,19 @@ void ImGuiManager::RenderStats()
     
     ImGui::Separator();
     
+    if (Systems::g_RenderSystem)
+    {
+        ImGui::Text("Entities Submitted: %zu", Systems::g_RenderSystem->GetLastFrameVisibleCount());
+        ImGui::Text("Vertices Drawn: %zu", Systems::g_RenderSystem->GetLastFrameVertexCount());
+        ImGui::Text("Indirect Draws: %zu", Systems::g_RenderSystem->GetLastFrameIndirectDrawCount());
+
+        const RenderStateStats& stateStats = Systems::g_RenderSystem->GetLastFrameStateStats();
+        ImGui::Text("Draw Calls: %zu", stateStats.m_DrawCalls);
+        ImGui::Text("Program Changes: %zu", stateStats.m_ProgramChanges);
+        ImGui::Text("VAO Changes: %zu", stateStats.m_VertexArrayChanges);
+        ImGui::Text("Polygon Mode Changes: %zu", stateStats.m_PolygonModeChanges);
+    }
+    
     ImGui::Separator();
     
     // Window info
@@ -397,3 +450,330 @@ void ImGuiManager::RenderAssignment4Controls(Registry& registry)
         Systems::g_RenderSystem->SetKDSplitMethod(KdSplitMethod::MedianExtent);
     }
 }
+
+/**
+ * @brief Shows one tree's structure statistics, histograms and per-query averages.
+ * @param label Tree name, also used as the ImGui ID scope
+ * @param stats Statistics to show
+ */
+static void RenderTreeStats(const char* label, const SpatialTreeStats& stats)
+{
+    ImGui::PushID(label);
+    ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s", label);
+    if (stats.m_NodeCount == 0)
+    {
+        ImGui::Text("Not built");
+        ImGui::PopID();
+        return;
+    }
+
+    ImGui::Text("Nodes: %zu  Leaves: %zu  Max depth: %zu", stats.m_NodeCount, stats.m_LeafCount, stats.m_MaxDepth);
+    ImGui::Text("Empty leaves: %zu (%.1f%%)  Object refs: %zu", stats.m_EmptyLeafCount,
+                stats.GetEmptyLeafRatio() * 100.0, stats.m_ObjectReferences);
+    ImGui::Text("Memory: %.1f KB", static_cast<double>(stats.m_MemoryBytes) / 1024.0);
+
+    std::vector<float> depths(stats.m_DepthHistogram.begin(), stats.m_DepthHistogram.end());
+    ImGui::PlotHistogram("Nodes / depth", depths.data(), static_cast<int>(depths.size()), 0, nullptr,
+                         0.0f, FLT_MAX, ImVec2(0.0f, 50.0f));
+    std::vector<float> occupancy(stats.m_LeafOccupancyHistogram.begin(), stats.m_LeafOccupancyHistogram.end());
+    ImGui::PlotHistogram("Leaves / object count", occupancy.data(), static_cast<int>(occupancy.size()), 0, nullptr,
+                         0.0f, FLT_MAX, ImVec2(0.0f, 50.0f));
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("Bucket i holds leaves with i objects; the last bucket holds %zu or more",
+                          SpatialTreeStats::kOccupancyBuckets - 1);
+    }
+
+    const SpatialQueryStats& q = stats.m_Queries;
+    if (q.m_Queries == 0)
+    {
+        ImGui::Text("No queries measured");
+    }
+    else
+    {
+        ImGui::Text("Per query over %llu queries:", static_cast<unsigned long long>(q.m_Queries));
+        ImGui::Text("  Nodes visited:     %.1f", q.PerQuery(q.m_NodesVisited));
+        ImGui::Text("  Primitives tested: %.1f", q.PerQuery(q.m_PrimitivesTested));
+        ImGui::Text("  Subtrees culled:   %.1f", q.PerQuery(q.m_CulledSubtrees));
+        ImGui::Text("  Subtrees accepted: %.1f", q.PerQuery(q.m_AcceptedSubtrees));
+        ImGui::Text("  Results:           %.1f", q.PerQuery(q.m_Results));
+    }
+    ImGui::PopID();
+}
+
+void ImGuiManager::RenderSpatialStatsWindow()
+{
+    if (!Systems::g_RenderSystem)
+    {
+        ImGui::Text("Render system not available");
+        return;
+    }
+
+    bool measure = Systems::g_RenderSystem->IsMeasuringSpatialQueries();
+    if (ImGui::Checkbox("Measure Frustum Queries", &measure))
+    {
+        Systems::g_RenderSystem->SetMeasureSpatialQueries(measure);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Counters"))
+    {
+        Systems::g_RenderSystem->ResetSpatialQueryStats();
+    }
+    ImGui::TextDisabled("Counters reset whenever a tree is rebuilt");
+
+    ImGui::Separator();
+    RenderTreeStats("Octree", Systems::g_RenderSystem->GetOctreeStats());
+    ImGui::Separator();
+    RenderTreeStats("KD-Tree", Systems::g_RenderSystem->GetKDTreeStats());
+}
+
+void ImGuiManager::RenderProfilerWindow()
+{
+    Profiler& profiler = Profiler::Get();
+
+    bool enabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Enable Profiling", &enabled))
+    {
+        profiler.SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    bool paused = profiler.IsPaused();
+    if (ImGui::Checkbox("Pause", &paused))
+    {
+        profiler.SetPaused(paused);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear"))
+    {
+        profiler.ClearHistory();
+        m_ProfilerSelectedFrame = -1;
+    }
+
+    // Chrome trace capture of the last few seconds, also saved with F9
+    TraceRecorder& recorder = TraceRecorder::Get();
+    if (ImGui::Button("Save Trace (F9)"))
+    {
+        m_ProfilerLastTrace = recorder.SaveTimestamped();
+    }
+    ImGui::SameLine();
+    float windowSeconds = static_cast<float>(recorder.GetWindowSeconds());
+    ImGui::SetNextItemWidth(120.0f);
+    if (ImGui::SliderFloat("Trace Window (s)", &windowSeconds, 1.0f, 60.0f, "%.0f"))
+    {
+        recorder.SetWindowSeconds(windowSeconds);
+    }
+    ImGui::Text("Trace buffer: %zu frames, %.1f s", recorder.GetFrameCount(), recorder.GetBufferedSeconds());
+    if (!m_ProfilerLastTrace.empty())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("Saved %s", m_ProfilerLastTrace.c_str());
+    }
+
+    const std::deque<ProfileFrame>& history = profiler.GetHistory();
+    if (history.empty())
+    {
+        ImGui::Text("No frames recorded.");
+        return;
+    }
+
+    // Frame time history; clicking a bar pauses on that frame
+    std::vector<float> frameMs;
+    frameMs.reserve(history.size());
+    int worstFrame = 0;
+    for (size_t i = 0; i < history.size(); ++i)
+    {
+        frameMs.push_back(static_cast<float>(history[i].GetDurationMs()));
+        if (frameMs.back() > frameMs[worstFrame])
+            worstFrame = static_cast<int>(i);
+    }
+
+    char overlay[64];
+    std::snprintf(overlay, sizeof(overlay), "Frame time (worst %.2f ms)", frameMs[worstFrame]);
+    ImGui::PlotHistogram("##FrameTimes", frameMs.data(), static_cast<int>(frameMs.size()), 0, overlay,
+                         0.0f, frameMs[worstFrame] * 1.1f, ImVec2(-1.0f, 60.0f));
+    if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+    {
+        float t = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+        m_ProfilerSelectedFrame = std::clamp(static_cast<int>(t * frameMs.size()), 0, static_cast<int>(frameMs.size()) - 1);
+        profiler.SetPaused(true);
+    }
+
+    if (ImGui::Button("Latest"))
+    {
+        m_ProfilerSelectedFrame = -1;
+        profiler.SetPaused(false);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Worst Frame"))
+    {
+        m_ProfilerSelectedFrame = worstFrame;
+        profiler.SetPaused(true);
+    }
+
+    if (m_ProfilerSelectedFrame >= static_cast<int>(history.size()))
+        m_ProfilerSelectedFrame = -1;
+    const ProfileFrame& frame = history[m_ProfilerSelectedFrame < 0 ? history.size() - 1 : static_cast<size_t>(m_ProfilerSelectedFrame)];
+    ImGui::SameLine();
+    ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(frame.m_Index), frame.GetDurationMs());
+
+    // Timeline: one band per thread, one row per nesting depth, bars scaled to the frame duration
+    if (ImGui::CollapsingHeader("Timeline", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        std::vector<std::string> threadNames = profiler.GetThreadNames();
+        std::vector<int> threadRows(threadNames.size(), 0);
+        for (const ProfileZoneRecord& zone : frame.m_Zones)
+        {
+            int& rows = threadRows[zone.m_ThreadIndex];
+            rows = std::max(rows, static_cast<int>(zone.m_Depth) + 1);
+        }
+
+        const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+        std::vector<float> threadOffsets(threadNames.size(), 0.0f);
+        float totalHeight = 0.0f;
+        for (size_t t = 0; t < threadNames.size(); ++t)
+        {
+            if (threadRows[t] == 0)
+                continue;
+            threadOffsets[t] = totalHeight;
+            totalHeight += rowHeight * static_cast<float>(threadRows[t] + 1); // +1 for the thread label
+        }
+
+        ImGui::BeginChild("ProfilerTimeline", ImVec2(0.0f, totalHeight + 8.0f), true);
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+        double frameNs = static_cast<double>(std::max<uint64_t>(frame.m_EndNs - frame.m_StartNs, 1));
+
+        for (size_t t = 0; t < threadNames.size(); ++t)
+        {
+            if (threadRows[t] > 0)
+                drawList->AddText(ImVec2(origin.x, origin.y + threadOffsets[t]), IM_COL32(200, 200, 200, 255), threadNames[t].c_str());
+        }
+
+        for (const ProfileZoneRecord& zone : frame.m_Zones)
+        {
+            uint64_t startNs = std::max(zone.m_StartNs, frame.m_StartNs);
+            uint64_t endNs   = std::min(zone.m_EndNs, frame.m_EndNs);
+            if (endNs <= startNs)
+                continue;
+
+            float x0 = origin.x + static_cast<float>((startNs - frame.m_StartNs) / frameNs) * width;
+            float x1 = origin.x + static_cast<float>((endNs - frame.m_StartNs) / frameNs) * width;
+            x1 = std::max(x1, x0 + 1.0f);
+            float y0 = origin.y + threadOffsets[zone.m_ThreadIndex] + rowHeight * static_cast<float>(zone.m_Depth + 1);
+            float y1 = y0 + rowHeight - 1.0f;
+
+            // Stable colour per zone name
+            float hue = static_cast<float>(std::hash<std::string_view>{}(zone.m_Name) % 360) / 360.0f;
+            drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ImColor::HSV(hue, 0.5f, 0.75f));
+
+            ImVec2 textSize = ImGui::CalcTextSize(zone.m_Name);
+            if (textSize.x + 4.0f < x1 - x0)
+            {
+                drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), zone.m_Name);
+            }
+
+            if (ImGui::IsMouseHoveringRect(ImVec2(x0, y0), ImVec2(x1, y1)))
+            {
+                ImGui::SetTooltip("%s\n%.3f ms\n%s", zone.m_Name,
+                                  static_cast<double>(zone.m_EndNs - zone.m_StartNs) * 1e-6,
+                                  threadNames[zone.m_ThreadIndex].c_str());
+            }
+        }
+
+        ImGui::Dummy(ImVec2(width, totalHeight));
+        ImGui::EndChild();
+    }
+
+    // Per-zone totals per frame over the whole history
+    const std::vector<ProfileZoneStats> zoneStats = profiler.ComputeZoneStats();
+    if (ImGui::CollapsingHeader("Zone Statistics", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::Text("%zu frames", history.size());
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+        if (ImGui::BeginTable("ProfilerZoneStats", 7, flags))
+        {
+            ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("P50 ms");
+            ImGui::TableSetupColumn("P95 ms");
+            ImGui::TableSetupColumn("P99 ms");
+            ImGui::TableSetupColumn("Max ms");
+            ImGui::TableHeadersRow();
+
+            for (const ProfileZoneStats& zone : zoneStats)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(zone.m_Name.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", zone.m_CallsPerFrame);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.m_AverageMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.m_P50Ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.m_P95Ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.m_P99Ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.m_MaxMs);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    // GPU time per render pass next to the CPU time of the zone with the same name
+    if (ImGui::CollapsingHeader("GPU Passes", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        if (!Systems::g_RenderSystem)
+        {
+            ImGui::Text("Render system not available");
+            return;
+        }
+
+        GpuTimer& gpuTimer = Systems::g_RenderSystem->GetGpuTimer();
+        if (!gpuTimer.IsAvailable())
+        {
+            ImGui::TextDisabled("GPU timer queries unavailable (no GL context or no timer query support).");
+        }
+        else
+        {
+            bool gpuEnabled = gpuTimer.IsEnabled();
+            if (ImGui::Checkbox("Time GPU Passes", &gpuEnabled))
+            {
+                gpuTimer.SetEnabled(gpuEnabled);
+            }
+
+            double cpuFrameMs = 0.0;
+            for (const ProfileFrame& recorded : history)
+            {
+                cpuFrameMs += recorded.GetDurationMs();
+            }
+            cpuFrameMs /= static_cast<double>(history.size());
+            ImGui::Text("GPU passes: %.3f ms   CPU frame: %.3f ms avg   (%llu late results dropped)",
+                        gpuTimer.GetTotalMs(), cpuFrameMs, static_cast<unsigned long long>(gpuTimer.GetDroppedResults()));
+
+            const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+            if (ImGui::BeginTable("ProfilerGpuPasses", 4, flags))
+            {
+                ImGui::TableSetupColumn("Pass", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("GPU ms");
+                ImGui::TableSetupColumn("GPU avg ms");
+                ImGui::TableSetupColumn("CPU avg ms");
+                ImGui::TableHeadersRow();
+
+                for (const GpuPassTiming& pass : gpuTimer.GetTimings())
+                {
+                    auto cpuZone = std::find_if(zoneStats.begin(), zoneStats.end(),
+                                                [&pass](const ProfileZoneStats& zone) { return zone.m_Name == pass.m_Name; });
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(pass.m_Name);
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", pass.m_LastMs);
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", pass.m_AverageMs);
+                    ImGui::TableNextColumn();
+                    if (cpuZone != zoneStats.end())
+                        ImGui::Text("%.3f", cpuZone->m_AverageMs);
+                    else
+                        ImGui::TextDisabled("-");
+                }
+                ImGui::EndTable();
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file IndirectDrawBatch.cpp
+ * @brief Implementation of the multi-draw indirect mesh batch.
+ */
+
+#include "IndirectDrawBatch.hpp"
+#include "MeshArena.hpp"
+
+IndirectDrawBatch::IndirectDrawBatch()
+{
+}
+
+IndirectDrawBatch::~IndirectDrawBatch()
+{
+    CleanUp();
+}
+
+void IndirectDrawBatch::Begin()
+{
+    m_Commands.clear();
+    m_Instances.clear();
+}
+
+void IndirectDrawBatch::Add(const MeshArenaRange& range, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix, const glm::vec3& color)
+{
+    DrawElementsIndirectCommand command;
+    command.m_Count         = range.m_IndexCount;
+    command.m_InstanceCount = 1;
+    command.m_FirstIndex    = range.m_FirstIndex;
+    command.m_BaseVertex    = range.m_BaseVertex;
+    command.m_BaseInstance  = static_cast<GLuint>(m_Instances.size());
+
+    m_Commands.push_back(command);
+    m_Instances.push_back({ modelMatrix, glm::mat3x4(normalMatrix), glm::vec4(color, 1.0f) });
+}
+
+void IndirectDrawBatch::Submit()
+{
+    if (m_Commands.empty())
+        return;
+
+    if (m_CommandBuffer == 0)
+    {
+        glGenBuffers(1, &m_CommandBuffer);
+        glGenBuffers(1, &m_InstanceBuffer);
+    }
+
+    // Re-specify the whole store each frame so the driver can orphan last frame's data
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_InstanceBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, m_Instances.size() * sizeof(InstanceData), m_Instances.data(), GL_STREAM_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kInstanceBufferBinding, m_InstanceBuffer);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Commands.size() * sizeof(DrawElementsIndirectCommand), m_Commands.data(), GL_STREAM_DRAW);
+
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(m_Commands.size()), 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void IndirectDrawBatch::CleanUp()
+{
+    if (m_CommandBuffer != 0) {
+        glDeleteBuffers(1, &m_CommandBuffer);
+        m_CommandBuffer = 0;
+    }
+
+    if (m_InstanceBuffer != 0) {
+        glDeleteBuffers(1, &m_InstanceBuffer);
+        m_InstanceBuffer = 0;
+    }
+
+    m_Commands.clear();
+    m_Instances.clear();
+}
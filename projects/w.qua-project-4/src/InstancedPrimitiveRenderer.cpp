@@ -0,0 +1,103 @@
+/**
+ * @file InstancedPrimitiveRenderer.cpp
+ * @brief Implementation of the instanced unit cube / unit sphere renderer.
+ */
+
+#include "InstancedPrimitiveRenderer.hpp"
+#include "CubeRenderer.hpp"
+#include "SphereRenderer.hpp"
+#include "Shader.hpp"
+#include "Geometry.hpp"
+
+// Flat volumes still need an invertible transform for the shader's normal matrix
+static constexpr float kMinScale = 1e-6f;
+
+InstancedPrimitiveRenderer::InstancedPrimitiveRenderer(PrimitiveShape shape, bool wireframe)
+    : m_Shape(shape), m_Wireframe(wireframe)
+{
+}
+
+InstancedPrimitiveRenderer::~InstancedPrimitiveRenderer()
+{
+    CleanUp();
+}
+
+void InstancedPrimitiveRenderer::Initialize(const std::shared_ptr<Shader>& shader)
+{
+    m_Shader = shader;
+    m_ModelLocation = m_Shader->GetUniformLocation("model");
+    m_NormalMatrixLocation = m_Shader->GetUniformLocation("normalMatrix");
+
+    // Vertex colour is white; the instance colour replaces it in the shader
+    const glm::vec3 white(1.0f);
+    std::vector<Vertex> vertices = (m_Shape == PrimitiveShape::Cube)
+        ? CubeRenderer(glm::vec3(0.0f), glm::vec3(1.0f), white).CreateVertices()
+        : SphereRenderer(glm::vec3(0.0f), 1.0f, white).CreateVertices();
+
+    m_Buffer.Setup(vertices);
+    m_InstancesDirty = true;
+}
+
+void InstancedPrimitiveRenderer::Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix)
+{
+    if (!m_Shader || m_Instances.empty() || m_InstancesDirty)
+        return;
+
+    m_Shader->SetMat4(m_ModelLocation, modelMatrix);
+    m_Shader->SetMat3(m_NormalMatrixLocation, normalMatrix);
+
+    glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(m_Buffer.GetVertexCount()),
+                          static_cast<GLsizei>(m_Instances.size()));
+}
+
+void InstancedPrimitiveRenderer::UploadInstances()
+{
+    if (!m_InstancesDirty)
+        return;
+
+    // The first upload attaches the instance buffer to the vertex array
+    m_Buffer.SetupInstances(m_Instances);
+    m_InstancesDirty = false;
+}
+
+void InstancedPrimitiveRenderer::CleanUp()
+{
+    m_Instances.clear();
+    m_InstancesDirty = true;
+}
+
+void InstancedPrimitiveRenderer::ClearInstances()
+{
+    m_Instances.clear();
+    m_InstancesDirty = true;
+}
+
+void InstancedPrimitiveRenderer::AddInstance(const glm::mat4& transform, const glm::vec3& color)
+{
+    m_Instances.push_back({ transform, glm::mat3x4(ComputeNormalMatrix(transform)), glm::vec4(color, 1.0f) });
+    m_InstancesDirty = true;
+}
+
+glm::mat4 InstancedPrimitiveRenderer::BoxTransform(const glm::vec3& center, const glm::vec3& size)
+{
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), center);
+    return glm::scale(transform, glm::max(size, glm::vec3(kMinScale)));
+}
+
+glm::mat4 InstancedPrimitiveRenderer::OrientedBoxTransform(const glm::vec3& center, const glm::vec3 axes[3], const glm::vec3& halfExtents)
+{
+    // Columns are the box axes scaled to full size; the unit cube spans [-0.5, 0.5]
+    glm::mat4 transform(1.0f);
+    glm::vec3 size = glm::max(halfExtents * 2.0f, glm::vec3(kMinScale));
+    transform[0] = glm::vec4(axes[0] * size.x, 0.0f);
+    transform[1] = glm::vec4(axes[1] * size.y, 0.0f);
+    transform[2] = glm::vec4(axes[2] * size.z, 0.0f);
+    transform[3] = glm::vec4(center, 1.0f);
+    return transform;
+}
+
+glm::mat4 InstancedPrimitiveRenderer::SphereTransform(const glm::vec3& center, float radius)
+{
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), center);
+    return glm::scale(transform, glm::vec3(std::max(radius, kMinScale)));
+}
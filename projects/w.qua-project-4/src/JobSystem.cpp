@@ -0,0 +1,253 @@
+/**
+ * @file JobSystem.cpp
+ * @brief Implementation of the work-stealing job system.
+ */
+
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+#include <limits>
+
+namespace
+{
+    constexpr size_t kOutsideThread = ~size_t(0);
+
+    // Deque owned by the calling thread; threads outside the pool use the shared last one
+    thread_local size_t t_QueueIndex = kOutsideThread;
+}
+
+JobSystem& JobSystem::Get()
+{
+    static JobSystem s_Instance;
+    return s_Instance;
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Initialize(size_t workerCount)
+{
+    Shutdown();
+
+    if (workerCount == kAutoWorkerCount)
+    {
+        // hardware_concurrency may report 0 when unknown
+        size_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    if (workerCount == 0)
+        return;
+
+    m_Queues.reserve(workerCount + 1);
+    for (size_t i = 0; i < workerCount + 1; ++i)
+    {
+        m_Queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    m_Workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    if (m_Workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Stopping = true;
+    }
+    m_WakeCondition.notify_all();
+
+    // Workers drain the deques before they exit
+    for (std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+
+    m_Workers.clear();
+    m_Queues.clear();
+    m_Stopping = false;
+}
+
+void JobSystem::Run(JobCounter& counter, JobFunction job)
+{
+    if (IsSingleThreaded())
+    {
+        job();
+        m_Executed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    counter.m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+    size_t queueIndex = t_QueueIndex == kOutsideThread ? m_Queues.size() - 1 : t_QueueIndex;
+    {
+        JobQueue& queue = *m_Queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.m_Mutex);
+        queue.m_Jobs.push_back({ std::move(job), &counter });
+    }
+
+    // A worker going to sleep registers before it re-checks m_QueuedJobs under
+    // m_SleepMutex, so either it sees this job or we see it and wake it
+    m_QueuedJobs.fetch_add(1);
+    if (m_SleepingWorkers.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+        }
+        m_WakeCondition.notify_one();
+    }
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    size_t queueIndex = t_QueueIndex == kOutsideThread ? m_Queues.size() - 1 : t_QueueIndex;
+    while (!counter.IsDone())
+    {
+        Job job;
+        if (TryTakeJob(queueIndex, job))
+        {
+            Execute(job);
+        }
+        else
+        {
+            // The remaining jobs are running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const RangeFunction& fn)
+{
+    if (count == 0)
+        return;
+
+    // Chunk indices must fit in 32 bits; only ranges of billions of items need coarser chunks
+    constexpr size_t kMaxChunks = std::numeric_limits<uint32_t>::max();
+    grainSize = std::max<size_t>({ grainSize, 1, (count + kMaxChunks - 1) / kMaxChunks });
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    if (IsSingleThreaded() || chunkCount == 1)
+    {
+        for (size_t begin = 0; begin < count; begin += grainSize)
+        {
+            fn(begin, std::min(count, begin + grainSize));
+        }
+        return;
+    }
+
+    JobCounter counter;
+    ChunkRange range{ this, &counter, count, grainSize, &fn };
+    RunChunks(range, 0, static_cast<uint32_t>(chunkCount));
+    Wait(counter);
+}
+
+JobSystemStats JobSystem::GetStats() const
+{
+    JobSystemStats stats;
+    stats.m_Executed = m_Executed.load(std::memory_order_relaxed);
+    stats.m_Stolen   = m_Stolen.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void JobSystem::ResetStats()
+{
+    m_Executed.store(0, std::memory_order_relaxed);
+    m_Stolen.store(0, std::memory_order_relaxed);
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex)
+{
+    t_QueueIndex = queueIndex;
+    Profiler::Get().SetThreadName("Worker " + std::to_string(queueIndex + 1));
+
+    while (true)
+    {
+        Job job;
+        if (TryTakeJob(queueIndex, job))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_SleepingWorkers.fetch_add(1);
+        m_WakeCondition.wait(lock, [this]() { return m_Stopping || m_QueuedJobs.load() > 0; });
+        m_SleepingWorkers.fetch_sub(1);
+
+        if (m_Stopping && m_QueuedJobs.load() == 0)
+            break;
+    }
+
+    t_QueueIndex = kOutsideThread;
+}
+
+bool JobSystem::TryTakeJob(size_t queueIndex, Job& out_job)
+{
+    if (m_QueuedJobs.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    // Own deque first, newest job
+    {
+        JobQueue& queue = *m_Queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.m_Mutex);
+        if (!queue.m_Jobs.empty())
+        {
+            out_job = std::move(queue.m_Jobs.back());
+            queue.m_Jobs.pop_back();
+            m_QueuedJobs.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Then steal the oldest job of the next non-empty deque
+    const size_t queueCount = m_Queues.size();
+    for (size_t offset = 1; offset < queueCount; ++offset)
+    {
+        JobQueue& victim = *m_Queues[(queueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.m_Mutex);
+        if (!victim.m_Jobs.empty())
+        {
+            out_job = std::move(victim.m_Jobs.front());
+            victim.m_Jobs.pop_front();
+            m_QueuedJobs.fetch_sub(1);
+            m_Stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::Execute(Job& job)
+{
+    job.m_Function();
+    m_Executed.fetch_add(1, std::memory_order_relaxed);
+    // Release so the waiter sees everything the job wrote
+    job.m_Counter->m_Pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::RunChunks(const ChunkRange& range, uint32_t firstChunk, uint32_t lastChunk)
+{
+    // Hand the upper half to the pool until one chunk is left
+    while (lastChunk - firstChunk > 1)
+    {
+        uint32_t middle = firstChunk + (lastChunk - firstChunk) / 2;
+        auto fork = [&range, middle, lastChunk]() {
+            range.m_Jobs->RunChunks(range, middle, lastChunk);
+        };
+        // Two pointers fit std::function's inline buffer; anything larger allocates per fork
+        static_assert(sizeof(fork) <= 2 * sizeof(void*), "ParallelFor fork capture grew");
+        Run(*range.m_Counter, fork);
+        lastChunk = middle;
+    }
+
+    size_t begin = static_cast<size_t>(firstChunk) * range.m_GrainSize;
+    (*range.m_Function)(begin, std::min(range.m_Count, begin + range.m_GrainSize));
+}
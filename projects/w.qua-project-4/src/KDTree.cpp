@@ -1,6 +1,8 @@
 #include "KDTree.hpp"
 #include "Geometry.hpp"
 #include "SpatialTreeUtils.hpp"
+#include "Profiler.hpp"
+#include "JobSystem.hpp"
 
 KDTree::KDTree(Registry& registry, int maxObjectsPerNode, KdSplitMethod splitMethod, int maxDepth)
     : m_Registry(registry),
@@ -10,83 +12,77 @@ KDTree::KDTree(Registry& registry, int maxObjectsPerNode, KdSplitMethod splitMet
 {
 }
 
-float KDTree::ChooseSplitPosition(const std::vector<Registry::Entity>& entities, int axis)
+namespace
 {
-    std::vector<float> values;
-    values.reserve(entities.size());
+    // Subtrees over at least this many entities fork their left half as a job
+    constexpr size_t kParallelSubtreeEntities = 2048;
+    // Entities per job when caching centres
+    constexpr size_t kCenterGrain = 16384;
+}
 
-    for (auto entity : entities)
-    {
-        auto& t  = m_Registry.GetComponent<TransformComponent>(entity);
-        auto& bc = m_Registry.GetComponent<BoundingComponent>(entity);
-        Aabb box = bc.GetAABB();
-        box.Transform(t.m_Model);
+float KDTree::ChooseSplitPosition(size_t begin, size_t end, int axis)
+{
+    if (begin == end) return 0.0f;
 
+    // Keys are copied to a contiguous range of m_Keys, so nth_element runs on packed floats
+    for (size_t i = begin; i < end; ++i)
+    {
+        const BuildRef& ref = m_Order[i];
         if (m_SplitMethod == KdSplitMethod::MedianCenter)
-        {
-            values.push_back(box.GetCenter()[axis]);
-        }
-        else // MedianExtent 
-        {
-            values.push_back(box.GetExtents()[axis]);
-        }
+            m_Keys[i] = ref.m_Center[axis];
+        else // MedianExtent
+            m_Keys[i] = m_Snapshot->GetBounds(ref.m_Item).GetExtents()[axis];
     }
 
-    if (values.empty()) return 0.0f;
-
     // Wesley: nth_element sorts all values based on the middle index, left values < middle index < right values.
     //         We return the middle index as the partition
-    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
-    return values[values.size() / 2];
+    auto first  = m_Keys.begin() + begin;
+    auto middle = first + (end - begin) / 2;
+    std::nth_element(first, middle, m_Keys.begin() + end);
+    return *middle;
 }
 
-std::unique_ptr<KdNode> KDTree::BuildKdTree(const std::vector<Registry::Entity>& entities,
-                                               const Aabb& bounds,
-                                               int level)
+KdNode* KDTree::BuildKdTree(std::deque<KdNode>& arena,
+                            size_t begin, size_t end,
+                            const Aabb& bounds,
+                            int level)
 {
-    auto node = std::make_unique<KdNode>(bounds, level);
+    KdNode& node = arena.emplace_back(bounds, level);
+    const size_t count = end - begin;
 
-    if (entities.empty() || level >= m_MaxDepth || static_cast<int>(entities.size()) <= m_MaxObjects)
+    // Only leaves own objects; their content bounds are the union of those objects' world boxes
+    auto makeLeaf = [&]() -> KdNode*
     {
-        node->objects = entities;
-        return node;
+        node.contentBounds = SpatialTreeUtils::EmptyBounds();
+        for (size_t i = begin; i < end; ++i)
+        {
+            uint32_t item = m_Order[i].m_Item;
+            m_Entities[i] = m_Snapshot->GetEntity(item);
+            SpatialTreeUtils::Expand(node.contentBounds, m_Snapshot->GetBounds(item));
+        }
+        node.objects = std::span<const Registry::Entity>(m_Entities.data() + begin, count);
+        return &node;
+    };
+
+    if (count == 0 || level >= m_MaxDepth || static_cast<int>(count) <= m_MaxObjects)
+    {
+        return makeLeaf();
     }
 
     int axis = level % 3; // X, Y, Z cycling
-    float splitPos = ChooseSplitPosition(entities, axis);
-
-    node->axis  = axis;
-    node->split = splitPos;
-
-    std::vector<Registry::Entity> leftSet;
-    std::vector<Registry::Entity> rightSet;
+    float splitPos = ChooseSplitPosition(begin, end, axis);
 
-    leftSet.reserve(entities.size());
-    rightSet.reserve(entities.size());
+    node.axis  = axis;
+    node.split = splitPos;
 
-    for (auto entity : entities)
-    {
-        auto& t  = m_Registry.GetComponent<TransformComponent>(entity);
-        auto& bc = m_Registry.GetComponent<BoundingComponent>(entity);
-        Aabb box = bc.GetAABB();
-        box.Transform(t.m_Model);
-
-        float centerVal = box.GetCenter()[axis];
-        if (centerVal < splitPos)
-        {
-            leftSet.push_back(entity);
-        }
-        else
-        {
-            rightSet.push_back(entity);
-        }
-    }
+    auto split = std::partition(m_Order.begin() + begin, m_Order.begin() + end,
+                                [axis, splitPos](const BuildRef& ref) { return ref.m_Center[axis] < splitPos; });
+    const size_t middle = static_cast<size_t>(split - m_Order.begin());
 
     // If one side empty -> terminate
-    if (leftSet.empty() || rightSet.empty())
+    if (middle == begin || middle == end)
     {
-        node->objects = entities;
-        return node;
+        return makeLeaf();
     }
 
     // Create child bounds by splitting parent bounds along axis
@@ -98,34 +94,76 @@ std::unique_ptr<KdNode> KDTree::BuildKdTree(const std::vector<Registry::Entity>&
     maxLeft[axis]  = splitPos;
     minRight[axis] = splitPos;
 
-    node->left  = BuildKdTree(leftSet,  Aabb(minLeft,  maxLeft),  level + 1);
-    node->right = BuildKdTree(rightSet, Aabb(minRight, maxRight), level + 1);
+    Aabb leftBounds(minLeft, maxLeft);
+    Aabb rightBounds(minRight, maxRight);
+
+    if (m_ParallelBuild && count >= kParallelSubtreeEntities)
+    {
+        // Left half as a job with its own arena, right half on this thread
+        JobSystem& jobs = JobSystem::Get();
+        JobCounter leftDone;
+        jobs.Run(leftDone, [this, &node, &leftBounds, begin, middle]()
+        {
+            node.left = BuildKdTree(m_NodeArenas.Acquire(), begin, middle, leftBounds, node.level + 1);
+        });
+        node.right = BuildKdTree(arena, middle, end, rightBounds, level + 1);
+        jobs.Wait(leftDone);
+    }
+    else
+    {
+        node.left  = BuildKdTree(arena, begin,  middle, leftBounds,  level + 1);
+        node.right = BuildKdTree(arena, middle, end,    rightBounds, level + 1);
+    }
 
-    return node;
+    node.contentBounds = SpatialTreeUtils::EmptyBounds();
+    for (const KdNode* child : { node.left, node.right })
+    {
+        if (!SpatialTreeUtils::IsEmpty(child->contentBounds))
+            SpatialTreeUtils::Expand(node.contentBounds, child->contentBounds);
+    }
+    return &node;
 }
 
 void KDTree::Build()
 {
-    if (!m_Dirty) return;
+    bool snapshotChanged = m_SharedSnapshot && m_SharedSnapshot->GetVersion() != m_SnapshotVersion;
+    if (!m_Dirty && !snapshotChanged) return;
+    PROFILE_SCOPE("KDTree::Build");
 
-    m_Root.reset();
+    m_Root = nullptr;
+    m_NodeArenas.Clear();
 
-    std::vector<Registry::Entity> allEntities;
-    for (auto entity : m_Registry.View<TransformComponent, BoundingComponent>())
+    if (m_SharedSnapshot)
+    {
+        m_Snapshot = m_SharedSnapshot;
+    }
+    else
     {
-        allEntities.push_back(entity);
+        m_OwnSnapshot.Build(m_Registry, m_ParallelBuild);
+        m_Snapshot = &m_OwnSnapshot;
     }
+    m_SnapshotVersion = m_Snapshot->GetVersion();
 
-    if (allEntities.empty())
+    const Aabb& sceneBounds = m_Snapshot->GetSceneBounds();
+    const size_t count = m_Snapshot->GetCount();
+    if (count == 0)
     {
         m_Dirty = false;
         return;
     }
 
-    Aabb sceneBounds;
-    SpatialTreeUtils::ComputeSceneBounds(m_Registry, sceneBounds);
+    m_Order.resize(count);
+    m_Keys.resize(count);
+    SpatialTreeUtils::ForEachChunk(m_ParallelBuild, count, kCenterGrain, [this](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_Order[i] = { m_Snapshot->GetBounds(i).GetCenter(), static_cast<uint32_t>(i) };
+        }
+    });
+    m_Entities.resize(count);
 
-    m_Root = BuildKdTree(allEntities, sceneBounds, 0);
+    m_Root = BuildKdTree(m_NodeArenas.Acquire(), 0, count, sceneBounds, 0);
 
     m_Dirty = false;
 }
@@ -134,20 +172,20 @@ static void GatherKdNodes(KdNode* node, std::vector<KdNode*>& out)
 {
     if (!node) return;
     out.push_back(node);
-    GatherKdNodes(node->left.get(),  out);
-    GatherKdNodes(node->right.get(), out);
+    GatherKdNodes(node->left,  out);
+    GatherKdNodes(node->right, out);
 }
 
-void KDTree::CollectRenderables(const std::shared_ptr<Shader>& shader,
-                                std::vector<std::shared_ptr<CubeRenderer>>& out)
+void KDTree::CollectRenderables(InstancedPrimitiveRenderer& out)
 {
     Build();
-    out.clear();
+    PROFILE_SCOPE("KDTree::CollectRenderables");
+    out.ClearInstances();
 
     if (!m_Root) return;
 
     std::vector<KdNode*> nodes;
-    GatherKdNodes(m_Root.get(), nodes);
+    GatherKdNodes(m_Root, nodes);
 
     for (KdNode* node : nodes)
     {
@@ -155,8 +193,90 @@ void KDTree::CollectRenderables(const std::shared_ptr<Shader>& shader,
         glm::vec3 center  = node->bounds.GetCenter();
         glm::vec3 color = SpatialTreeUtils::LevelColor(node->level);
 
-        auto cube = std::make_shared<CubeRenderer>(center, size, color, true /*wireframe*/);
-        cube->Initialize(shader);
-        out.push_back(std::move(cube));
+        out.AddInstance(InstancedPrimitiveRenderer::BoxTransform(center, size), color);
     }
-} 
\ No newline at end of file
+}
+
+void KDTree::QueryFrustum(const glm::vec3 planeNormals[6], const float planeDistances[6],
+                          std::vector<Registry::Entity>& out)
+{
+    Build();
+
+    SpatialQueryStats* stats = m_QueryStatsEnabled ? &m_QueryStats : nullptr;
+    size_t firstResult = out.size();
+    if (m_Root)
+    {
+        QueryFrustumNode(m_Root, planeNormals, planeDistances, out, stats);
+    }
+
+    if (stats)
+    {
+        ++stats->m_Queries;
+        stats->m_Results += out.size() - firstResult;
+    }
+}
+
+static void AppendSubtree(const KdNode* node, std::vector<Registry::Entity>& out)
+{
+    if (!node) return;
+    out.insert(out.end(), node->objects.begin(), node->objects.end());
+    AppendSubtree(node->left,  out);
+    AppendSubtree(node->right, out);
+}
+
+void KDTree::QueryFrustumNode(const KdNode* node,
+                              const glm::vec3 planeNormals[6], const float planeDistances[6],
+                              std::vector<Registry::Entity>& out, SpatialQueryStats* stats)
+{
+    if (!node || SpatialTreeUtils::IsEmpty(node->contentBounds))
+        return;
+
+    if (stats) ++stats->m_NodesVisited;
+    SideResult side = SpatialTreeUtils::ClassifyFrustumAabb(planeNormals, planeDistances, node->contentBounds);
+    if (side == SideResult::eOUTSIDE)
+    {
+        if (stats) ++stats->m_CulledSubtrees;
+        return;
+    }
+    if (side == SideResult::eINSIDE)
+    {
+        // Accepted whole: AppendSubtree copies every leaf span at or below this node unclassified
+        if (stats) ++stats->m_AcceptedSubtrees;
+        AppendSubtree(node, out);
+        return;
+    }
+
+    // The leaf's objects are a range of m_Entities, whose positions match m_Order
+    const size_t first = static_cast<size_t>(node->objects.data() - m_Entities.data());
+    for (size_t i = 0; i < node->objects.size(); ++i)
+    {
+        if (stats) ++stats->m_PrimitivesTested;
+        Aabb box = m_Snapshot->GetBounds(m_Order[first + i].m_Item);
+        if (SpatialTreeUtils::ClassifyFrustumAabb(planeNormals, planeDistances, box) != SideResult::eOUTSIDE)
+        {
+            out.push_back(node->objects[i]);
+        }
+    }
+
+    QueryFrustumNode(node->left,  planeNormals, planeDistances, out, stats);
+    QueryFrustumNode(node->right, planeNormals, planeDistances, out, stats);
+}
+
+static void AccumulateTreeStats(const KdNode* node, SpatialTreeStats& stats)
+{
+    if (!node) return;
+    AccumulateTreeStats(node->left,  stats);
+    AccumulateTreeStats(node->right, stats);
+
+    bool leaf = !node->left && !node->right;
+    size_t bytes = sizeof(KdNode) + node->objects.size() * sizeof(Registry::Entity);
+    stats.AddNode(static_cast<size_t>(node->level), leaf, node->objects.size(), bytes);
+}
+
+SpatialTreeStats KDTree::GetStats() const
+{
+    SpatialTreeStats stats;
+    AccumulateTreeStats(m_Root, stats);
+    stats.m_Queries = m_QueryStats;
+    return stats;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file MeshArena.cpp
+ * @brief Implementation of the shared vertex/index arena used for indirect drawing.
+ */
+
+#include "MeshArena.hpp"
+#include <cstring>
+
+namespace
+{
+    // Initial arena sizes, in elements; buffers double when they run out
+    constexpr size_t kInitialVertexCapacity = 1 << 16;
+    constexpr size_t kInitialIndexCapacity  = 1 << 18;
+
+    struct VertexKey
+    {
+        const Vertex* vertex;
+
+        bool operator==(const VertexKey& other) const
+        {
+            const Vertex& a = *vertex;
+            const Vertex& b = *other.vertex;
+            return a.m_Position == b.m_Position && a.m_Normal == b.m_Normal && a.m_UV == b.m_UV;
+        }
+    };
+
+    struct VertexKeyHash
+    {
+        size_t operator()(const VertexKey& key) const
+        {
+            // Colour is ignored: the indirect path takes it from the per-draw data
+            float values[8] =
+            {
+                key.vertex->m_Position.x, key.vertex->m_Position.y, key.vertex->m_Position.z,
+                key.vertex->m_Normal.x,   key.vertex->m_Normal.y,   key.vertex->m_Normal.z,
+                key.vertex->m_UV.x,       key.vertex->m_UV.y
+            };
+
+            size_t h = 1469598103934665603ull;
+            for (float value : values)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                h = (h ^ bits) * 1099511628211ull;
+            }
+            return h;
+        }
+    };
+
+    /**
+     * @brief Converts a triangle list into unique vertices plus indices.
+     */
+    void BuildIndexedMesh(const std::vector<Vertex>& triangles, std::vector<Vertex>& out_vertices, std::vector<GLuint>& out_indices)
+    {
+        out_vertices.clear();
+        out_indices.clear();
+        out_indices.reserve(triangles.size());
+
+        std::unordered_map<VertexKey, GLuint, VertexKeyHash> lookup;
+        lookup.reserve(triangles.size());
+
+        for (const auto& vertex : triangles)
+        {
+            auto [it, inserted] = lookup.try_emplace(VertexKey{ &vertex }, static_cast<GLuint>(out_vertices.size()));
+            if (inserted)
+            {
+                out_vertices.push_back(vertex);
+            }
+            out_indices.push_back(it->second);
+        }
+    }
+}
+
+MeshArena::MeshArena()
+{
+}
+
+MeshArena::~MeshArena()
+{
+    Clear();
+}
+
+const MeshArenaRange* MeshArena::Acquire(const ResourceHandle& meshHandle, size_t lodLevel)
+{
+    auto it = m_Ranges.find(meshHandle);
+    if (it == m_Ranges.end())
+    {
+        auto mesh = ResourceSystem::GetInstance().GetMesh(meshHandle);
+        if (!mesh)
+        {
+            return nullptr;
+        }
+
+        std::vector<MeshArenaRange> ranges;
+        std::vector<Vertex> vertices;
+        std::vector<GLuint> indices;
+        for (size_t level = 0; level < mesh->GetLODCount(); ++level)
+        {
+            BuildIndexedMesh(mesh->GetLODVertexes(level), vertices, indices);
+            ranges.push_back(Append(vertices, indices));
+        }
+
+        it = m_Ranges.emplace(meshHandle, std::move(ranges)).first;
+    }
+
+    const auto& ranges = it->second;
+    if (ranges.empty())
+    {
+        return nullptr;
+    }
+    return &ranges[std::min(lodLevel, ranges.size() - 1)];
+}
+
+const MeshArenaRange* MeshArena::Find(const ResourceHandle& meshHandle, size_t lodLevel) const
+{
+    auto it = m_Ranges.find(meshHandle);
+    if (it == m_Ranges.end() || it->second.empty())
+    {
+        return nullptr;
+    }
+
+    const auto& ranges = it->second;
+    return &ranges[std::min(lodLevel, ranges.size() - 1)];
+}
+
+void MeshArena::Bind() const
+{
+    glBindVertexArray(m_vao);
+}
+
+void MeshArena::Unbind() const
+{
+    glBindVertexArray(0);
+}
+
+void MeshArena::Clear()
+{
+    if (m_vbo != 0) {
+        glDeleteBuffers(1, &m_vbo);
+        m_vbo = 0;
+    }
+
+    if (m_ebo != 0) {
+        glDeleteBuffers(1, &m_ebo);
+        m_ebo = 0;
+    }
+
+    if (m_vao != 0) {
+        glDeleteVertexArrays(1, &m_vao);
+        m_vao = 0;
+    }
+
+    m_VertexCapacity = 0;
+    m_IndexCapacity  = 0;
+    m_VertexCount    = 0;
+    m_IndexCount     = 0;
+    m_VertexArrayDirty = true;
+    m_Ranges.clear();
+}
+
+MeshArenaRange MeshArena::Append(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices)
+{
+    Reserve(m_vbo, m_VertexCapacity, m_VertexCount,
+            std::max(m_VertexCount + vertices.size(), kInitialVertexCapacity), sizeof(Vertex));
+    Reserve(m_ebo, m_IndexCapacity, m_IndexCount,
+            std::max(m_IndexCount + indices.size(), kInitialIndexCapacity), sizeof(GLuint));
+
+    MeshArenaRange range;
+    range.m_FirstIndex = static_cast<GLuint>(m_IndexCount);
+    range.m_IndexCount = static_cast<GLuint>(indices.size());
+    range.m_BaseVertex = static_cast<GLint>(m_VertexCount);
+
+    // Upload through the copy targets so the element binding of a bound VAO is never touched
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_vbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, m_VertexCount * sizeof(Vertex), vertices.size() * sizeof(Vertex), vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_ebo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, m_IndexCount * sizeof(GLuint), indices.size() * sizeof(GLuint), indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    m_VertexCount += vertices.size();
+    m_IndexCount  += indices.size();
+
+    if (m_VertexArrayDirty)
+    {
+        SetupVertexArray();
+    }
+
+    return range;
+}
+
+void MeshArena::Reserve(GLuint& buffer, size_t& capacity, size_t used, size_t required, size_t elementSize)
+{
+    if (buffer != 0 && required <= capacity)
+    {
+        return;
+    }
+
+    size_t newCapacity = std::max(required, capacity * 2);
+
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, newCapacity * elementSize, nullptr, GL_STATIC_DRAW);
+
+    if (buffer != 0)
+    {
+        if (used > 0)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, used * elementSize);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    buffer = newBuffer;
+    capacity = newCapacity;
+    m_VertexArrayDirty = true;
+}
+
+void MeshArena::SetupVertexArray()
+{
+    if (m_vao == 0)
+    {
+        glGenVertexArrays(1, &m_vao);
+    }
+    glBindVertexArray(m_vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+
+    // Same attribute layout as Buffer so both paths share the shader inputs
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Position));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Color));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Normal));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_UV));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_VertexArrayDirty = false;
+}
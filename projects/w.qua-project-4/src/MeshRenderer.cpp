@@ -30,6 +30,8 @@ MeshRenderer::~MeshRenderer()
 void MeshRenderer::Initialize(const std::shared_ptr<Shader>& shader)
 {
     m_Shader = shader;
+    m_ModelLocation = m_Shader->GetUniformLocation("model");
+    m_NormalMatrixLocation = m_Shader->GetUniformLocation("normalMatrix");
     
     // Get the mesh from the resource system
     auto mesh = ResourceSystem::GetInstance().GetMesh(m_MeshHandle);
@@ -50,6 +52,7 @@ void MeshRenderer::Initialize(const std::shared_ptr<Shader>& shader)
         }
         
         m_Buffer.Setup(vertices);
+        UploadLODs(*mesh);
         m_Initialized = true;
     }
     else
@@ -58,43 +61,22 @@ void MeshRenderer::Initialize(const std::shared_ptr<Shader>& shader)
     }
 }
 
-void MeshRenderer::Render(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix)
+void MeshRenderer::Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix)
 {
     if (!m_Initialized || !m_Shader)
         return;
     
-    m_Shader->Use();
-    
-    m_Shader->SetMat4("model", modelMatrix);
-    m_Shader->SetMat4("view", viewMatrix);
-    m_Shader->SetMat4("projection", projectionMatrix);
-    
-    // Save current polygon mode so we can restore it after rendering. This allows
-    // higher-level systems (e.g. a global wireframe toggle) to control the mode
-    // without being overridden by individual renderers.
-    GLint prevPolygonMode[2];
-    glGetIntegerv(GL_POLYGON_MODE, prevPolygonMode);
-
-    // Apply local wireframe setting *only* if this renderer explicitly requests
-    // wireframe drawing. Otherwise, keep the mode that was already active.
-    if (m_Wireframe)
-    {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    }
-    
-    m_Buffer.Bind();
+    m_Shader->SetMat4(m_ModelLocation, modelMatrix);
+    m_Shader->SetMat3(m_NormalMatrixLocation, normalMatrix);
     
     // Always draw as triangles - glPolygonMode handles wireframe conversion
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_Buffer.GetVertexCount()));
-    
-    m_Buffer.Unbind();
-    
-    // Restore previous polygon mode so subsequent renderers keep the expected state
-    glPolygonMode(GL_FRONT_AND_BACK, prevPolygonMode[0]);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(GetActiveBuffer().GetVertexCount()));
 }
 
 void MeshRenderer::CleanUp()
 {
+    m_LODBuffers.clear();
+    m_LODLevel = 0;
     m_Initialized = false;
 }
 
@@ -156,6 +138,58 @@ void MeshRenderer::UpdateVertexColors()
     
     // Update our vertex buffer with the new colored vertices
     m_Buffer.Setup(vertices);
+    UploadLODs(*mesh);
+}
+
+int MeshRenderer::GetLODCount() const
+{
+    return 1 + static_cast<int>(m_LODBuffers.size());
+}
+
+void MeshRenderer::SetLODLevel(int level)
+{
+    m_LODLevel = std::clamp(level, 0, GetLODCount() - 1);
+}
+
+size_t MeshRenderer::GetVertexCount() const
+{
+    return GetActiveBuffer().GetVertexCount();
+}
+
+GLuint MeshRenderer::GetVertexArray() const
+{
+    return GetActiveBuffer().GetVertexArray();
+}
+
+const Buffer& MeshRenderer::GetActiveBuffer() const
+{
+    if (m_LODLevel == 0 || m_LODBuffers.empty())
+        return m_Buffer;
+    
+    return *m_LODBuffers[std::min<size_t>(m_LODLevel, m_LODBuffers.size()) - 1];
+}
+
+void MeshRenderer::UploadLODs(const MeshResource& mesh)
+{
+    m_LODBuffers.clear();
+    
+    for (size_t level = 1; level < mesh.GetLODCount(); ++level)
+    {
+        const auto& lodVertices = mesh.GetLODVertexes(level);
+        
+        std::vector<Vertex> vertices;
+        vertices.reserve(lodVertices.size());
+        for (const auto& vertex : lodVertices)
+        {
+            vertices.emplace_back(vertex.m_Position, m_Color, vertex.m_Normal, vertex.m_UV);
+        }
+        
+        auto buffer = std::make_unique<Buffer>();
+        buffer->Setup(vertices);
+        m_LODBuffers.push_back(std::move(buffer));
+    }
+    
+    m_LODLevel = std::clamp(m_LODLevel, 0, GetLODCount() - 1);
 }
 
  
\ No newline at end of file
@@ -0,0 +1,393 @@
+/**
+ * @file MeshSimplifier.cpp
+ * @brief Implementation of quadric-error edge-collapse mesh simplification.
+ */
+
+#include "MeshSimplifier.hpp"
+#include <cstring>
+
+namespace
+{
+    constexpr int   kMaxPasses        = 64;
+    constexpr float kMinFlipCosine    = 0.2f;   // Reject collapses that rotate a face by more than ~78 degrees
+    constexpr float kDegenerateLength = 1e-12f;
+
+    // Symmetric 4x4 error quadric stored as its upper triangle.
+    struct Quadric
+    {
+        double m[10] = {};
+
+        Quadric() = default;
+
+        // Fundamental quadric of the plane ax + by + cz + d = 0
+        Quadric(double a, double b, double c, double d)
+        {
+            m[0] = a * a; m[1] = a * b; m[2] = a * c; m[3] = a * d;
+                          m[4] = b * b; m[5] = b * c; m[6] = b * d;
+                                        m[7] = c * c; m[8] = c * d;
+                                                      m[9] = d * d;
+        }
+
+        Quadric& operator+=(const Quadric& other)
+        {
+            for (int i = 0; i < 10; ++i)
+                m[i] += other.m[i];
+            return *this;
+        }
+
+        Quadric operator+(const Quadric& other) const
+        {
+            Quadric result = *this;
+            result += other;
+            return result;
+        }
+
+        double Error(const glm::vec3& p) const
+        {
+            const double x = p.x, y = p.y, z = p.z;
+            return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x
+                 + m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y
+                 + m[7] * z * z + 2.0 * m[8] * z
+                 + m[9];
+        }
+    };
+
+    struct SimplifyVertex
+    {
+        glm::vec3 position;
+        Quadric   quadric;
+        uint32_t  source;          // Index of the first input vertex welded into this one
+        bool      border = false;  // Vertices on open edges are never collapsed
+    };
+
+    struct SimplifyTriangle
+    {
+        uint32_t v[3];
+        bool     deleted = false;
+        bool     dirty   = false;  // Modified during the current pass; its edge costs are stale
+    };
+
+    struct EdgeCandidate
+    {
+        double    error;
+        uint32_t  triangle;
+        uint32_t  edge;            // Edge k connects v[k] and v[(k + 1) % 3]
+        glm::vec3 target;
+    };
+
+    struct TriangleRef
+    {
+        uint32_t triangle;
+        uint32_t corner;
+    };
+
+    struct PositionHash
+    {
+        size_t operator()(const glm::vec3& p) const
+        {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            size_t h = bits[0];
+            h = h * 0x9E3779B1u ^ bits[1];
+            h = h * 0x9E3779B1u ^ bits[2];
+            return h;
+        }
+    };
+
+    // Vertex-to-triangle adjacency in compressed (offset + count) form.
+    struct Adjacency
+    {
+        std::vector<uint32_t>    start;
+        std::vector<uint32_t>    count;
+        std::vector<TriangleRef> refs;
+
+        void Build(const std::vector<SimplifyVertex>& vertices, const std::vector<SimplifyTriangle>& triangles)
+        {
+            start.assign(vertices.size(), 0);
+            count.assign(vertices.size(), 0);
+
+            for (const auto& tri : triangles)
+            {
+                if (tri.deleted) continue;
+                for (int k = 0; k < 3; ++k)
+                    ++count[tri.v[k]];
+            }
+
+            uint32_t offset = 0;
+            for (size_t i = 0; i < vertices.size(); ++i)
+            {
+                start[i] = offset;
+                offset += count[i];
+                count[i] = 0;
+            }
+
+            refs.resize(offset);
+            for (uint32_t t = 0; t < triangles.size(); ++t)
+            {
+                const auto& tri = triangles[t];
+                if (tri.deleted) continue;
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    uint32_t v = tri.v[k];
+                    refs[start[v] + count[v]++] = { t, k };
+                }
+            }
+        }
+    };
+
+    glm::vec3 FaceNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+    {
+        return glm::cross(p1 - p0, p2 - p0);
+    }
+
+    // Returns true if moving 'moving' to 'target' would flip or degenerate any face
+    // that survives the collapse of the edge (moving, other).
+    bool CollapseFlipsFaces(uint32_t moving, uint32_t other, const glm::vec3& target,
+                            const std::vector<SimplifyVertex>& vertices,
+                            const std::vector<SimplifyTriangle>& triangles,
+                            const Adjacency& adjacency)
+    {
+        const uint32_t begin = adjacency.start[moving];
+        const uint32_t end   = begin + adjacency.count[moving];
+
+        for (uint32_t r = begin; r < end; ++r)
+        {
+            const auto& ref = adjacency.refs[r];
+            const auto& tri = triangles[ref.triangle];
+            if (tri.deleted) continue;
+
+            const uint32_t i1 = tri.v[(ref.corner + 1) % 3];
+            const uint32_t i2 = tri.v[(ref.corner + 2) % 3];
+
+            // Faces sharing the collapsing edge disappear, so they cannot flip
+            if (i1 == other || i2 == other) continue;
+
+            const glm::vec3& p1 = vertices[i1].position;
+            const glm::vec3& p2 = vertices[i2].position;
+
+            glm::vec3 before = FaceNormal(vertices[moving].position, p1, p2);
+            glm::vec3 after  = FaceNormal(target, p1, p2);
+
+            float lenBefore = glm::length(before);
+            float lenAfter  = glm::length(after);
+            if (lenAfter < kDegenerateLength)
+                return true;
+            if (lenBefore < kDegenerateLength)
+                continue;
+
+            if (glm::dot(before / lenBefore, after / lenAfter) < kMinFlipCosine)
+                return true;
+        }
+
+        return false;
+    }
+}
+
+std::vector<Vertex> SimplifyMeshQuadric(const std::vector<Vertex>& vertices, float targetRatio)
+{
+    if (targetRatio >= 1.0f || vertices.size() < 3)
+        return vertices;
+
+    // Step 1: Weld coincident positions so the triangle soup becomes a connected mesh
+    std::vector<SimplifyVertex> welded;
+    std::vector<SimplifyTriangle> triangles;
+    {
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> lookup;
+        lookup.reserve(vertices.size() / 2);
+
+        std::vector<uint32_t> remap(vertices.size());
+        for (uint32_t i = 0; i < vertices.size(); ++i)
+        {
+            auto [it, inserted] = lookup.try_emplace(vertices[i].m_Position, static_cast<uint32_t>(welded.size()));
+            if (inserted)
+            {
+                SimplifyVertex v;
+                v.position = vertices[i].m_Position;
+                v.source   = i;
+                welded.push_back(v);
+            }
+            remap[i] = it->second;
+        }
+
+        const size_t triangleCount = vertices.size() / 3;
+        triangles.reserve(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            SimplifyTriangle tri;
+            tri.v[0] = remap[t * 3 + 0];
+            tri.v[1] = remap[t * 3 + 1];
+            tri.v[2] = remap[t * 3 + 2];
+
+            // Drop triangles that are already degenerate after welding
+            if (tri.v[0] == tri.v[1] || tri.v[1] == tri.v[2] || tri.v[0] == tri.v[2])
+                continue;
+
+            triangles.push_back(tri);
+        }
+    }
+
+    // Step 2: Accumulate face plane quadrics on vertices and flag open borders
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeUse;
+        edgeUse.reserve(triangles.size() * 2);
+
+        for (const auto& tri : triangles)
+        {
+            const glm::vec3& p0 = welded[tri.v[0]].position;
+            const glm::vec3& p1 = welded[tri.v[1]].position;
+            const glm::vec3& p2 = welded[tri.v[2]].position;
+
+            glm::vec3 n = FaceNormal(p0, p1, p2);
+            float len = glm::length(n);
+            if (len > kDegenerateLength)
+            {
+                n /= len;
+                Quadric q(n.x, n.y, n.z, -glm::dot(n, p0));
+                for (int k = 0; k < 3; ++k)
+                    welded[tri.v[k]].quadric += q;
+            }
+
+            for (int k = 0; k < 3; ++k)
+            {
+                uint64_t a = tri.v[k];
+                uint64_t b = tri.v[(k + 1) % 3];
+                if (a > b) std::swap(a, b);
+                ++edgeUse[(a << 32) | b];
+            }
+        }
+
+        for (const auto& [key, uses] : edgeUse)
+        {
+            if (uses != 1) continue;
+            welded[static_cast<uint32_t>(key >> 32)].border        = true;
+            welded[static_cast<uint32_t>(key & 0xFFFFFFFFu)].border = true;
+        }
+    }
+
+    // Step 3: Collapse the cheapest edges pass by pass until the target is reached
+    size_t liveTriangles = triangles.size();
+    const size_t targetTriangles = std::max<size_t>(1, static_cast<size_t>(liveTriangles * targetRatio));
+
+    Adjacency adjacency;
+    std::vector<EdgeCandidate> candidates;
+
+    for (int pass = 0; pass < kMaxPasses && liveTriangles > targetTriangles; ++pass)
+    {
+        adjacency.Build(welded, triangles);
+
+        candidates.clear();
+        for (uint32_t t = 0; t < triangles.size(); ++t)
+        {
+            auto& tri = triangles[t];
+            if (tri.deleted) continue;
+            tri.dirty = false;
+
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                uint32_t a = tri.v[k];
+                uint32_t b = tri.v[(k + 1) % 3];
+
+                // Interior edges are shared by two faces; evaluate each only once
+                if (a > b) continue;
+                if (welded[a].border || welded[b].border) continue;
+
+                Quadric q = welded[a].quadric + welded[b].quadric;
+
+                const glm::vec3 options[3] =
+                {
+                    welded[a].position,
+                    welded[b].position,
+                    (welded[a].position + welded[b].position) * 0.5f
+                };
+
+                EdgeCandidate best{ q.Error(options[0]), t, k, options[0] };
+                for (int i = 1; i < 3; ++i)
+                {
+                    double error = q.Error(options[i]);
+                    if (error < best.error)
+                    {
+                        best.error  = error;
+                        best.target = options[i];
+                    }
+                }
+                candidates.push_back(best);
+            }
+        }
+
+        if (candidates.empty())
+            break;
+
+        // Each collapse removes about two faces; only order as many edges as we could use
+        size_t wanted = (liveTriangles - targetTriangles) / 2 + 1;
+        size_t limit  = std::min(candidates.size(), wanted * 2);
+        auto byError = [](const EdgeCandidate& l, const EdgeCandidate& r) { return l.error < r.error; };
+        std::nth_element(candidates.begin(), candidates.begin() + (limit - 1), candidates.end(), byError);
+        std::sort(candidates.begin(), candidates.begin() + limit, byError);
+
+        size_t collapsed = 0;
+        for (size_t c = 0; c < limit && liveTriangles > targetTriangles; ++c)
+        {
+            const EdgeCandidate& candidate = candidates[c];
+            const auto& tri = triangles[candidate.triangle];
+            if (tri.deleted || tri.dirty) continue;
+
+            uint32_t a = tri.v[candidate.edge];
+            uint32_t b = tri.v[(candidate.edge + 1) % 3];
+
+            if (CollapseFlipsFaces(a, b, candidate.target, welded, triangles, adjacency) ||
+                CollapseFlipsFaces(b, a, candidate.target, welded, triangles, adjacency))
+                continue;
+
+            // Collapse b into a
+            welded[a].position = candidate.target;
+            welded[a].quadric += welded[b].quadric;
+
+            for (uint32_t r = adjacency.start[a]; r < adjacency.start[a] + adjacency.count[a]; ++r)
+            {
+                auto& adj = triangles[adjacency.refs[r].triangle];
+                if (adj.deleted) continue;
+
+                if (adj.v[0] == b || adj.v[1] == b || adj.v[2] == b)
+                {
+                    adj.deleted = true;
+                    --liveTriangles;
+                }
+                else
+                {
+                    adj.dirty = true;
+                }
+            }
+
+            for (uint32_t r = adjacency.start[b]; r < adjacency.start[b] + adjacency.count[b]; ++r)
+            {
+                auto& adj = triangles[adjacency.refs[r].triangle];
+                if (adj.deleted) continue;
+
+                adj.v[adjacency.refs[r].corner] = a;
+                adj.dirty = true;
+            }
+
+            ++collapsed;
+        }
+
+        if (collapsed == 0)
+            break;
+    }
+
+    // Step 4: Expand back into a triangle list, keeping the attributes of the welded source vertex
+    std::vector<Vertex> result;
+    result.reserve(liveTriangles * 3);
+    for (const auto& tri : triangles)
+    {
+        if (tri.deleted) continue;
+        for (int k = 0; k < 3; ++k)
+        {
+            const SimplifyVertex& v = welded[tri.v[k]];
+            Vertex out = vertices[v.source];
+            out.m_Position = v.position;
+            result.push_back(out);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file NullRenderable.cpp
+ * @brief Implementation of the headless renderable that only records draws.
+ */
+
+#include "NullRenderable.hpp"
+
+NullRenderable::NullRenderable(const ResourceHandle& meshHandle)
+{
+    auto mesh = ResourceSystem::GetInstance().GetMesh(meshHandle);
+    if (mesh)
+    {
+        for (size_t level = 0; level < mesh->GetLODCount(); ++level)
+        {
+            m_LODVertexCounts.push_back(mesh->GetLODVertexes(level).size());
+        }
+    }
+    else
+    {
+        std::cerr << "NullRenderable: Invalid mesh handle" << std::endl;
+    }
+    
+    if (m_LODVertexCounts.empty())
+    {
+        m_LODVertexCounts.push_back(0);
+    }
+}
+
+NullRenderable::NullRenderable(size_t vertexCount)
+    : m_LODVertexCounts{ vertexCount }
+{
+}
+
+void NullRenderable::Initialize(const std::shared_ptr<Shader>& shader)
+{
+    m_Shader = shader;
+}
+
+void NullRenderable::Render(const glm::mat4& modelMatrix, const glm::mat3& normalMatrix)
+{
+    ++m_DrawCount;
+    m_SubmittedVertexCount += GetVertexCount();
+}
+
+void NullRenderable::SetLODLevel(int level)
+{
+    m_LODLevel = std::clamp(level, 0, GetLODCount() - 1);
+}
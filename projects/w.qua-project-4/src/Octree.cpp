@@ -1,6 +1,8 @@
 #include "Octree.hpp"
 #include "Geometry.hpp"  
 #include "SpatialTreeUtils.hpp"
+#include "Profiler.hpp"
+#include "JobSystem.hpp"
 
 Octree::Octree(Registry& registry, int maxObjectsPerCell, StraddlingMethod method, int maxDepth)
     : m_Registry(registry),
@@ -10,11 +12,29 @@ Octree::Octree(Registry& registry, int maxObjectsPerCell, StraddlingMethod metho
 {
 }
 
+namespace
+{
+    // Subtrees over at least this many entities are built as separate jobs
+    constexpr size_t kParallelSubtreeEntities = 2048;
+    // Entities per job when classifying a large range
+    constexpr size_t kClassifyGrain = 16384;
+    // Partition group of objects that stay in the node itself
+    constexpr uint8_t kStayGroup = 8;
+
+    glm::vec3 ChildCenter(const glm::vec3& center, float childHalf, int childIndex)
+    {
+        return center + glm::vec3(
+            (childIndex & 1) ? childHalf : -childHalf,
+            (childIndex & 2) ? childHalf : -childHalf,
+            (childIndex & 4) ? childHalf : -childHalf);
+    }
+}
+
 void Octree::GetChildIndex(const TreeNode* pNode,
                        const glm::vec3& objCenter,
                        const glm::vec3& objExtents,
                        int& outIndex,
-                       bool& outStraddle)
+                       bool& outStraddle) const
 {
     outStraddle = false;
     outIndex    = 0;
@@ -36,130 +56,172 @@ void Octree::GetChildIndex(const TreeNode* pNode,
     }
 }
 
-void Octree::DistributeObjectsToChildren(const TreeNode* pNode,
-                                         const std::vector<Registry::Entity>& entities,
-                                         std::vector<Registry::Entity> childEntities[8],
-                                         std::vector<Registry::Entity>& straddlingEntities)
+void Octree::PartitionObjects(const TreeNode* pNode, size_t begin, size_t end, std::array<size_t, 10>& outRanges)
 {
-    straddlingEntities.clear();
-    for (int i = 0; i < 8; ++i)
-        childEntities[i].clear();
+    SpatialTreeUtils::ForEachChunk(m_ParallelBuild, end - begin, kClassifyGrain, [&](size_t first, size_t last)
+    {
+        for (size_t i = begin + first; i < begin + last; ++i)
+        {
+            Aabb worldAabb = m_Snapshot->GetBounds(m_Order[i]);
+
+            int childIdx;
+            bool straddle;
+            GetChildIndex(pNode, worldAabb.GetCenter(), worldAabb.GetExtents(), childIdx, straddle);
 
-    for (auto entity : entities)
+            // UseCenter places straddling objects in the child containing their centre
+            bool stay = straddle && m_Method == StraddlingMethod::StayAtCurrentLevel;
+            m_Buckets[i] = stay ? kStayGroup : static_cast<uint8_t>(childIdx);
+        }
+    });
+
+    // Stable counting sort of the range through the scratch buffer
+    std::array<size_t, 9> counts{};
+    for (size_t i = begin; i < end; ++i)
     {
-        auto& t  = m_Registry.GetComponent<TransformComponent>(entity);
-        auto& bc = m_Registry.GetComponent<BoundingComponent>(entity);
-        Aabb worldAabb = bc.GetAABB();
-        worldAabb.Transform(t.m_Model);
+        ++counts[m_Buckets[i]];
+    }
 
-        glm::vec3 objCenter  = worldAabb.GetCenter();
-        glm::vec3 objExtents = worldAabb.GetExtents();
+    outRanges[0] = begin;
+    outRanges[1] = begin + counts[kStayGroup];
+    for (int c = 0; c < 8; ++c)
+    {
+        outRanges[c + 2] = outRanges[c + 1] + counts[c];
+    }
 
-        int childIdx;
-        bool straddle;
-        GetChildIndex(pNode, objCenter, objExtents, childIdx, straddle);
+    std::array<size_t, 9> cursors;
+    cursors[kStayGroup] = outRanges[0];
+    for (int c = 0; c < 8; ++c)
+    {
+        cursors[c] = outRanges[c + 1];
+    }
 
-        if (straddle)
-        {
-            switch (m_Method)
-            {
-                case StraddlingMethod::UseCenter:
-                    // Place in child containing center (default check)
-                    childEntities[childIdx].push_back(entity);
-                    break;
-                    
-                case StraddlingMethod::StayAtCurrentLevel:
-                    // Keep at current level
-                    straddlingEntities.push_back(entity);
-                    break;
-            }
-        }
-        else
-        {
-            // Object fits in one child
-            childEntities[childIdx].push_back(entity);
-        }
+    for (size_t i = begin; i < end; ++i)
+    {
+        m_Scratch[cursors[m_Buckets[i]]++] = m_Order[i];
     }
+    std::copy(m_Scratch.begin() + begin, m_Scratch.begin() + end, m_Order.begin() + begin);
 }
 
-std::unique_ptr<TreeNode> Octree::BuildOctree(const glm::vec3& center, float halfWidth, 
-                                                      const std::vector<Registry::Entity>& entities, int level)
+// Resolves the node's range to entities and bounds them together with the non-empty children
+void Octree::FinishNode(TreeNode& node, size_t begin, size_t end)
 {
-    auto node = std::make_unique<TreeNode>(center, halfWidth, level);
+    node.contentBounds = SpatialTreeUtils::EmptyBounds();
+    for (size_t i = begin; i < end; ++i)
+    {
+        m_Entities[i] = m_Snapshot->GetEntity(m_Order[i]);
+        SpatialTreeUtils::Expand(node.contentBounds, m_Snapshot->GetBounds(m_Order[i]));
+    }
+    node.pObjects = std::span<const Registry::Entity>(m_Entities.data() + begin, end - begin);
+
+    for (const TreeNode* child : node.children)
+    {
+        if (child && !SpatialTreeUtils::IsEmpty(child->contentBounds))
+            SpatialTreeUtils::Expand(node.contentBounds, child->contentBounds);
+    }
+}
+
+TreeNode* Octree::BuildOctree(std::deque<TreeNode>& arena, const glm::vec3& center, float halfWidth,
+                              size_t begin, size_t end, int level)
+{
+    TreeNode& node = arena.emplace_back(center, halfWidth, level);
+    const size_t count = end - begin;
 
     bool shouldTerminate =
                            level >= m_MaxDepth ||
-                           static_cast<int>(entities.size()) <= m_MaxObjects ||
-                           entities.empty();
+                           static_cast<int>(count) <= m_MaxObjects ||
+                           count == 0;
 
     if (shouldTerminate)
     {
-        node->pObjects = entities;
-        return node;
+        FinishNode(node, begin, end);
+        return &node;
     }
 
-    std::vector<Registry::Entity> childEntities[8];
-    std::vector<Registry::Entity> straddlingEntities;
-    
-    DistributeObjectsToChildren(node.get(), entities, childEntities, straddlingEntities);
-    
-    node->pObjects = straddlingEntities;
-    
-    int totalChildObjects = 0;
-    for (int i = 0; i < 8; ++i)
+    std::array<size_t, 10> ranges;
+    PartitionObjects(&node, begin, end, ranges);
+
+    // Every object stays here; the partition kept them in order
+    if (ranges[1] == end)
     {
-        totalChildObjects += static_cast<int>(childEntities[i].size());
+        FinishNode(node, begin, end);
+        return &node;
     }
-    
-    if (totalChildObjects == 0)
+
+    // Create children only if they have objects. Large ones become jobs with their own
+    // arena; the rest are built here, after the forks so the jobs start early
+    JobSystem& jobs = JobSystem::Get();
+    JobCounter subtrees;
+    std::array<bool, 8> isJob{};
+    for (int i = 0; i < 8; ++i)
     {
-        node->pObjects = entities;
-        return node;
+        size_t childBegin = ranges[i + 1];
+        size_t childEnd   = ranges[i + 2];
+        isJob[i] = m_ParallelBuild && childEnd - childBegin >= kParallelSubtreeEntities;
+        if (isJob[i])
+        {
+            jobs.Run(subtrees, [this, &node, i, childBegin, childEnd]()
+            {
+                float half = node.halfwidth * 0.5f;
+                node.children[i] = BuildOctree(m_NodeArenas.Acquire(), ChildCenter(node.center, half, i), half,
+                                               childBegin, childEnd, node.level + 1);
+            });
+        }
     }
 
-
-    // Create children only if they have objects
     float childHalf = halfWidth * 0.5f;
     for (int i = 0; i < 8; ++i)
     {
-        if (!childEntities[i].empty())
+        size_t childBegin = ranges[i + 1];
+        size_t childEnd   = ranges[i + 2];
+        if (childBegin != childEnd && !isJob[i])
         {
-            glm::vec3 offset(
-                (i & 1) ? childHalf : -childHalf,
-                (i & 2) ? childHalf : -childHalf,
-                (i & 4) ? childHalf : -childHalf);
-            glm::vec3 childCenter = center + offset;
-            
-            node->children[i] = BuildOctree(childCenter, childHalf, 
-                                                   childEntities[i], level + 1);
+            node.children[i] = BuildOctree(arena, ChildCenter(center, childHalf, i), childHalf,
+                                           childBegin, childEnd, level + 1);
         }
     }
+    jobs.Wait(subtrees);
 
-    return node;
+    FinishNode(node, ranges[0], ranges[1]);
+    return &node;
 }
 
 void Octree::Build()
 {
-    if (!m_Dirty) return;
+    bool snapshotChanged = m_SharedSnapshot && m_SharedSnapshot->GetVersion() != m_SnapshotVersion;
+    if (!m_Dirty && !snapshotChanged) return;
+    PROFILE_SCOPE("Octree::Build");
 
-    m_Root.reset();
+    m_Root = nullptr;
+    m_NodeArenas.Clear();
 
-    Aabb rootBounds(glm::vec3(0.0f), 1.0f);
-    SpatialTreeUtils::ComputeSceneBounds(m_Registry, rootBounds);
+    if (m_SharedSnapshot)
+    {
+        m_Snapshot = m_SharedSnapshot;
+    }
+    else
+    {
+        m_OwnSnapshot.Build(m_Registry, m_ParallelBuild);
+        m_Snapshot = &m_OwnSnapshot;
+    }
+    m_SnapshotVersion = m_Snapshot->GetVersion();
 
+    const Aabb& rootBounds = m_Snapshot->GetSceneBounds();
     glm::vec3 center = rootBounds.GetCenter();
     float halfWidth  = rootBounds.GetExtents().x;
 
-    std::vector<Registry::Entity> allEntities;
-    auto view = m_Registry.View<TransformComponent, BoundingComponent>();
-    for (auto entity : view)
+    const size_t count = m_Snapshot->GetCount();
+    m_Order.resize(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        allEntities.push_back(entity);
+        m_Order[i] = static_cast<uint32_t>(i);
     }
+    m_Scratch.resize(count);
+    m_Buckets.resize(count);
+    m_Entities.resize(count);
 
-    if (!allEntities.empty())
+    if (count > 0)
     {
-        m_Root = BuildOctree(center, halfWidth, allEntities, 0);
+        m_Root = BuildOctree(m_NodeArenas.Acquire(), center, halfWidth, 0, count, 0);
     }
 
     m_Dirty = false;
@@ -171,22 +233,22 @@ static void GatherTreeNodes(TreeNode* node, std::vector<TreeNode*>& out)
     
     out.push_back(node);
     
-    for (auto& childPtr : node->children)
+    for (TreeNode* child : node->children)
     {
-        GatherTreeNodes(childPtr.get(), out);
+        GatherTreeNodes(child, out);
     }
 }
 
-void Octree::CollectRenderables(const std::shared_ptr<Shader>& shader,
-                                std::vector<std::shared_ptr<CubeRenderer>>& out)
+void Octree::CollectRenderables(InstancedPrimitiveRenderer& out)
 {
     Build(); 
-    out.clear();
+    PROFILE_SCOPE("Octree::CollectRenderables");
+    out.ClearInstances();
 
     if (!m_Root) return;
 
     std::vector<TreeNode*> nodes;
-    GatherTreeNodes(m_Root.get(), nodes);
+    GatherTreeNodes(m_Root, nodes);
 
     for (TreeNode* node : nodes)
     {
@@ -195,13 +257,108 @@ void Octree::CollectRenderables(const std::shared_ptr<Shader>& shader,
         
         glm::vec3 color = SpatialTreeUtils::LevelColor(node->level);
 
-        auto cube = std::make_shared<CubeRenderer>(center, size, color, true /*wireframe*/);
-        cube->Initialize(shader);
-        out.push_back(std::move(cube));
+        out.AddInstance(InstancedPrimitiveRenderer::BoxTransform(center, size), color);
     }
 } 
 
 const TreeNode* Octree::GetRoot() const
 {
-    return m_Root.get();
-} 
\ No newline at end of file
+    return m_Root;
+}
+
+void Octree::QueryFrustum(const glm::vec3 planeNormals[6], const float planeDistances[6],
+                          std::vector<Registry::Entity>& out)
+{
+    Build();
+
+    SpatialQueryStats* stats = m_QueryStatsEnabled ? &m_QueryStats : nullptr;
+    size_t firstResult = out.size();
+    if (m_Root)
+    {
+        QueryFrustumNode(m_Root, planeNormals, planeDistances, out, stats);
+    }
+
+    if (stats)
+    {
+        ++stats->m_Queries;
+        stats->m_Results += out.size() - firstResult;
+    }
+}
+
+static void AppendSubtree(const TreeNode* node, std::vector<Registry::Entity>& out)
+{
+    out.insert(out.end(), node->pObjects.begin(), node->pObjects.end());
+    for (const TreeNode* child : node->children)
+    {
+        if (child)
+            AppendSubtree(child, out);
+    }
+}
+
+void Octree::QueryFrustumNode(const TreeNode* pNode,
+                              const glm::vec3 planeNormals[6], const float planeDistances[6],
+                              std::vector<Registry::Entity>& out, SpatialQueryStats* stats)
+{
+    if (SpatialTreeUtils::IsEmpty(pNode->contentBounds))
+        return;
+
+    if (stats) ++stats->m_NodesVisited;
+    SideResult side = SpatialTreeUtils::ClassifyFrustumAabb(planeNormals, planeDistances, pNode->contentBounds);
+    if (side == SideResult::eOUTSIDE)
+    {
+        if (stats) ++stats->m_CulledSubtrees;
+        return;
+    }
+    if (side == SideResult::eINSIDE)
+    {
+        // The content box is inside, so the whole subtree is emitted without testing its objects
+        if (stats) ++stats->m_AcceptedSubtrees;
+        AppendSubtree(pNode, out);
+        return;
+    }
+
+    // The node's objects are a range of m_Entities, whose positions match m_Order
+    const size_t first = static_cast<size_t>(pNode->pObjects.data() - m_Entities.data());
+    for (size_t i = 0; i < pNode->pObjects.size(); ++i)
+    {
+        if (stats) ++stats->m_PrimitivesTested;
+        Aabb box = m_Snapshot->GetBounds(m_Order[first + i]);
+        if (SpatialTreeUtils::ClassifyFrustumAabb(planeNormals, planeDistances, box) != SideResult::eOUTSIDE)
+        {
+            out.push_back(pNode->pObjects[i]);
+        }
+    }
+
+    for (const TreeNode* child : pNode->children)
+    {
+        if (child)
+            QueryFrustumNode(child, planeNormals, planeDistances, out, stats);
+    }
+}
+
+static void AccumulateTreeStats(const TreeNode* node, SpatialTreeStats& stats)
+{
+    bool leaf = true;
+    for (const TreeNode* child : node->children)
+    {
+        if (child)
+        {
+            leaf = false;
+            AccumulateTreeStats(child, stats);
+        }
+    }
+
+    size_t bytes = sizeof(TreeNode) + node->pObjects.size() * sizeof(Registry::Entity);
+    stats.AddNode(static_cast<size_t>(node->level), leaf, node->pObjects.size(), bytes);
+}
+
+SpatialTreeStats Octree::GetStats() const
+{
+    SpatialTreeStats stats;
+    if (m_Root)
+    {
+        AccumulateTreeStats(m_Root, stats);
+    }
+    stats.m_Queries = m_QueryStats;
+    return stats;
+}
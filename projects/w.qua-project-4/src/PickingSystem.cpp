@@ -8,6 +8,7 @@
 #include "Keybinds.hpp"
 #include "InputSystem.hpp"
 #include "EventSystem.hpp"
+#include "Profiler.hpp"
 
 using namespace Systems; // For accessing global systems
 
@@ -35,6 +36,7 @@ PickingSystem::PickingSystem(Registry& registry, Window& window)
 //------------------------------------------------------------------------------
 Registry::Entity PickingSystem::Pick(const glm::vec2& screenPos)
 {
+    PROFILE_SCOPE("PickingSystem::Pick");
     // Convert screen coordinates to world ray
     Ray ray = ScreenToWorldRay(screenPos);
 
@@ -316,6 +318,7 @@ void PickingSystem::HandleMouseMove(const EventData& eventData)
     if (m_DraggingEntity == entt::null)
         return;
 
+    PROFILE_SCOPE("PickingSystem::Drag");
     glm::vec2 screenPos = std::get<glm::vec2>(eventData);
 
     Ray ray = ScreenToWorldRay(screenPos);
@@ -327,8 +330,6 @@ void PickingSystem::HandleMouseMove(const EventData& eventData)
         auto& transform = m_Registry.GetComponent<TransformComponent>(m_DraggingEntity);
         transform.m_Position = worldPos;
         transform.UpdateModelMatrix();
-
-        // Notify systems of transform change for this entity
-        EventSystem::Get().FireEvent(EventType::TransformChanged, m_DraggingEntity);
+        m_Registry.MarkChanged<TransformComponent>(m_DraggingEntity);
     }
 } 
\ No newline at end of file
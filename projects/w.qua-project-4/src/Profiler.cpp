@@ -0,0 +1,202 @@
+/**
+ * @file Profiler.cpp
+ * @brief Implementation of the scoped CPU frame profiler.
+ */
+
+#include "Profiler.hpp"
+#include "TraceRecorder.hpp"
+
+Profiler& Profiler::Get()
+{
+    // Function-local static so worker threads can reach it safely during start-up
+    static Profiler s_Instance;
+    return s_Instance;
+}
+
+Profiler::Profiler()
+    : m_Epoch(std::chrono::steady_clock::now())
+{
+}
+
+uint64_t Profiler::Now() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_Epoch).count());
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBuffer* t_Buffer = nullptr;
+    if (!t_Buffer)
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->m_Index = static_cast<uint32_t>(m_Threads.size());
+        buffer->m_Name  = "Thread " + std::to_string(buffer->m_Index);
+        t_Buffer = buffer.get();
+        m_Threads.push_back(std::move(buffer));
+    }
+    return *t_Buffer;
+}
+
+void Profiler::SetThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+    buffer.m_Name = name;
+}
+
+std::vector<std::string> Profiler::GetThreadNames() const
+{
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+    std::vector<std::string> names;
+    names.reserve(m_Threads.size());
+    for (const auto& buffer : m_Threads)
+    {
+        names.push_back(buffer->m_Name);
+    }
+    return names;
+}
+
+void Profiler::BeginZone(const char* name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    buffer.m_Open.emplace_back(name, Now());
+}
+
+void Profiler::EndZone()
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    if (buffer.m_Open.empty())
+        return;
+
+    uint64_t endNs = Now();
+    auto [name, startNs] = buffer.m_Open.back();
+    buffer.m_Open.pop_back();
+
+    std::lock_guard<std::mutex> lock(buffer.m_Mutex);
+    buffer.m_Completed.push_back({ name, startNs, endNs, buffer.m_Index, static_cast<uint32_t>(buffer.m_Open.size()) });
+}
+
+void Profiler::RecordCounter(const char* name, double value)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    uint64_t timeNs = Now();
+
+    std::lock_guard<std::mutex> lock(buffer.m_Mutex);
+    buffer.m_Counters.push_back({ name, timeNs, value });
+}
+
+void Profiler::BeginFrame()
+{
+    m_FrameStartNs = Now();
+}
+
+void Profiler::EndFrame()
+{
+    ProfileFrame frame;
+    frame.m_Index   = m_FrameIndex++;
+    frame.m_StartNs = m_FrameStartNs;
+    frame.m_EndNs   = Now();
+
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        for (auto& buffer : m_Threads)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->m_Mutex);
+            frame.m_Zones.insert(frame.m_Zones.end(), buffer->m_Completed.begin(), buffer->m_Completed.end());
+            frame.m_Counters.insert(frame.m_Counters.end(), buffer->m_Counters.begin(), buffer->m_Counters.end());
+            buffer->m_Completed.clear();
+            buffer->m_Counters.clear();
+        }
+    }
+
+    if (!IsEnabled())
+        return;
+
+    std::sort(frame.m_Zones.begin(), frame.m_Zones.end(),
+              [](const ProfileZoneRecord& a, const ProfileZoneRecord& b) { return a.m_StartNs < b.m_StartNs; });
+
+    // The trace ring keeps recording while the in-app history is paused
+    TraceRecorder::Get().AddFrame(frame);
+    if (m_Paused)
+        return;
+
+    m_History.push_back(std::move(frame));
+    while (m_History.size() > m_HistorySize)
+    {
+        m_History.pop_front();
+    }
+}
+
+void Profiler::SetHistorySize(size_t frames)
+{
+    m_HistorySize = std::max<size_t>(frames, 1);
+    while (m_History.size() > m_HistorySize)
+    {
+        m_History.pop_front();
+    }
+}
+
+void Profiler::ClearHistory()
+{
+    m_History.clear();
+}
+
+std::vector<ProfileZoneStats> Profiler::ComputeZoneStats() const
+{
+    struct Samples
+    {
+        std::vector<double> m_FrameMs;
+        size_t m_Calls = 0;
+    };
+
+    // Names are compared by content; equal literals in different files may not share an address
+    std::map<std::string, Samples> samplesByName;
+    std::map<std::string, double> frameTotals;
+    for (const ProfileFrame& frame : m_History)
+    {
+        frameTotals.clear();
+        for (const ProfileZoneRecord& zone : frame.m_Zones)
+        {
+            frameTotals[zone.m_Name] += static_cast<double>(zone.m_EndNs - zone.m_StartNs) * 1e-6;
+            ++samplesByName[zone.m_Name].m_Calls;
+        }
+        for (const auto& [name, ms] : frameTotals)
+        {
+            samplesByName[name].m_FrameMs.push_back(ms);
+        }
+    }
+
+    auto percentile = [](const std::vector<double>& sorted, double p)
+    {
+        size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    };
+
+    std::vector<ProfileZoneStats> stats;
+    stats.reserve(samplesByName.size());
+    for (auto& [name, samples] : samplesByName)
+    {
+        std::vector<double>& ms = samples.m_FrameMs;
+        std::sort(ms.begin(), ms.end());
+
+        ProfileZoneStats zone;
+        zone.m_Name          = name;
+        zone.m_Frames        = ms.size();
+        zone.m_CallsPerFrame = static_cast<double>(samples.m_Calls) / static_cast<double>(ms.size());
+        double total = 0.0;
+        for (double v : ms)
+            total += v;
+        zone.m_AverageMs = total / static_cast<double>(ms.size());
+        zone.m_P50Ms     = percentile(ms, 0.50);
+        zone.m_P95Ms     = percentile(ms, 0.95);
+        zone.m_P99Ms     = percentile(ms, 0.99);
+        zone.m_MaxMs     = ms.back();
+        stats.push_back(std::move(zone));
+    }
+
+    std::sort(stats.begin(), stats.end(),
+              [](const ProfileZoneStats& a, const ProfileZoneStats& b) { return a.m_AverageMs > b.m_AverageMs; });
+    return stats;
+}
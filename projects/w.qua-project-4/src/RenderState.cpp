@@ -0,0 +1,82 @@
+/**
+ * @file RenderState.cpp
+ * @brief Implementation of the GL render state cache and draw list merging.
+ */
+
+#include "RenderState.hpp"
+#include "JobSystem.hpp"
+
+void RenderStateCache::Invalidate()
+{
+    m_Program     = kUnknownObject;
+    m_VertexArray = kUnknownObject;
+    m_PolygonMode = kUnknownMode;
+}
+
+void RenderStateCache::ResetStats()
+{
+    m_Stats = RenderStateStats();
+}
+
+void RenderStateCache::UseProgram(GLuint program)
+{
+    if (program == m_Program)
+        return;
+
+    if (!m_NullBackend)
+        glUseProgram(program);
+    m_Program = program;
+    ++m_Stats.m_ProgramChanges;
+}
+
+void RenderStateCache::BindVertexArray(GLuint vertexArray)
+{
+    if (vertexArray == m_VertexArray)
+        return;
+
+    if (!m_NullBackend)
+        glBindVertexArray(vertexArray);
+    m_VertexArray = vertexArray;
+    ++m_Stats.m_VertexArrayChanges;
+}
+
+void RenderStateCache::SetPolygonMode(GLenum mode)
+{
+    if (mode == m_PolygonMode)
+        return;
+
+    if (!m_NullBackend)
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+    m_PolygonMode = mode;
+    ++m_Stats.m_PolygonModeChanges;
+}
+
+void MergeDrawRuns(std::vector<DrawItem>& draws, std::vector<size_t>& runOffsets)
+{
+    while (runOffsets.size() > 2)
+    {
+        const size_t runCount = runOffsets.size() - 1;
+        JobSystem::Get().ParallelFor(runCount / 2, 1, [&](size_t begin, size_t end)
+        {
+            for (size_t pair = begin; pair < end; ++pair)
+            {
+                auto first = draws.begin();
+                std::inplace_merge(first + runOffsets[pair * 2],
+                                   first + runOffsets[pair * 2 + 1],
+                                   first + runOffsets[pair * 2 + 2]);
+            }
+        });
+
+        // Every other boundary disappears; an odd last run carries over to the next level
+        size_t kept = 0;
+        for (size_t i = 0; i <= runCount; i += 2)
+        {
+            runOffsets[kept++] = runOffsets[i];
+        }
+        if (runCount % 2 == 1)
+        {
+            runOffsets[kept++] = runOffsets[runCount];
+        }
+        runOffsets.resize(kept);
+    }
+}
@@ -21,10 +21,54 @@
 #include "Keybinds.hpp"
 #include "Octree.hpp"
 #include "KDTree.hpp"
+#include "MeshRenderer.hpp"
+#include "MeshArena.hpp"
+#include "IndirectDrawBatch.hpp"
+#include "NullRenderable.hpp"
+#include "Profiler.hpp"
+#include "SpatialTreeUtils.hpp"
+#include "JobSystem.hpp"
+#include <atomic>
+
+// Vertex shader used for meshes batched into the multi-draw indirect call
+static const char* kIndirectVertexShaderPath = "../projects/w.qua-project-4/shaders/my-project-4-indirect.vert";
+static const char* kIndirectFragmentShaderPath = "../projects/w.qua-project-4/shaders/my-project-4.frag";
+
+// Vertex shader used for instanced bounding volumes and tree cells
+static const char* kInstancedVertexShaderPath = "../projects/w.qua-project-4/shaders/my-project-4-instanced.vert";
+
+// Uniform block binding points shared by every shader program
+static constexpr GLuint kLightBlockBinding    = 0;
+static constexpr GLuint kMaterialBlockBinding = 1;
+static constexpr GLuint kCameraBlockBinding   = 2;
+
+// Neutral colour shared by every bounding volume instance
+static const glm::vec3 kBoundingVolumeColor = glm::vec3(1.0f);
+
+// Render-view entities per culling job
+static constexpr size_t kCullGrain = 4096;
+
+// Visible entities per draw recording job, each with a command list of its own
+static constexpr size_t kRecordGrain = 2048;
+
+// Cull result bits of each render-view entity
+static constexpr uint8_t kCullDraw      = 1 << 0; // Handed to the submit pass
+static constexpr uint8_t kCullInFrustum = 1 << 1; // Inside or overlapping the frustum
 
 RenderSystem::RenderSystem(Registry& registry, Window& window, const std::shared_ptr<Shader>& shader)
-    : m_Registry(registry), m_Window(window), m_Shader(shader), m_GlobalWireframe(false)
+    : m_Registry(registry), m_Window(window), m_Shader(shader), m_GlobalWireframe(false),
+      m_MeshArena(std::make_unique<MeshArena>()), m_IndirectBatch(std::make_unique<IndirectDrawBatch>()),
+      m_Headless(window.IsHeadless())
 {
+    m_StateCache.SetNullBackend(m_Headless);
+    m_SnapshotChanges = m_Registry.RegisterChangeConsumer();
+
+    m_OctreeCells     = std::make_unique<InstancedPrimitiveRenderer>(PrimitiveShape::Cube);
+    m_KDTreeCells     = std::make_unique<InstancedPrimitiveRenderer>(PrimitiveShape::Cube);
+    m_AABBInstances   = std::make_unique<InstancedPrimitiveRenderer>(PrimitiveShape::Cube);
+    m_OBBInstances    = std::make_unique<InstancedPrimitiveRenderer>(PrimitiveShape::Cube);
+    m_SphereInstances = std::make_unique<InstancedPrimitiveRenderer>(PrimitiveShape::Sphere);
+
     window.SetFramebufferSizeCallback([](int width, int height)
         {
         glViewport(0, 0, width, height);
@@ -42,24 +86,33 @@ RenderSystem::RenderSystem(Registry& registry, Window& window, const std::shared
         }
     });
 
-    EventSystem::Get().SubscribeToEvent(EventType::TransformChanged, [this](const EventData& eventData)
+    EventSystem::Get().Subscribe<SceneResetEvent>([this](const SceneResetEvent&)
         {
-            m_OctreeDirty = true;
-            m_KDTreeDirty = true;
+            m_SpatialSnapshotDirty = true;
         });
+}
 
-    EventSystem::Get().SubscribeToEvent(EventType::SceneReset, [this](const EventData&)
-        {
-            m_OctreeDirty = true;
-            m_KDTreeDirty = true;
-        });
+RenderSystem::~RenderSystem()
+{
+    m_Registry.UnregisterChangeConsumer(m_SnapshotChanges);
+}
+
+std::shared_ptr<IRenderable> RenderSystem::CreateMeshRenderable(const ResourceHandle& meshHandle, const glm::vec3& color) const
+{
+    if (m_Headless)
+    {
+        return std::make_shared<NullRenderable>(meshHandle);
+    }
+    return std::make_shared<MeshRenderer>(meshHandle, color);
 }
 
 void RenderSystem::BuildOctree()
 {
+    PROFILE_SCOPE("RenderSystem::BuildOctree");
     if (!m_Octree)
     {
         m_Octree = std::make_unique<Octree>(m_Registry, m_OctreeMaxObjects, m_StradMethod, m_OctreeMaxDepth);
+        m_Octree->SetSnapshot(&m_SpatialSnapshot);
     }
     else
     {
@@ -70,17 +123,42 @@ void RenderSystem::BuildOctree()
 
     m_Octree->MarkDirty(); // ensure rebuild
     m_Octree->Build();
+    m_Octree->SetQueryStatsEnabled(m_MeasureSpatialQueries);
+    m_Octree->ResetQueryStats(); // counters describe the current settings only
 
-    m_OctreeRenderables.clear();
-    m_Octree->CollectRenderables(m_Shader, m_OctreeRenderables);
+    m_Octree->CollectRenderables(*m_OctreeCells);
     m_OctreeDirty = false;
 }
 
+void RenderSystem::BuildSpatialSnapshot()
+{
+    m_SpatialSnapshot.Build(m_Registry);
+
+    // Both trees index into the snapshot, so they are rebuilt against the new contents
+    m_OctreeDirty = true;
+    m_KDTreeDirty = true;
+    m_SpatialSnapshotDirty = false;
+}
+
+bool RenderSystem::ConsumeSnapshotChanges()
+{
+    const Registry::ChangeSet& changes = m_Registry.ConsumeChanges(m_SnapshotChanges);
+    if (!changes.m_Removed.empty())
+        return true;
+
+    // The snapshot holds only entities with bounds; e.g. the moving light marker is not one of them
+    return std::any_of(changes.m_Changed.begin(), changes.m_Changed.end(), [this](Registry::Entity entity) {
+        return m_Registry.HasComponent<BoundingComponent>(entity);
+    });
+}
+
 void RenderSystem::BuildKDTree()
 {
+    PROFILE_SCOPE("RenderSystem::BuildKDTree");
     if (!m_KDTree)
     {
         m_KDTree = std::make_unique<KDTree>(m_Registry, m_KDTreeMaxObjects, m_KdSplitMethod, m_KDTreeMaxDepth);
+        m_KDTree->SetSnapshot(&m_SpatialSnapshot);
     }
     else
     {
@@ -91,9 +169,10 @@ void RenderSystem::BuildKDTree()
 
     m_KDTree->MarkDirty();
     m_KDTree->Build();
+    m_KDTree->SetQueryStatsEnabled(m_MeasureSpatialQueries);
+    m_KDTree->ResetQueryStats(); // counters describe the current settings only
 
-    m_KDTreeRenderables.clear();
-    m_KDTree->CollectRenderables(m_Shader, m_KDTreeRenderables);
+    m_KDTree->CollectRenderables(*m_KDTreeCells);
 
     m_KDTreeDirty = false;
 }
@@ -168,10 +247,137 @@ void RenderSystem::SetKDTreeMaxDepth(int depth)
 
 int RenderSystem::GetKDTreeMaxDepth() const { return m_KDTreeMaxDepth; }
 
+void RenderSystem::SetMeasureSpatialQueries(bool enable)
+{
+    m_MeasureSpatialQueries = enable;
+    if (m_Octree) m_Octree->SetQueryStatsEnabled(enable);
+    if (m_KDTree) m_KDTree->SetQueryStatsEnabled(enable);
+}
+
+void RenderSystem::ResetSpatialQueryStats()
+{
+    if (m_Octree) m_Octree->ResetQueryStats();
+    if (m_KDTree) m_KDTree->ResetQueryStats();
+}
+
+SpatialTreeStats RenderSystem::GetOctreeStats() const
+{
+    return m_Octree ? m_Octree->GetStats() : SpatialTreeStats();
+}
+
+SpatialTreeStats RenderSystem::GetKDTreeStats() const
+{
+    return m_KDTree ? m_KDTree->GetStats() : SpatialTreeStats();
+}
+
+
+void RenderSystem::SetLODEnabled(bool enable) { m_EnableLOD = enable; }
+
+bool RenderSystem::IsLODEnabled() const { return m_EnableLOD; }
+
+void RenderSystem::SetLODPixelThreshold(float pixels)
+{
+    m_LODPixelThreshold = std::max(1.0f, pixels);
+}
+
+float RenderSystem::GetLODPixelThreshold() const { return m_LODPixelThreshold; }
+
+int RenderSystem::SelectLODLevel(const Sphere& worldSphere, const glm::vec3& cameraPosition,
+                                 float pixelsPerRadian, int lodCount) const
+{
+    float distance = glm::length(worldSphere.center - cameraPosition);
+    if (distance <= worldSphere.radius)
+        return 0; // Camera is inside the bounds
+
+    float diameterPixels = worldSphere.radius * pixelsPerRadian / distance;
+    if (diameterPixels >= m_LODPixelThreshold)
+        return 0;
+
+    // Each halving of the on-screen size drops one level, matching the
+    // halving of the triangle budget between generated LODs
+    int level = 1 + static_cast<int>(std::floor(std::log2(m_LODPixelThreshold / std::max(diameterPixels, 1e-4f))));
+    return std::min(level, lodCount - 1);
+}
+
+void RenderSystem::SetIndirectDrawEnabled(bool enable) { m_EnableIndirectDraw = enable; }
+
+bool RenderSystem::IsIndirectDrawEnabled() const { return m_EnableIndirectDraw; }
+
+bool RenderSystem::RecordIndirectDraw(IRenderable& renderable, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix,
+                                      DrawCommandList& commands) const
+{
+    if (!m_EnableIndirectDraw || !m_IndirectShader)
+        return false;
+
+    // Only solid meshes are batched; primitives and per-object wireframe draw directly
+    auto* meshRenderer = dynamic_cast<MeshRenderer*>(&renderable);
+    if (!meshRenderer || meshRenderer->IsWireframe())
+        return false;
+
+    // Uploads need the GL thread; a new mesh is drawn directly until it is in the arena
+    const MeshArenaRange* range = m_MeshArena->Find(meshRenderer->GetMeshHandle(), meshRenderer->GetLODLevel());
+    if (!range)
+    {
+        commands.m_MissingMeshes.push_back(meshRenderer->GetMeshHandle());
+        return false;
+    }
+
+    DrawItem& draw = commands.m_Draws.emplace_back();
+    draw.m_SortKey  = MakeDrawSortKey(false, 0, 0, RenderPass::Meshes); // Leads the mesh pass
+    draw.m_Model    = modelMatrix;
+    draw.m_Normal   = normalMatrix;
+    draw.m_Indirect = true;
+    draw.m_Range    = *range;
+    draw.m_Color    = meshRenderer->GetColor();
+    return true;
+}
+
+bool RenderSystem::BindSharedUniformBlocks(const Shader& shader)
+{
+    GLuint lightBlockIndex = glGetUniformBlockIndex(shader.GetID(), "DirectionalLight");
+    if (lightBlockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(shader.GetID(), lightBlockIndex, kLightBlockBinding);
+    }
+
+    GLuint materialBlockIndex = glGetUniformBlockIndex(shader.GetID(), "Material");
+    if (materialBlockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(shader.GetID(), materialBlockIndex, kMaterialBlockBinding);
+    }
+
+    GLuint cameraBlockIndex = glGetUniformBlockIndex(shader.GetID(), "Camera");
+    if (cameraBlockIndex == GL_INVALID_INDEX)
+        return false;
+
+    glUniformBlockBinding(shader.GetID(), cameraBlockIndex, kCameraBlockBinding);
+    return true;
+}
+
+void RenderSystem::UpdateCameraUBO(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& cameraPosition)
+{
+    if (m_Headless)
+        return;
+
+    if (m_CameraUBO == 0)
+    {
+        m_CameraUBO = Buffer::CreateUniformBuffer(sizeof(CameraUniforms), kCameraBlockBinding);
+    }
+
+    CameraUniforms camera;
+    camera.m_View           = viewMatrix;
+    camera.m_Projection     = projectionMatrix;
+    camera.m_ViewProjection = projectionMatrix * viewMatrix;
+    camera.m_Position       = glm::vec4(cameraPosition, 1.0f);
+
+    Buffer::UpdateUniformBuffer(m_CameraUBO, &camera, sizeof(CameraUniforms));
+}
 
 void RenderSystem::Initialize()
 {
-    glViewport(0, 0, m_Window.GetWidth(), m_Window.GetHeight());
+    if (!m_Headless)
+    {
+        glViewport(0, 0, m_Window.GetWidth(), m_Window.GetHeight());
+    }
+    m_GpuTimer.Initialize(!m_Headless);
     
     for (auto entity : m_Registry.View<RenderComponent>()) 
     {
@@ -186,12 +392,171 @@ void RenderSystem::Initialize()
     SetupLighting();
     SetupMaterial();
 
+    // Headless: no shaders or GPU buffers; the pipeline runs on NullRenderables
+    if (!m_Headless)
+    {
+        m_IndirectShader = std::make_shared<Shader>(kIndirectVertexShaderPath, kIndirectFragmentShaderPath);
+        m_InstancedShader = std::make_shared<Shader>(kInstancedVertexShaderPath, kIndirectFragmentShaderPath);
+
+        // All three place geometry with the camera block; lighting and material are optional
+        for (const Shader* shader : { m_Shader.get(), m_IndirectShader.get(), m_InstancedShader.get() })
+        {
+            if (!BindSharedUniformBlocks(*shader))
+                std::cerr << "RenderSystem: shader program " << shader->GetID() << " has no Camera uniform block" << std::endl;
+        }
+        for (auto* instances : { m_OctreeCells.get(), m_KDTreeCells.get(), m_AABBInstances.get(), m_OBBInstances.get(), m_SphereInstances.get() })
+        {
+            instances->Initialize(m_InstancedShader);
+        }
+    }
+
+    BuildSpatialSnapshot();
     BuildOctree();
     BuildKDTree();
 }
 
+RenderSystem::CullVolume RenderSystem::GetCullVolume() const
+{
+    if (!m_CameraSystem)
+        return CullVolume::None;
+
+    // A displayed volume is also the one tested, so the visible count matches the overlay
+    if (m_ShowAABB)
+        return CullVolume::AABB;
+    if (m_ShowOBB)
+        return CullVolume::OBB;
+    if (m_ShowPCASphere)
+        return CullVolume::Sphere;
+
+    return m_EnableFrustumCulling ? CullVolume::AABB : CullVolume::None;
+}
+
+size_t RenderSystem::CullRenderView()
+{
+    PROFILE_SCOPE("RenderSystem::Cull");
+    m_CullCandidates.clear();
+    for (auto entity : m_Registry.View<TransformComponent, RenderComponent>())
+    {
+        m_CullCandidates.push_back(entity);
+    }
+
+    const CullVolume volume = GetCullVolume();
+    const glm::vec3* planeNormals = m_CameraSystem ? m_CameraSystem->GetFrustumNormals() : nullptr;
+    const float* planeDistances = m_CameraSystem ? m_CameraSystem->GetFrustumDistances() : nullptr;
+
+    // AABB culling classifies the whole snapshot plane by plane; the jobs below only look results up
+    if (volume == CullVolume::AABB)
+    {
+        m_SpatialSnapshot.ClassifyFrustum(planeNormals, planeDistances, m_FrustumResults);
+    }
+
+    // Only reads components and the frustum, so it runs on any thread
+    const entt::registry& registry = m_Registry.GetRegistry();
+    auto classify = [&](Registry::Entity entity) -> SideResult
+    {
+        const auto* boundingComp = registry.try_get<BoundingComponent>(entity);
+        if (volume == CullVolume::None || !boundingComp)
+            return SideResult::eINSIDE;
+
+        const auto& transform = registry.get<TransformComponent>(entity);
+        auto transformPoint = [&](const glm::vec3& p){ return glm::vec3(transform.m_Model * glm::vec4(p,1.0f)); };
+        float maxScale = glm::compMax(glm::abs(transform.m_Scale));
+
+        switch (volume)
+        {
+        case CullVolume::AABB:
+        {
+            size_t snapshotIndex = m_SpatialSnapshot.FindIndex(entity);
+            if (snapshotIndex != SpatialSnapshot::kInvalidIndex)
+                return m_FrustumResults[snapshotIndex];
+
+            Aabb worldAabb = boundingComp->GetAABB();
+            worldAabb.Transform(transform.m_Model);
+            return m_CameraSystem->TestAabbAgainstFrustum(worldAabb);
+        }
+        case CullVolume::OBB:
+        {
+            Obb worldObb = boundingComp->GetOBB();
+            worldObb.center = transformPoint(worldObb.center);
+            for(int i=0;i<3;++i){
+                worldObb.axes[i] = glm::normalize(glm::mat3(transform.m_Model) * worldObb.axes[i]);
+                worldObb.halfExtents[i] *= maxScale;
+            }
+            return m_CameraSystem->TestObbAgainstFrustum(worldObb);
+        }
+        case CullVolume::Sphere:
+        {
+            Sphere worldPCA = boundingComp->GetPCASphere();
+            worldPCA.center = transformPoint(worldPCA.center);
+            worldPCA.radius *= maxScale;
+            return m_CameraSystem->TestSphereAgainstFrustum(worldPCA);
+        }
+        default:
+            return SideResult::eINSIDE;
+        }
+    };
+
+    // Each chunk flags its entities and counts those it keeps, so the visible list can be
+    // compacted in view order without any locking
+    const size_t count = m_CullCandidates.size();
+    m_CullFlags.resize(count);
+    m_CullChunkOffsets.assign((count + kCullGrain - 1) / kCullGrain, 0);
+    std::atomic<size_t> inFrustumCount{ 0 };
+
+    SpatialTreeUtils::ForEachChunk(true, count, kCullGrain, [&](size_t begin, size_t end)
+    {
+        size_t drawn = 0;
+        size_t inFrustum = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            Registry::Entity entity = m_CullCandidates[i];
+            uint8_t flags = 0;
+            if (registry.get<RenderComponent>(entity).m_IsVisible)
+            {
+                if (entity == m_LightVisualizationEntity)
+                    flags = kCullDraw; // The light marker is always drawn and never counted
+                else if (classify(entity) != SideResult::eOUTSIDE)
+                    flags = kCullDraw | kCullInFrustum;
+                else if (!m_EnableFrustumCulling)
+                    flags = kCullDraw; // Displayed volumes are still tested for the count
+            }
+
+            m_CullFlags[i] = flags;
+            drawn     += (flags & kCullDraw) ? 1 : 0;
+            inFrustum += (flags & kCullInFrustum) ? 1 : 0;
+        }
+        m_CullChunkOffsets[begin / kCullGrain] = drawn;
+        inFrustumCount.fetch_add(inFrustum, std::memory_order_relaxed);
+    });
+
+    size_t visibleCount = 0;
+    for (size_t& offset : m_CullChunkOffsets)
+    {
+        size_t drawn = offset;
+        offset = visibleCount;
+        visibleCount += drawn;
+    }
+
+    m_VisibleEntities.resize(visibleCount);
+    SpatialTreeUtils::ForEachChunk(true, count, kCullGrain, [&](size_t begin, size_t end)
+    {
+        size_t slot = m_CullChunkOffsets[begin / kCullGrain];
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (m_CullFlags[i] & kCullDraw)
+                m_VisibleEntities[slot++] = m_CullCandidates[i];
+        }
+    });
+
+    return inFrustumCount.load(std::memory_order_relaxed);
+}
+
 void RenderSystem::Render()
 {
+    PROFILE_SCOPE("RenderSystem::Render");
+    // Collects the pass timings of a frame the GPU has finished by now
+    m_GpuTimer.BeginFrame();
+
     if (m_LightEntity != entt::null && m_Registry.HasComponent<DirectionalLightComponent>(m_LightEntity))
     {
         auto& lightComp = m_Registry.GetComponent<DirectionalLightComponent>(m_LightEntity);
@@ -208,11 +573,22 @@ void RenderSystem::Render()
             auto& t = m_Registry.GetComponent<TransformComponent>(m_LightVisualizationEntity);
             t.m_Position = lightPos;
             t.UpdateModelMatrix();
+            m_Registry.MarkChanged<TransformComponent>(m_LightVisualizationEntity);
         }
 
         UpdateLighting();
     }
 
+    // Consumed every frame so changes never pile up; only bounded entities force a rebuild
+    if (ConsumeSnapshotChanges())
+    {
+        m_SpatialSnapshotDirty = true;
+    }
+    if (m_SpatialSnapshotDirty)
+    {
+        BuildSpatialSnapshot();
+    }
+
     if (m_OctreeDirty)
     {
         BuildOctree();
@@ -234,121 +610,275 @@ void RenderSystem::Render()
     
     glm::vec3 cameraPosition = camera.GetPosition();
     
-    m_Shader->Use();
-    m_Shader->SetVec3("viewPos", cameraPosition);
+    // One upload per frame; every shader reads view/projection from the Camera block
+    UpdateCameraUBO(viewMatrix, projectionMatrix, cameraPosition);
     
     if (m_CameraSystem) 
     {
         m_CameraSystem->UpdateFrustumPlanes(camera, aspectRatio);
+        
+        if (m_MeasureSpatialQueries)
+        {
+            PROFILE_SCOPE("RenderSystem::MeasureSpatialQueries");
+            const glm::vec3* planeNormals = m_CameraSystem->GetFrustumNormals();
+            const float* planeDistances = m_CameraSystem->GetFrustumDistances();
+            
+            m_SpatialQueryResults.clear();
+            m_Octree->QueryFrustum(planeNormals, planeDistances, m_SpatialQueryResults);
+            m_SpatialQueryResults.clear();
+            m_KDTree->QueryFrustum(planeNormals, planeDistances, m_SpatialQueryResults);
+        }
     }
     
-    static GLenum s_CurrentPolyMode = GL_FILL;
-    GLenum desiredMode = m_GlobalWireframe ? GL_LINE : GL_FILL;
-    if (desiredMode != s_CurrentPolyMode)
-    {
-        glPolygonMode(GL_FRONT_AND_BACK, desiredMode);
-        s_CurrentPolyMode = desiredMode;
-    }
-    
-    auto renderView = m_Registry.View<TransformComponent, RenderComponent>();
-    for (auto entity : renderView) 
+    // Projected sphere diameter in pixels is radius * pixelsPerRadian / distance
+    const float pixelsPerRadian = static_cast<float>(m_Window.GetHeight()) /
+                                  std::tan(glm::radians(camera.m_Projection.m_Fov) * 0.5f);
+    size_t visibleEntityCount = CullRenderView();
+    RecordDrawCommands(cameraPosition, pixelsPerRadian);
     {
-        auto& transform = m_Registry.GetComponent<TransformComponent>(entity);
-        auto& renderComp = m_Registry.GetComponent<RenderComponent>(entity);
-        
-        if (!renderComp.m_IsVisible)
-            continue;
-            
-        if (entity == m_LightVisualizationEntity) 
+        PROFILE_SCOPE("RenderSystem::QueueInstances");
+        m_AABBInstances->ClearInstances();
+        m_OBBInstances->ClearInstances();
+        m_SphereInstances->ClearInstances();
+
+        size_t frameVertexCount = 0;
+        std::array<InstancedPrimitiveRenderer*, 3> volumes = { m_AABBInstances.get(), m_OBBInstances.get(), m_SphereInstances.get() };
+        for (const DrawCommandList& commands : m_CommandLists)
         {
-            if (m_ShowMainObjects && renderComp.m_Renderable) 
+            frameVertexCount += commands.m_VertexCount;
+
+            // Meshes first seen this frame were drawn directly; from the next frame on they are batched
+            for (const ResourceHandle& meshHandle : commands.m_MissingMeshes)
             {
-                renderComp.m_Renderable->Render(transform.m_Model, viewMatrix, projectionMatrix);
+                m_MeshArena->Acquire(meshHandle, 0);
             }
-            continue;
-        }
-        
-        SideResult frustumResult = SideResult::eINSIDE;
-        
-        if (m_CameraSystem && m_Registry.HasComponent<BoundingComponent>(entity)) 
-        {
-            auto& boundingComp = m_Registry.GetComponent<BoundingComponent>(entity);
-
-            Aabb worldAabb = boundingComp.GetAABB();
-            worldAabb.Transform(transform.m_Model);
-
-            Sphere worldPCA    = boundingComp.GetPCASphere();
-
-            auto transformPoint = [&](const glm::vec3& p){ return glm::vec3(transform.m_Model * glm::vec4(p,1.0f)); };
-            worldPCA.center = transformPoint(worldPCA.center);
-
-            float maxScale = glm::compMax(glm::abs(transform.m_Scale));
-            worldPCA.radius    *= maxScale;
 
-            Obb worldObb = boundingComp.GetOBB();
-            worldObb.center = transformPoint(worldObb.center);
-            for(int i=0;i<3;++i){
-                worldObb.axes[i] = glm::normalize(glm::mat3(transform.m_Model) * worldObb.axes[i]);
-                worldObb.halfExtents[i] *= maxScale;
+            for (size_t v = 0; v < volumes.size(); ++v)
+            {
+                for (const glm::mat4& transform : commands.m_VolumeInstances[v])
+                {
+                    volumes[v]->AddInstance(transform, kBoundingVolumeColor);
+                }
             }
+        }
+        m_LastFrameVertexCount = frameVertexCount;
 
-            if (m_ShowAABB) 
+        // Instance uploads bind vertex arrays, so they happen before the cached draw pass.
+        // Headless runs still build the instance lists above but have nothing to upload to.
+        if (!m_Headless)
+        {
+            for (auto* instances : volumes)
             {
-                frustumResult = m_CameraSystem->TestAabbAgainstFrustum(worldAabb);
+                if (instances->GetInstanceCount() == 0)
+                    continue;
+                instances->UploadInstances();
+                QueueDraw(*instances, glm::mat4(1.0f), glm::mat3(1.0f), RenderPass::BoundingVolumes);
             }
-            else if (m_ShowOBB) 
+
+            if (m_ShowOctreeCells)
             {
-                frustumResult = m_CameraSystem->TestObbAgainstFrustum(worldObb);
+                m_OctreeCells->UploadInstances();
+                QueueDraw(*m_OctreeCells, glm::mat4(1.0f), glm::mat3(1.0f), RenderPass::OctreeCells);
             }
-            else if (m_ShowPCASphere) 
+
+            if (m_ShowKDTreeCells)
             {
-                frustumResult = m_CameraSystem->TestSphereAgainstFrustum(worldPCA);
+                m_KDTreeCells->UploadInstances();
+                QueueDraw(*m_KDTreeCells, glm::mat4(1.0f), glm::mat3(1.0f), RenderPass::KDTreeCells);
             }
         }
-        
-        if (m_ShowMainObjects && renderComp.m_Renderable) 
-        {            
-            renderComp.m_Renderable->Render(transform.m_Model, viewMatrix, projectionMatrix);
-        }
-        
-        if (m_Registry.HasComponent<BoundingComponent>(entity))
-        {            
-            auto& boundingComp = m_Registry.GetComponent<BoundingComponent>(entity);
-                        
-            if (m_ShowAABB && boundingComp.m_AABBRenderable)
+    }
+
+    MergeDrawCommands();
+    SubmitDrawList();
+    m_LastFrameIndirectDrawCount = m_IndirectBatch->GetDrawCount();
+
+    PROFILE_COUNTER("Visible Entities", visibleEntityCount);
+    PROFILE_COUNTER("Vertices", m_LastFrameVertexCount);
+    PROFILE_COUNTER("Draw Calls", m_LastFrameStateStats.m_DrawCalls);
+    PROFILE_COUNTER("Octree Nodes", m_OctreeCells->GetInstanceCount());
+    PROFILE_COUNTER("KD-Tree Nodes", m_KDTreeCells->GetInstanceCount());
+}
+
+DrawItem RenderSystem::MakeDrawItem(IRenderable& renderable, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix,
+                                    RenderPass pass) const
+{
+    // Null renderables in headless mode have no shader; they all share program 0
+    const auto& shader = renderable.GetShader();
+    GLuint program = shader ? shader->GetID() : 0;
+
+    bool wireframe = m_GlobalWireframe || renderable.IsWireframe();
+    return { MakeDrawSortKey(wireframe, program, renderable.GetVertexArray(), pass), &renderable, modelMatrix, normalMatrix };
+}
+
+void RenderSystem::QueueDraw(IRenderable& renderable, const glm::mat4& modelMatrix, const glm::mat3& normalMatrix,
+                             RenderPass pass)
+{
+    m_CommandLists.back().m_Draws.push_back(MakeDrawItem(renderable, modelMatrix, normalMatrix, pass));
+}
+
+void RenderSystem::RecordDrawCommands(const glm::vec3& cameraPosition, float pixelsPerRadian)
+{
+    PROFILE_SCOPE("RenderSystem::RecordDraws");
+    const size_t count = m_VisibleEntities.size();
+    const size_t chunkCount = (count + kRecordGrain - 1) / kRecordGrain;
+
+    // Lists are kept between frames so their storage is reused
+    m_CommandLists.resize(chunkCount + 1);
+    for (DrawCommandList& commands : m_CommandLists)
+    {
+        commands.Clear();
+    }
+
+    // Each job only writes its own list and the renderables of its own entities
+    const entt::registry& registry = m_Registry.GetRegistry();
+    SpatialTreeUtils::ForEachChunk(true, count, kRecordGrain, [&](size_t begin, size_t end)
+    {
+        DrawCommandList& commands = m_CommandLists[begin / kRecordGrain];
+        for (size_t i = begin; i < end; ++i)
+        {
+            Registry::Entity entity = m_VisibleEntities[i];
+            const auto& transform = registry.get<TransformComponent>(entity);
+            const auto& renderComp = registry.get<RenderComponent>(entity);
+            const auto* boundingComp = registry.try_get<BoundingComponent>(entity);
+
+            if (entity == m_LightVisualizationEntity)
             {
-                boundingComp.m_AABBRenderable->Render(transform.m_Model, viewMatrix, projectionMatrix);
+                if (m_ShowMainObjects && renderComp.m_Renderable)
+                {
+                    commands.m_Draws.push_back(MakeDrawItem(*renderComp.m_Renderable, transform.m_Model, transform.m_NormalMatrix));
+                    commands.m_VertexCount += renderComp.m_Renderable->GetVertexCount();
+                }
+                continue;
             }
-            
-            if (m_ShowOBB && boundingComp.m_OBBRenderable) 
+
+            if (m_ShowMainObjects && renderComp.m_Renderable)
             {
-                boundingComp.m_OBBRenderable->Render(transform.m_Model, viewMatrix, projectionMatrix);
+                int lodLevel = 0;
+                int lodCount = renderComp.m_Renderable->GetLODCount();
+                if (m_EnableLOD && lodCount > 1 && boundingComp)
+                {
+                    Sphere worldSphere = boundingComp->GetPCASphere();
+                    worldSphere.center = glm::vec3(transform.m_Model * glm::vec4(worldSphere.center, 1.0f));
+                    worldSphere.radius *= glm::compMax(glm::abs(transform.m_Scale));
+
+                    lodLevel = SelectLODLevel(worldSphere, cameraPosition, pixelsPerRadian, lodCount);
+                }
+                renderComp.m_Renderable->SetLODLevel(lodLevel);
+                if (!RecordIndirectDraw(*renderComp.m_Renderable, transform.m_Model, transform.m_NormalMatrix, commands))
+                {
+                    commands.m_Draws.push_back(MakeDrawItem(*renderComp.m_Renderable, transform.m_Model, transform.m_NormalMatrix));
+                }
+                commands.m_VertexCount += renderComp.m_Renderable->GetVertexCount();
             }
 
-            if (m_ShowPCASphere && boundingComp.m_PCARenderable)
+            // Bounding volumes become instances, drawn together once every list is recorded
+            if (boundingComp)
             {
-                 boundingComp.m_PCARenderable->Render(transform.m_Model, viewMatrix, projectionMatrix);
+                if (m_ShowAABB)
+                {
+                    const Aabb& aabb = boundingComp->GetAABB();
+                    commands.m_VolumeInstances[0].push_back(transform.m_Model *
+                        InstancedPrimitiveRenderer::BoxTransform(aabb.GetCenter(), aabb.GetExtents() * 2.0f));
+                }
+
+                if (m_ShowOBB)
+                {
+                    const Obb& obb = boundingComp->GetOBB();
+                    commands.m_VolumeInstances[1].push_back(transform.m_Model *
+                        InstancedPrimitiveRenderer::OrientedBoxTransform(obb.center, obb.axes, obb.halfExtents));
+                }
+
+                if (m_ShowPCASphere)
+                {
+                    const Sphere& sphere = boundingComp->GetPCASphere();
+                    commands.m_VolumeInstances[2].push_back(transform.m_Model *
+                        InstancedPrimitiveRenderer::SphereTransform(sphere.center, sphere.radius));
+                }
             }
-
-            UpdateMaterialUBO(m_DefaultMaterial);
         }
+
+        // Stable, so equal keys keep view order and the merged list never depends on the thread count
+        std::stable_sort(commands.m_Draws.begin(), commands.m_Draws.end());
+    });
+}
+
+void RenderSystem::MergeDrawCommands()
+{
+    PROFILE_SCOPE("RenderSystem::MergeDraws");
+    DrawCommandList& mainCommands = m_CommandLists.back();
+    std::stable_sort(mainCommands.m_Draws.begin(), mainCommands.m_Draws.end());
+
+    m_DrawRuns.assign(1, 0);
+    for (const DrawCommandList& commands : m_CommandLists)
+    {
+        m_DrawRuns.push_back(m_DrawRuns.back() + commands.m_Draws.size());
     }
 
-    if (m_ShowOctreeCells)
+    m_DrawList.resize(m_DrawRuns.back());
+    JobSystem::Get().ParallelFor(m_CommandLists.size(), 1, [this](size_t begin, size_t end)
     {
-        for (const auto& cube : m_OctreeRenderables)
+        for (size_t list = begin; list < end; ++list)
         {
-            cube->Render(glm::mat4(1.0f), viewMatrix, projectionMatrix);
+            const auto& draws = m_CommandLists[list].m_Draws;
+            std::copy(draws.begin(), draws.end(), m_DrawList.begin() + m_DrawRuns[list]);
         }
-    }
+    });
 
-    if (m_ShowKDTreeCells)
+    MergeDrawRuns(m_DrawList, m_DrawRuns);
+}
+
+void RenderSystem::SubmitDrawList()
+{
+    PROFILE_SCOPE("RenderSystem::SubmitDrawList");
+    // GL state may have been changed outside the cache since last frame (UI, uploads)
+    m_StateCache.Invalidate();
+    m_StateCache.ResetStats();
+    m_IndirectBatch->Begin();
+
+    UpdateMaterialUBO(m_DefaultMaterial);
+
+    // Already grouped by pass; within a pass batched meshes come first, then solid draws,
+    // then wireframe, each grouped by shader and vertex array
+    auto item = m_DrawList.begin();
+    for (int p = 0; p < static_cast<int>(RenderPass::Count); ++p)
     {
-        for (const auto& cube : m_KDTreeRenderables)
+        const RenderPass pass = static_cast<RenderPass>(p);
+        auto passEnd = std::find_if(item, m_DrawList.end(),
+                                    [pass](const DrawItem& d) { return GetSortKeyPass(d.m_SortKey) != pass; });
+        if (item == passEnd)
+            continue;
+
+        PROFILE_SCOPE(GetRenderPassName(pass));
+        GpuPassScope gpuPass(m_GpuTimer, GetRenderPassName(pass));
+
+        // All batched meshes go out in a single multi-draw indirect call, sharing the
+        // solid polygon mode with the first direct draws
+        for (; item != passEnd && item->m_Indirect; ++item)
+        {
+            m_IndirectBatch->Add(item->m_Range, item->m_Model, item->m_Normal, item->m_Color);
+        }
+        if (m_IndirectBatch->GetDrawCount() > 0 && pass == RenderPass::Meshes)
+        {
+            m_StateCache.SetPolygonMode(m_GlobalWireframe ? GL_LINE : GL_FILL);
+            m_StateCache.UseProgram(m_IndirectShader->GetID());
+            m_StateCache.BindVertexArray(m_MeshArena->GetVertexArray());
+            m_IndirectBatch->Submit();
+            m_StateCache.CountDraw();
+        }
+
+        for (; item != passEnd; ++item)
         {
-            cube->Render(glm::mat4(1.0f), viewMatrix, projectionMatrix);
+            m_StateCache.SetPolygonMode(GetSortKeyWireframe(item->m_SortKey) ? GL_LINE : GL_FILL);
+            m_StateCache.UseProgram(GetSortKeyProgram(item->m_SortKey));
+            m_StateCache.BindVertexArray(item->m_Renderable->GetVertexArray());
+            item->m_Renderable->Render(item->m_Model, item->m_Normal);
+            m_StateCache.CountDraw();
         }
     }
+
+    m_StateCache.BindVertexArray(0);
+    m_LastFrameStateStats = m_StateCache.GetStats();
 }
 
 void RenderSystem::Shutdown()
@@ -363,12 +893,17 @@ void RenderSystem::Shutdown()
         }
     }
     
-    for (auto entity : m_Registry.View<BoundingComponent>()) 
+    for (auto* instances : { m_OctreeCells.get(), m_KDTreeCells.get(), m_AABBInstances.get(), m_OBBInstances.get(), m_SphereInstances.get() })
     {
-        auto& boundingComp = m_Registry.GetComponent<BoundingComponent>(entity);
-        boundingComp.CleanupRenderables();
+        instances->CleanUp();
     }
 
+    m_IndirectBatch->CleanUp();
+    m_MeshArena->Clear();
+    m_GpuTimer.Shutdown();
+
+    Buffer::DeleteUniformBuffer(m_CameraUBO);
+    m_CameraUBO = 0;
 }
 
 // Bounding volume visibility controls
@@ -444,11 +979,17 @@ void RenderSystem::CreateLightSourceVisualization(const DirectionalLight& light)
     
     m_LightVisualizationEntity = m_Registry.Create();
     
-    auto lightSphereRenderer = std::make_shared<SphereRenderer>(
+    auto sphereRenderer = std::make_shared<SphereRenderer>(
         lightPosition, 
         0.2f,  // Small radius
         glm::vec3(1.0f, 1.0f, 0.0f)  // Yellow color
     );
+    
+    std::shared_ptr<IRenderable> lightSphereRenderer = sphereRenderer;
+    if (m_Headless)
+    {
+        lightSphereRenderer = std::make_shared<NullRenderable>(sphereRenderer->CreateVertices().size());
+    }
     lightSphereRenderer->Initialize(m_Shader);
     
     m_Registry.AddComponent<TransformComponent>(m_LightVisualizationEntity, 
@@ -466,19 +1007,19 @@ void RenderSystem::SetupMaterial()
     m_DefaultMaterial.m_SpecularIntensity = 0.5f;
     m_DefaultMaterial.m_Shininess         = 32.0f;
     
-    if (m_MaterialUBO == 0) 
+    if (m_MaterialUBO == 0 && !m_Headless) 
     {
-        m_MaterialUBO = Buffer::CreateUniformBuffer(sizeof(Material), 1);
+        m_MaterialUBO = Buffer::CreateUniformBuffer(sizeof(Material), kMaterialBlockBinding);
         
         GLuint materialBlockIndex = glGetUniformBlockIndex(m_Shader->GetID(), "Material");
         if (materialBlockIndex != GL_INVALID_INDEX) {
-            glUniformBlockBinding(m_Shader->GetID(), materialBlockIndex, 1);
+            glUniformBlockBinding(m_Shader->GetID(), materialBlockIndex, kMaterialBlockBinding);
         } else {
             std::cerr << "ERROR: Material uniform block not found in shader!" << std::endl;
         }
     } 
 
-    Buffer::UpdateUniformBuffer(m_MaterialUBO, &m_DefaultMaterial, sizeof(Material));
+    UpdateMaterialUBO(m_DefaultMaterial);
 }
 
 void RenderSystem::UpdateMaterialUBO(const Material& material)
@@ -490,6 +1031,9 @@ void RenderSystem::UpdateMaterialUBO(const Material& material)
 
 void RenderSystem::UpdateLighting()
 {
+    if (m_Headless)
+        return;
+
     if (m_LightEntity != entt::null && m_Registry.HasComponent<DirectionalLightComponent>(m_LightEntity))
     {
         DirectionalLight light = m_Registry.GetComponent<DirectionalLightComponent>(m_LightEntity).m_Light;
@@ -497,11 +1041,11 @@ void RenderSystem::UpdateLighting()
         static GLuint lightUBO = 0;
         if (lightUBO == 0) 
         {
-            lightUBO = Buffer::CreateUniformBuffer(sizeof(DirectionalLight), 0);
+            lightUBO = Buffer::CreateUniformBuffer(sizeof(DirectionalLight), kLightBlockBinding);
             
             GLuint lightBlockIndex = glGetUniformBlockIndex(m_Shader->GetID(), "DirectionalLight");
             if (lightBlockIndex != GL_INVALID_INDEX) {
-                glUniformBlockBinding(m_Shader->GetID(), lightBlockIndex, 0);
+                glUniformBlockBinding(m_Shader->GetID(), lightBlockIndex, kLightBlockBinding);
             } else {
                 std::cerr << "ERROR: DirectionalLight uniform block not found in shader!" << std::endl;
             }
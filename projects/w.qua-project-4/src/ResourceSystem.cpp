@@ -6,8 +6,42 @@
 #include "ResourceSystem.hpp"
 #include "Shader.hpp"
 #include "Buffer.hpp"
+#include "MeshSimplifier.hpp"
+#include "Geometry.hpp"
+#include "JobSystem.hpp"
 #include <random>
 
+// Fraction of the full resolution triangles kept by LOD 1, 2, 3 and 4
+static constexpr float kLODTriangleRatios[] = { 0.5f, 0.25f, 0.12f, 0.06f };
+
+// Meshes below this triangle count are cheap enough to always draw at full detail
+static constexpr size_t kMinLODTriangles = 256;
+
+void MeshResource::ComputeBounds()
+{
+    if (m_Vertices.empty())
+    {
+        return;
+    }
+    
+    Vertex min, max;
+    CreateAabbBruteForce(m_Vertices.data(), m_Vertices.size(), &min, &max);
+    m_AABB = Aabb(min.m_Position, max.m_Position);
+    
+    Vertex center;
+    float radius;
+    CreateSpherePCA(m_Vertices.data(), m_Vertices.size(), &center, &radius);
+    m_PCASphere = Sphere(center.m_Position, radius);
+    
+    glm::vec3 obbCenter;
+    glm::vec3 obbAxes[3];
+    glm::vec3 obbHalfExtents;
+    CreateObbPCA(m_Vertices.data(), m_Vertices.size(), &obbCenter, obbAxes, &obbHalfExtents);
+    m_OBB = Obb(obbCenter, obbAxes, obbHalfExtents);
+    
+    m_BoundsComputed = true;
+}
+
 ResourceSystem& ResourceSystem::GetInstance() 
 {
     static ResourceSystem instance;
@@ -27,6 +61,51 @@ ResourceSystem::~ResourceSystem()
 
 ResourceHandle ResourceSystem::LoadMesh(const std::string& path) 
 {
+    std::shared_ptr<MeshResource> mesh;
+    ResourceHandle handle = ImportMesh(path, &mesh);
+    
+    if (mesh)
+    {
+        PostProcessMesh(*mesh);
+    }
+    
+    return handle;
+}
+
+std::vector<ResourceHandle> ResourceSystem::LoadMeshes(const std::vector<std::string>& paths)
+{
+    std::vector<ResourceHandle> handles;
+    handles.reserve(paths.size());
+    
+    // Import serially: the Assimp importer and the caches are not thread-safe
+    std::vector<std::shared_ptr<MeshResource>> imported;
+    for (const auto& path : paths)
+    {
+        std::shared_ptr<MeshResource> mesh;
+        handles.push_back(ImportMesh(path, &mesh));
+        
+        if (mesh)
+        {
+            imported.push_back(std::move(mesh));
+        }
+    }
+    
+    // Post-processing only touches each mesh's own data, so meshes run as concurrent jobs
+    JobSystem& jobs = JobSystem::Get();
+    JobCounter postProcessed;
+    for (const auto& mesh : imported)
+    {
+        jobs.Run(postProcessed, [this, mesh = mesh.get()]() { PostProcessMesh(*mesh); });
+    }
+    jobs.Wait(postProcessed);
+    
+    return handles;
+}
+
+ResourceHandle ResourceSystem::ImportMesh(const std::string& path, std::shared_ptr<MeshResource>* out_mesh)
+{
+    *out_mesh = nullptr;
+    
     // Check if we've already loaded this path
     auto itHandle = m_PathToHandle.find(path);
     if (itHandle != m_PathToHandle.end())
@@ -48,9 +127,16 @@ ResourceHandle ResourceSystem::LoadMesh(const std::string& path)
     m_MeshResources[handle] = mesh;
     m_PathToHandle[path]   = handle;
 
+    *out_mesh = mesh;
     return handle;
 }
 
+void ResourceSystem::PostProcessMesh(MeshResource& mesh)
+{
+    mesh.ComputeBounds();
+    GenerateLODs(mesh);
+}
+
 std::shared_ptr<MeshResource> ResourceSystem::GetMesh(const ResourceHandle& handle) const 
 {
     if (!IsHandleValid(handle)) 
@@ -221,4 +307,31 @@ std::vector<Vertex> ResourceSystem::ProcessAssimpMesh(const aiMesh* mesh)
     }
     
     return triangulatedVertices;
-} 
\ No newline at end of file
+}
+
+void ResourceSystem::GenerateLODs(MeshResource& mesh)
+{
+    const auto& vertices = mesh.GetVertexes();
+    const size_t triangleCount = vertices.size() / 3;
+    if (triangleCount < kMinLODTriangles)
+    {
+        return;
+    }
+
+    std::vector<std::vector<Vertex>> lods;
+    for (float ratio : kLODTriangleRatios)
+    {
+        auto simplified = SimplifyMeshQuadric(vertices, ratio);
+
+        // Stop once the simplifier can no longer make meaningful progress
+        const size_t previous = lods.empty() ? vertices.size() : lods.back().size();
+        if (simplified.empty() || simplified.size() >= previous)
+        {
+            break;
+        }
+
+        lods.push_back(std::move(simplified));
+    }
+
+    mesh.SetLODs(std::move(lods));
+}
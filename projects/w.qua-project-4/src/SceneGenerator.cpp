@@ -0,0 +1,209 @@
+/**
+ * @file SceneGenerator.cpp
+ * @brief Implementation of the deterministic synthetic scene generator.
+ */
+
+#include "SceneGenerator.hpp"
+#include "Components.hpp"
+#include <random>
+
+namespace
+{
+    /**
+     * @brief Seeded random source. std::mt19937's sequence is fixed by the standard but
+     *        the std distributions are not, so values are derived from the raw bits here.
+     */
+    class SceneRandom
+    {
+    public:
+        explicit SceneRandom(uint32_t seed) : m_Engine(seed) {}
+
+        // Uniform in [0, 1) from the top 24 bits
+        float Unit() { return static_cast<float>(m_Engine() >> 8) * (1.0f / 16777216.0f); }
+
+        float Range(float lo, float hi) { return lo + (hi - lo) * Unit(); }
+
+        glm::vec3 Range(const glm::vec3& lo, const glm::vec3& hi)
+        {
+            float x = Range(lo.x, hi.x);
+            float y = Range(lo.y, hi.y);
+            float z = Range(lo.z, hi.z);
+            return glm::vec3(x, y, z);
+        }
+
+        uint32_t Index(uint32_t count) { return m_Engine() % count; }
+
+        // Standard normal via Box-Muller
+        float Normal()
+        {
+            float u1 = std::max(Unit(), 1e-7f);
+            float u2 = Unit();
+            return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.28318530718f * u2);
+        }
+
+    private:
+        std::mt19937 m_Engine;
+    };
+
+    /**
+     * @brief Creates one entity with a mesh-free bounding component.
+     * @param registry Registry to add to
+     * @param centre World-space box centre
+     * @param extents Box half extents
+     * @return Created entity
+     */
+    Registry::Entity CreateBox(Registry& registry, const glm::vec3& centre, const glm::vec3& extents)
+    {
+        auto entity = registry.Create();
+        registry.AddComponent<TransformComponent>(entity, centre);
+
+        // Every volume is filled in so all BV and tree code paths work without a mesh
+        auto& bounds = registry.AddComponent<BoundingComponent>(entity);
+        bounds.m_AABB      = Aabb(-extents, extents);
+        bounds.m_PCASphere = Sphere(glm::vec3(0.0f), glm::length(extents));
+        bounds.m_OBB       = Obb();
+        bounds.m_OBB.halfExtents = extents;
+        return entity;
+    }
+}
+
+namespace SceneGenerator
+{
+    float DefaultHalfSize(size_t objectCount)
+    {
+        return 50.0f * std::cbrt(static_cast<float>(std::max<size_t>(objectCount, 1)) / 1000.0f);
+    }
+
+    std::vector<Registry::Entity> Generate(Registry& registry, const SceneGeneratorConfig& config)
+    {
+        std::vector<Registry::Entity> entities;
+        entities.reserve(config.m_ObjectCount);
+        if (config.m_ObjectCount == 0)
+            return entities;
+
+        SceneRandom random(config.m_Seed);
+        const float halfSize = config.m_HalfSize > 0.0f ? config.m_HalfSize : DefaultHalfSize(config.m_ObjectCount);
+        const glm::vec3 lo(-halfSize);
+        const glm::vec3 hi(halfSize);
+
+        switch (config.m_Distribution)
+        {
+            case SceneDistribution::Uniform:
+            {
+                for (size_t i = 0; i < config.m_ObjectCount; ++i)
+                {
+                    glm::vec3 centre  = random.Range(lo, hi);
+                    glm::vec3 extents = random.Range(glm::vec3(0.25f), glm::vec3(1.0f));
+                    entities.push_back(CreateBox(registry, centre, extents));
+                }
+                break;
+            }
+
+            case SceneDistribution::GaussianClusters:
+            {
+                std::vector<glm::vec3> centres(static_cast<size_t>(std::max(config.m_ClusterCount, 1)));
+                for (auto& c : centres)
+                    c = random.Range(lo * 0.8f, hi * 0.8f);
+
+                const float sigma = halfSize * 0.05f;
+                for (size_t i = 0; i < config.m_ObjectCount; ++i)
+                {
+                    const glm::vec3& c = centres[random.Index(static_cast<uint32_t>(centres.size()))];
+                    float x = random.Normal();
+                    float y = random.Normal();
+                    float z = random.Normal();
+                    glm::vec3 centre  = c + glm::vec3(x, y, z) * sigma;
+                    glm::vec3 extents = random.Range(glm::vec3(0.25f), glm::vec3(1.0f));
+                    entities.push_back(CreateBox(registry, centre, extents));
+                }
+                break;
+            }
+
+            case SceneDistribution::Grid:
+            {
+                const size_t side = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(config.m_ObjectCount))));
+                const float spacing = (2.0f * halfSize) / static_cast<float>(side);
+                const glm::vec3 extents(spacing * 0.3f);
+                for (size_t i = 0; i < config.m_ObjectCount; ++i)
+                {
+                    size_t x = i % side;
+                    size_t y = (i / side) % side;
+                    size_t z = i / (side * side);
+                    glm::vec3 centre = lo + (glm::vec3(x, y, z) + 0.5f) * spacing;
+                    entities.push_back(CreateBox(registry, centre, extents));
+                }
+                break;
+            }
+
+            case SceneDistribution::City:
+            {
+                // Ground plane spans the full square; heights stay in the lower part of the cube
+                for (size_t i = 0; i < config.m_ObjectCount; ++i)
+                {
+                    glm::vec3 centre;
+                    glm::vec3 extents;
+                    if (random.Unit() < 0.7f)
+                    {
+                        // Building: small footprint, tall along Y, standing on the ground
+                        float footX  = random.Range(0.5f, 2.0f);
+                        float height = random.Range(2.5f, 20.0f);
+                        float footZ  = random.Range(0.5f, 2.0f);
+                        extents = glm::vec3(footX, height, footZ);
+                        float x = random.Range(-halfSize, halfSize);
+                        float z = random.Range(-halfSize, halfSize);
+                        centre  = glm::vec3(x, -halfSize + extents.y, z);
+                    }
+                    else
+                    {
+                        // Beam / pipe: long along X or Z, thin in the other two axes
+                        float length = random.Range(5.0f, 30.0f);
+                        float thickY = random.Range(0.1f, 0.3f);
+                        float thickH = random.Range(0.1f, 0.3f);
+                        extents = (random.Unit() < 0.5f) ? glm::vec3(length, thickY, thickH)
+                                                         : glm::vec3(thickH, thickY, length);
+                        float x = random.Range(-halfSize, halfSize);
+                        float y = random.Range(-halfSize, -halfSize + 40.0f);
+                        float z = random.Range(-halfSize, halfSize);
+                        centre  = glm::vec3(x, y, z);
+                    }
+                    entities.push_back(CreateBox(registry, centre, extents));
+                }
+                break;
+            }
+
+            case SceneDistribution::MixedScales:
+            {
+                // Half extents log-uniform in [0.05, 50]
+                const float logMin = std::log(0.05f);
+                const float logMax = std::log(50.0f);
+                for (size_t i = 0; i < config.m_ObjectCount; ++i)
+                {
+                    glm::vec3 centre = random.Range(lo, hi);
+                    float scale = std::exp(random.Range(logMin, logMax));
+                    glm::vec3 aspect = random.Range(glm::vec3(0.5f), glm::vec3(1.0f));
+                    entities.push_back(CreateBox(registry, centre, aspect * scale));
+                }
+                break;
+            }
+
+            default:
+                std::cerr << "SceneGenerator: Unknown distribution" << std::endl;
+                break;
+        }
+
+        return entities;
+    }
+
+    const char* GetDistributionName(SceneDistribution distribution)
+    {
+        switch (distribution)
+        {
+            case SceneDistribution::Uniform:          return "Uniform";
+            case SceneDistribution::GaussianClusters: return "GaussianClusters";
+            case SceneDistribution::Grid:             return "Grid";
+            case SceneDistribution::City:             return "City";
+            case SceneDistribution::MixedScales:      return "MixedScales";
+            default:                                  return "Unknown";
+        }
+    }
+}
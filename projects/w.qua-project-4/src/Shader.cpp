@@ -107,55 +107,71 @@ unsigned int Shader::GetID() const
 
 void Shader::SetBool(const std::string& name, bool value) const 
 {
-    glUniform1i(glGetUniformLocation(m_ID, name.c_str()), (int)value);
+    glUniform1i(GetUniformLocation(name), (int)value);
 }
 
 void Shader::SetInt(const std::string& name, int value) const 
 {
-    glUniform1i(glGetUniformLocation(m_ID, name.c_str()), value);
+    glUniform1i(GetUniformLocation(name), value);
 }
 
 void Shader::SetFloat(const std::string& name, float value) const 
 {
-    glUniform1f(glGetUniformLocation(m_ID, name.c_str()), value);
+    glUniform1f(GetUniformLocation(name), value);
 }
 
 void Shader::SetVec2(const std::string& name, const glm::vec2& value) const 
 {
-    glUniform2fv(glGetUniformLocation(m_ID, name.c_str()), 1, &value[0]);
+    glUniform2fv(GetUniformLocation(name), 1, &value[0]);
 }
 
 void Shader::SetVec3(const std::string& name, const glm::vec3& value) const 
 {
-    glUniform3fv(glGetUniformLocation(m_ID, name.c_str()), 1, glm::value_ptr(value));
+    glUniform3fv(GetUniformLocation(name), 1, glm::value_ptr(value));
 }
 
 void Shader::SetVec4(const std::string& name, const glm::vec4& value) const 
 {
-    glUniform4fv(glGetUniformLocation(m_ID, name.c_str()), 1, &value[0]);
+    glUniform4fv(GetUniformLocation(name), 1, &value[0]);
 }
 
 void Shader::SetMat2(const std::string& name, const glm::mat2& mat) const 
 {
-    glUniformMatrix2fv(glGetUniformLocation(m_ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
 }
 
 void Shader::SetMat3(const std::string& name, const glm::mat3& mat) const 
 {
-    glUniformMatrix3fv(glGetUniformLocation(m_ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
 }
 
 void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const
  {
-    glUniformMatrix4fv(glGetUniformLocation(m_ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void Shader::SetVec3(int location, const glm::vec3& value) const 
+{
+    glUniform3fv(location, 1, glm::value_ptr(value));
+}
+
+void Shader::SetMat3(int location, const glm::mat3& mat) const 
+{
+    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void Shader::SetMat4(int location, const glm::mat4& mat) const 
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
 }
 
 int Shader::GetUniformLocation(const std::string& name) const 
 {
     // Check if the uniform location is already in the cache
-    if (m_uniformLocationCache.find(name) != m_uniformLocationCache.end()) 
+    auto it = m_uniformLocationCache.find(name);
+    if (it != m_uniformLocationCache.end()) 
     {
-        return m_uniformLocationCache[name];
+        return it->second;
     }
     
     // Otherwise, get the location and cache it
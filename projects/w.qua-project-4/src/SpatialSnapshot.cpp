@@ -0,0 +1,155 @@
+/**
+ * @file SpatialSnapshot.cpp
+ * @brief Implementation of the structure-of-arrays world AABB snapshot.
+ */
+
+#include "SpatialSnapshot.hpp"
+#include "SpatialTreeUtils.hpp"
+#include "Components.hpp"
+#include "Profiler.hpp"
+
+namespace
+{
+    // Entities per job when transforming bounds
+    constexpr size_t kGatherGrain = 16384;
+    // Entities per job when classifying against a frustum
+    constexpr size_t kClassifyGrain = 16384;
+    // Entities classified together against one plane after another; their flags stay in L1
+    constexpr size_t kClassifyBlock = 256;
+    // Same tolerance as ClassifyPlaneAabb
+    constexpr float kPlaneEpsilon = 1e-5f;
+
+    constexpr uint32_t kAbsent = std::numeric_limits<uint32_t>::max();
+
+    size_t EntityId(Registry::Entity entity)
+    {
+        return static_cast<size_t>(entt::to_entity(entity));
+    }
+}
+
+void SpatialSnapshot::Build(Registry& registry, bool parallel)
+{
+    PROFILE_SCOPE("SpatialSnapshot::Build");
+    ++m_Version;
+
+    // Forget the previous entities first so destroyed ones never resolve
+    for (Registry::Entity entity : m_Entities)
+    {
+        m_IndexOfEntity[EntityId(entity)] = kAbsent;
+    }
+    m_Entities.clear();
+
+    auto view = registry.View<TransformComponent, BoundingComponent>();
+    for (auto entity : view)
+    {
+        size_t id = EntityId(entity);
+        if (id >= m_IndexOfEntity.size())
+            m_IndexOfEntity.resize(id + 1, kAbsent);
+
+        m_IndexOfEntity[id] = static_cast<uint32_t>(m_Entities.size());
+        m_Entities.push_back(entity);
+    }
+
+    // Padded to whole classification blocks; the padding is never reported
+    const size_t count = m_Entities.size();
+    const size_t paddedCount = (count + kClassifyBlock - 1) / kClassifyBlock * kClassifyBlock;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        m_Min[axis].resize(paddedCount);
+        m_Max[axis].resize(paddedCount);
+    }
+
+    // Extents of each chunk, merged afterwards; min and max do not depend on the merge order
+    const size_t chunkCount = std::max<size_t>(1, (count + kGatherGrain - 1) / kGatherGrain);
+    std::vector<Aabb> chunkBounds(chunkCount, SpatialTreeUtils::EmptyBounds());
+
+    SpatialTreeUtils::ForEachChunk(parallel, count, kGatherGrain, [&](size_t begin, size_t end)
+    {
+        Aabb local = SpatialTreeUtils::EmptyBounds();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto& transform = view.get<TransformComponent>(m_Entities[i]);
+            const auto& bounding  = view.get<BoundingComponent>(m_Entities[i]);
+            Aabb box = bounding.GetAABB();
+            box.Transform(transform.m_Model);
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                m_Min[axis][i] = box.min[axis];
+                m_Max[axis][i] = box.max[axis];
+            }
+            SpatialTreeUtils::Expand(local, box);
+        }
+        chunkBounds[begin / kGatherGrain] = local;
+    });
+
+    Aabb total = SpatialTreeUtils::EmptyBounds();
+    for (const Aabb& bounds : chunkBounds)
+    {
+        SpatialTreeUtils::Expand(total, bounds);
+    }
+    SpatialTreeUtils::MakeCubicBounds(total.min, total.max, m_SceneBounds);
+}
+
+size_t SpatialSnapshot::FindIndex(Registry::Entity entity) const
+{
+    size_t id = EntityId(entity);
+    if (id >= m_IndexOfEntity.size())
+        return kInvalidIndex;
+
+    uint32_t index = m_IndexOfEntity[id];
+    // The identifier may have been recycled for a newer entity since the build
+    if (index == kAbsent || m_Entities[index] != entity)
+        return kInvalidIndex;
+
+    return index;
+}
+
+void SpatialSnapshot::ClassifyFrustum(const glm::vec3 planeNormals[6], const float planeDistances[6],
+                                      std::vector<SideResult>& out, bool parallel) const
+{
+    PROFILE_SCOPE("SpatialSnapshot::ClassifyFrustum");
+    out.resize(GetCount());
+
+    SpatialTreeUtils::ForEachChunk(parallel, GetCount(), kClassifyGrain, [&](size_t begin, size_t end)
+    {
+        for (size_t block = begin; block < end; block += kClassifyBlock)
+        {
+            const size_t blockCount = std::min(kClassifyBlock, end - block);
+            std::array<uint8_t, kClassifyBlock> outside{};
+            std::array<uint8_t, kClassifyBlock> straddles{};
+
+            for (int plane = 0; plane < 6; ++plane)
+            {
+                const glm::vec3& n = planeNormals[plane];
+                const float d = planeDistances[plane];
+
+                // The corners furthest along and against the normal bound the distances
+                // of all eight, so two dot products replace eight per plane
+                const float* farX  = (n.x >= 0.0f ? GetMax(0) : GetMin(0)) + block;
+                const float* farY  = (n.y >= 0.0f ? GetMax(1) : GetMin(1)) + block;
+                const float* farZ  = (n.z >= 0.0f ? GetMax(2) : GetMin(2)) + block;
+                const float* nearX = (n.x >= 0.0f ? GetMin(0) : GetMax(0)) + block;
+                const float* nearY = (n.y >= 0.0f ? GetMin(1) : GetMax(1)) + block;
+                const float* nearZ = (n.z >= 0.0f ? GetMin(2) : GetMax(2)) + block;
+
+                // Full blocks over the padded arrays give the loop a constant trip count,
+                // which the compiler vectorises even at -O2
+                for (size_t i = 0; i < kClassifyBlock; ++i)
+                {
+                    float farDistance  = n.x * farX[i]  + n.y * farY[i]  + n.z * farZ[i]  - d;
+                    float nearDistance = n.x * nearX[i] + n.y * nearY[i] + n.z * nearZ[i] - d;
+                    outside[i]   |= static_cast<uint8_t>(nearDistance > kPlaneEpsilon);
+                    straddles[i] |= static_cast<uint8_t>(farDistance >= -kPlaneEpsilon);
+                }
+            }
+
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                out[block + i] = outside[i]   ? SideResult::eOUTSIDE
+                               : straddles[i] ? SideResult::eOVERLAPPING
+                                              : SideResult::eINSIDE;
+            }
+        }
+    });
+}
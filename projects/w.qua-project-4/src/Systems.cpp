@@ -17,6 +17,8 @@
 #include "EventSystem.hpp"
 #include "DemoScene.hpp"
 #include "PickingSystem.hpp"
+#include "Profiler.hpp"
+#include "JobSystem.hpp"
 
 namespace Systems
 {
@@ -25,10 +27,16 @@ namespace Systems
     std::unique_ptr<RenderSystem> g_RenderSystem = nullptr;
     std::unique_ptr<PickingSystem> g_PickingSystem = nullptr;
     DemoSceneType g_CurrentDemoScene = DemoSceneType::MeshScene;
+    size_t g_JobWorkerCount = JobSystem::kAutoWorkerCount;
 
     void InitializeSystems(Registry& registry, Window& window, const std::shared_ptr<Shader>& shader) 
     {
-        EventSystem::Get().Initialize();        
+        // First, so scene setup can already load and process meshes in parallel
+        JobSystem::Get().Initialize(g_JobWorkerCount);
+        EventSystem::Get().Initialize();
+        // Spatial structures consume exact per-entity changes of these components
+        registry.TrackChanges<TransformComponent>();
+        registry.TrackChanges<BoundingComponent>();
         g_InputSystem = std::make_unique<InputSystem>(registry, window);
         g_CameraSystem = std::make_unique<CameraSystem>(registry, window);
         g_RenderSystem = std::make_unique<RenderSystem>(registry, window, shader);
@@ -40,12 +48,24 @@ namespace Systems
     
     void UpdateSystems(Registry& registry, Window& window, float deltaTime) 
     {
-        g_InputSystem->Update(deltaTime);
-        g_CameraSystem->Update(deltaTime);
+        PROFILE_SCOPE("Systems::UpdateSystems");
+        {
+            PROFILE_SCOPE("InputSystem::Update");
+            g_InputSystem->Update(deltaTime);
+        }
+        // No event type is queued at the moment: transform edits reach the spatial structures
+        // through registry change tracking, which already rebuilds them once per frame. This
+        // is the point where types switched to queued dispatch will be delivered.
+        EventSystem::Get().FlushEvents();
+        {
+            PROFILE_SCOPE("CameraSystem::Update");
+            g_CameraSystem->Update(deltaTime);
+        }
     }
     
     void RenderSystems(Registry& registry, Window& window) 
     {
+        PROFILE_SCOPE("Systems::RenderSystems");
         g_RenderSystem->Render();
     }
     
@@ -56,6 +76,7 @@ namespace Systems
         g_InputSystem.reset();
         g_PickingSystem.reset();
         EventSystem::Get().Shutdown();
+        JobSystem::Get().Shutdown();
     }
 
     void ResetCurrentScene(Registry& registry, Window& window)
@@ -64,7 +85,7 @@ namespace Systems
         {
             DemoScene::ResetScene(registry, window);
             
-            EventSystem::Get().FireEvent(EventType::SceneReset);
+            EventSystem::Get().Publish(SceneResetEvent{});
         }
     }
 }
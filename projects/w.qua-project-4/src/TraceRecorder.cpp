@@ -0,0 +1,194 @@
+/**
+ * @file TraceRecorder.cpp
+ * @brief Implementation of the profiling ring buffer and Chrome trace writer.
+ */
+
+#include "TraceRecorder.hpp"
+#include <ctime>
+#include <iomanip>
+
+namespace
+{
+    // Trace events use a single process; threads are the profiler's thread indices
+    constexpr int kTraceProcessId = 1;
+
+    /**
+     * @brief Writes a JSON string literal, escaping as required.
+     * @param out Output stream
+     * @param text Text to write
+     */
+    void WriteJsonString(std::ostream& out, const std::string& text)
+    {
+        out << '"';
+        for (char c : text)
+        {
+            switch (c)
+            {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n";  break;
+                case '\t': out << "\\t";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    else
+                        out << c;
+                    break;
+            }
+        }
+        out << '"';
+    }
+
+    // Trace timestamps are microseconds
+    double ToMicroseconds(uint64_t ns) { return static_cast<double>(ns) * 1e-3; }
+}
+
+TraceRecorder& TraceRecorder::Get()
+{
+    static TraceRecorder s_Instance;
+    return s_Instance;
+}
+
+void TraceRecorder::SetWindowSeconds(double seconds)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_WindowSeconds = std::max(seconds, 0.1);
+    TrimToWindow();
+}
+
+void TraceRecorder::AddFrame(const ProfileFrame& frame)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Frames.push_back(frame);
+    TrimToWindow();
+}
+
+void TraceRecorder::TrimToWindow()
+{
+    if (m_Frames.empty())
+        return;
+
+    const uint64_t windowNs = static_cast<uint64_t>(m_WindowSeconds * 1e9);
+    const uint64_t latestNs = m_Frames.back().m_EndNs;
+    while (!m_Frames.empty() && latestNs - m_Frames.front().m_EndNs > windowNs)
+    {
+        m_Frames.pop_front();
+    }
+}
+
+void TraceRecorder::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Frames.clear();
+}
+
+size_t TraceRecorder::GetFrameCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Frames.size();
+}
+
+double TraceRecorder::GetBufferedSeconds() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Frames.empty())
+        return 0.0;
+    return static_cast<double>(m_Frames.back().m_EndNs - m_Frames.front().m_StartNs) * 1e-9;
+}
+
+bool TraceRecorder::Save(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "TraceRecorder: Failed to open " << path << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> threadNames = Profiler::Get().GetThreadNames();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        WriteChromeTrace(file, m_Frames, threadNames);
+    }
+
+    if (!file.good())
+    {
+        std::cerr << "TraceRecorder: Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string TraceRecorder::SaveTimestamped() const
+{
+    std::time_t now = std::time(nullptr);
+    std::tm localTime{};
+#ifdef _WIN32
+    localtime_s(&localTime, &now);
+#else
+    localtime_r(&now, &localTime);
+#endif
+
+    std::ostringstream path;
+    path << "trace_" << std::put_time(&localTime, "%Y%m%d_%H%M%S") << ".json";
+    return Save(path.str()) ? path.str() : std::string();
+}
+
+void TraceRecorder::WriteChromeTrace(std::ostream& out, const std::deque<ProfileFrame>& frames,
+                                     const std::vector<std::string>& threadNames)
+{
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    auto separator = [&]()
+    {
+        if (!first)
+            out << ",\n";
+        first = false;
+    };
+
+    // Metadata: process and thread names
+    separator();
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << kTraceProcessId
+        << ",\"tid\":0,\"args\":{\"name\":\"Geometry Toolbox\"}}";
+    for (size_t t = 0; t < threadNames.size(); ++t)
+    {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << kTraceProcessId
+            << ",\"tid\":" << t << ",\"args\":{\"name\":";
+        WriteJsonString(out, threadNames[t]);
+        out << "}}";
+    }
+
+    for (const ProfileFrame& frame : frames)
+    {
+        // Global instant marking each frame boundary
+        separator();
+        out << "{\"name\":\"Frame " << frame.m_Index << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":" << kTraceProcessId
+            << ",\"tid\":0,\"ts\":" << ToMicroseconds(frame.m_StartNs) << "}";
+
+        for (const ProfileZoneRecord& zone : frame.m_Zones)
+        {
+            separator();
+            out << "{\"name\":";
+            WriteJsonString(out, zone.m_Name);
+            out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":" << kTraceProcessId
+                << ",\"tid\":" << zone.m_ThreadIndex
+                << ",\"ts\":" << ToMicroseconds(zone.m_StartNs)
+                << ",\"dur\":" << ToMicroseconds(zone.m_EndNs - zone.m_StartNs) << "}";
+        }
+
+        for (const ProfileCounterRecord& counter : frame.m_Counters)
+        {
+            separator();
+            out << "{\"name\":";
+            WriteJsonString(out, counter.m_Name);
+            out << ",\"ph\":\"C\",\"pid\":" << kTraceProcessId
+                << ",\"ts\":" << ToMicroseconds(counter.m_TimeNs)
+                << ",\"args\":{\"value\":" << counter.m_Value << "}}";
+        }
+    }
+
+    out << "\n]}\n";
+}
@@ -14,9 +14,13 @@
 // Static map to associate GLFW windows with Window instances
 static std::unordered_map<GLFWwindow*, Window*> windowMap;
 
-Window::Window(int width, int height, const std::string& title)
-    : m_Width(width), m_Height(height), m_Title(title), m_Window(nullptr)
+Window::Window(int width, int height, const std::string& title, bool headless)
+    : m_Width(width), m_Height(height), m_Title(title), m_Window(nullptr),
+      m_StartTime(std::chrono::steady_clock::now())
 {
+    if (headless)
+        return;
+
     static bool glfwInitialized = false;
     if (!glfwInitialized) 
     {
@@ -72,53 +76,72 @@ GLFWwindow* Window::GetHandle() const
 
 bool Window::ShouldClose() const 
 {
+    if (!m_Window)
+        return m_HeadlessShouldClose;
     return glfwWindowShouldClose(m_Window);
 }
 
 void Window::SetShouldClose(bool value) const 
 {
+    if (!m_Window)
+    {
+        m_HeadlessShouldClose = value;
+        return;
+    }
     glfwSetWindowShouldClose(m_Window, value);
 }
 
 void Window::PollEvents() const 
 {
-    glfwPollEvents();
+    if (m_Window)
+        glfwPollEvents();
 }
 
 void Window::SwapBuffers() const 
 {
-    glfwSwapBuffers(m_Window);
+    if (m_Window)
+        glfwSwapBuffers(m_Window);
 }
 
 void Window::SetTitle(const std::string& title)
 {
     m_Title = title;
-    glfwSetWindowTitle(m_Window, title.c_str());
+    if (m_Window)
+        glfwSetWindowTitle(m_Window, title.c_str());
 }
 
 bool Window::IsKeyPressed(int keyCode) const 
 {
-    return glfwGetKey(m_Window, keyCode) == GLFW_PRESS;
+    return m_Window && glfwGetKey(m_Window, keyCode) == GLFW_PRESS;
 }
 
 bool Window::IsMouseButtonPressed(int button) const
 {
-    return glfwGetMouseButton(m_Window, button) == GLFW_PRESS;
+    return m_Window && glfwGetMouseButton(m_Window, button) == GLFW_PRESS;
 }
 
 void Window::GetCursorPos(double* xpos, double* ypos) const
 {
+    if (!m_Window)
+    {
+        // Headless: the cursor rests at the centre of the viewport
+        *xpos = m_Width * 0.5;
+        *ypos = m_Height * 0.5;
+        return;
+    }
     glfwGetCursorPos(m_Window, xpos, ypos);
 }
 
 void Window::SetInputMode(int mode, int value) const 
 {
-    glfwSetInputMode(m_Window, mode, value);
+    if (m_Window)
+        glfwSetInputMode(m_Window, mode, value);
 }
 
 void Window::MakeContextCurrent() const 
 {
-    glfwMakeContextCurrent(m_Window);
+    if (m_Window)
+        glfwMakeContextCurrent(m_Window);
 }
 
 int Window::GetWidth() const 
@@ -133,6 +156,8 @@ int Window::GetHeight() const
 
 double Window::GetTime() const
 {
+    if (!m_Window)
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
     return glfwGetTime();
 }
 
@@ -4,6 +4,15 @@
  *
  * This file contains the main function that initializes the rendering window,
  * sets up the demo scene, and runs the main application loop.
+ *
+ * Command line:
+ *   --headless     Run without a window or GL context (benchmarking, CI)
+ *   --frames N     Number of frames to run in headless mode (default 300)
+ *   --profile      Enable the frame profiler from the start (headless: print zone statistics)
+ *   --trace PATH   Enable the profiler and save a Chrome trace of the last frames to PATH on exit
+ *   --workers N    Job system worker threads (default: one per extra core; 0 runs jobs on the main thread)
+ *
+ * F9 saves the profiler's recent frames as trace_<timestamp>.json in the working directory.
  */
 
 #include "pch.h"
@@ -15,16 +24,128 @@
 #include "ImGuiManager.hpp"
 #include "Keybinds.hpp"
 #include "EventSystem.hpp"
+#include "RenderSystem.hpp"
+#include "PickingSystem.hpp"
+#include "Profiler.hpp"
+#include "TraceRecorder.hpp"
+#include <iomanip>
 
 // Constants
 const int WINDOW_WIDTH = 1024;
 const int WINDOW_HEIGHT = 768;
 const char* WINDOW_TITLE = "Geometry Toolbox";
+const int DEFAULT_HEADLESS_FRAMES = 300;
 
-int main() 
+/**
+ * @brief Runs the frame pipeline without a window or GL context and prints timings.
+ * @param frameCount Number of frames to run
+ * @param tracePath Chrome trace written after the run, or empty for none
+ * @return Process exit code
+ */
+static int RunHeadless(int frameCount, const std::string& tracePath)
 {
+    Window window(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, true);
+    
+    Registry registry;
+    Systems::InitializeSystems(registry, window, nullptr);
+    
+    // Fixed time step so runs are comparable regardless of machine speed
+    const float deltaTime = 1.0f / 60.0f;
+    const glm::vec2 screenCentre(WINDOW_WIDTH * 0.5f, WINDOW_HEIGHT * 0.5f);
+    
+    size_t totalVertices = 0;
+    size_t totalDraws = 0;
+    auto start = std::chrono::steady_clock::now();
+    
+    // Keep every frame of the run for the statistics printed below
+    Profiler::Get().SetHistorySize(static_cast<size_t>(frameCount));
+    
+    for (int frame = 0; frame < frameCount && !window.ShouldClose(); ++frame)
+    {
+        Profiler::Get().BeginFrame();
+        Systems::UpdateSystems(registry, window, deltaTime);
+        Systems::RenderSystems(registry, window);
+        
+        // Exercise picking the way a click in the middle of the view would
+        Systems::g_PickingSystem->Pick(screenCentre);
+        Profiler::Get().EndFrame();
+        
+        totalVertices += Systems::g_RenderSystem->GetLastFrameVertexCount();
+        totalDraws += Systems::g_RenderSystem->GetLastFrameStateStats().m_DrawCalls;
+    }
+    
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double frames = static_cast<double>(std::max(frameCount, 1));
+    std::cout << "Headless run: " << frameCount << " frames in " << elapsedMs << " ms ("
+              << elapsedMs / frames << " ms/frame)\n"
+              << "  Draw calls per frame: " << totalDraws / frames << "\n"
+              << "  Vertices per frame:   " << totalVertices / frames << std::endl;
+    
+    if (Profiler::Get().IsEnabled())
+    {
+        std::cout << "  " << std::left << std::setw(32) << "Zone" << std::right
+                  << std::setw(10) << "avg ms" << std::setw(10) << "p50 ms"
+                  << std::setw(10) << "p95 ms" << std::setw(10) << "max ms" << "\n"
+                  << std::fixed << std::setprecision(3);
+        for (const ProfileZoneStats& zone : Profiler::Get().ComputeZoneStats())
+        {
+            std::cout << "  " << std::left << std::setw(32) << zone.m_Name << std::right
+                      << std::setw(10) << zone.m_AverageMs << std::setw(10) << zone.m_P50Ms
+                      << std::setw(10) << zone.m_P95Ms << std::setw(10) << zone.m_MaxMs << "\n";
+        }
+        std::cout << std::flush;
+    }
+    
+    if (!tracePath.empty() && TraceRecorder::Get().Save(tracePath))
+    {
+        std::cout << "Trace written to " << tracePath << std::endl;
+    }
+    
+    Systems::ShutdownSystems(registry);
+    return 0;
+}
+
+int main(int argc, char** argv) 
+{
+    // Before any worker starts, so the main thread owns the first profiler buffer
+    Profiler::Get().SetThreadName("Main");
+
+    bool headless = false;
+    int headlessFrames = DEFAULT_HEADLESS_FRAMES;
+    std::string tracePath;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--headless")
+        {
+            headless = true;
+        }
+        else if (arg == "--frames" && i + 1 < argc)
+        {
+            headlessFrames = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--profile")
+        {
+            Profiler::Get().SetEnabled(true);
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+            Profiler::Get().SetEnabled(true);
+        }
+        else if (arg == "--workers" && i + 1 < argc)
+        {
+            Systems::g_JobWorkerCount = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        }
+    }
+    
     try 
     {
+        if (headless)
+        {
+            return RunHeadless(headlessFrames, tracePath);
+        }
+        
         Window window(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE);
         window.MakeContextCurrent();
         
@@ -59,12 +180,30 @@ int main()
             }
         });
         
+        // F9 saves the last few seconds of profiled frames, e.g. right after a hitch
+        EventSystem::Get().SubscribeToEvent(EventType::KeyPress, [](const EventData& eventData) {
+            if (auto keyCode = std::get_if<int>(&eventData)) {
+                if (*keyCode == Keybinds::KEY_F9) {
+                    if (!Profiler::Get().IsEnabled()) {
+                        std::cout << "Profiler is disabled; enable it to record a trace" << std::endl;
+                        return;
+                    }
+                    std::string path = TraceRecorder::Get().SaveTimestamped();
+                    if (!path.empty()) {
+                        std::cout << "Trace written to " << path << std::endl;
+                    }
+                }
+            }
+        });
+        
         // Game loop variables
         float lastFrame = 0.0f;
         
         // MAIN LOOP
         while (!window.ShouldClose()) 
         {
+            Profiler::Get().BeginFrame();
+            
             auto currentFrame = (float)window.GetTime();
             float deltaTime = currentFrame - lastFrame;
             lastFrame = currentFrame;
@@ -76,13 +215,34 @@ int main()
             
             Systems::RenderSystems(registry, window);
             
-            // ImGui New Frame
-            imguiManager.NewFrame();
-            imguiManager.RenderMainWindow(registry);
-            imguiManager.Render();
+            {
+                PROFILE_SCOPE("ImGui");
+                imguiManager.NewFrame();
+                imguiManager.RenderMainWindow(registry);
+                {
+                    // Same name on both timers so the profiler panel can pair them
+                    PROFILE_SCOPE("Pass: ImGui");
+                    GpuPassScope gpuPass(Systems::g_RenderSystem->GetGpuTimer(), "Pass: ImGui");
+                    imguiManager.Render();
+                }
+            }
             
-            window.SwapBuffers();
-            window.PollEvents();
+            {
+                // Includes the vsync wait
+                PROFILE_SCOPE("Window::SwapBuffers");
+                window.SwapBuffers();
+            }
+            {
+                PROFILE_SCOPE("Window::PollEvents");
+                window.PollEvents();
+            }
+            
+            Profiler::Get().EndFrame();
+        }
+        
+        if (!tracePath.empty() && TraceRecorder::Get().Save(tracePath))
+        {
+            std::cout << "Trace written to " << tracePath << std::endl;
         }
         
         imguiManager.Shutdown();
@@ -0,0 +1,44 @@
+/**
+ * @file SpatialTreeTestUtils.hpp
+ * @brief Scene and query helpers shared by the spatial structure tests.
+ */
+
+#pragma once
+
+#include "Registry.hpp"
+#include "Components.hpp"
+#include "Shapes.hpp"
+
+namespace SpatialTreeTestUtils
+{
+    // Axis-aligned query box as six frustum planes; a point is inside when dot(n, p) <= d for every plane
+    inline void MakeBoxPlanes(const glm::vec3& min, const glm::vec3& max, glm::vec3 normals[6], float distances[6])
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            normals[axis * 2]         = glm::vec3(0.0f);
+            normals[axis * 2][axis]   = 1.0f;
+            distances[axis * 2]       = max[axis];
+            normals[axis * 2 + 1]       = glm::vec3(0.0f);
+            normals[axis * 2 + 1][axis] = -1.0f;
+            distances[axis * 2 + 1]     = -min[axis];
+        }
+    }
+
+    // Entity with a transform at 'position' scaled by 'scale', bounded by 'localBox'
+    inline Registry::Entity CreateBoxEntity(Registry& registry, const glm::vec3& position,
+                                            const glm::vec3& scale, const Aabb& localBox)
+    {
+        auto entity = registry.Create();
+        registry.AddComponent<TransformComponent>(entity, position, glm::vec3(0.0f), scale);
+        registry.AddComponent<BoundingComponent>(entity).m_AABB = localBox;
+        return entity;
+    }
+
+    // Entity with a bounding box of size 'scale' centred at 'position'
+    inline Registry::Entity CreateBoxEntity(Registry& registry, const glm::vec3& position,
+                                            const glm::vec3& scale = glm::vec3(0.1f))
+    {
+        return CreateBoxEntity(registry, position, scale, Aabb(position - scale * 0.5f, position + scale * 0.5f));
+    }
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include "EventSystem.hpp"
+
+class EventSystemTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        EventSystem::Get().Shutdown();
+        EventSystem::Get().Initialize();
+    }
+
+    void TearDown() override
+    {
+        EventSystem::Get().Shutdown();
+    }
+};
+
+// Event types not switched to queued dispatch still reach subscribers inside FireEvent
+TEST_F(EventSystemTest, ImmediateByDefault)
+{
+    EventSystem& events = EventSystem::Get();
+    int received = 0;
+    events.SubscribeToEvent(EventType::KeyPress, [&received](const EventData& data) {
+        received += std::get<int>(data);
+    });
+
+    events.FireEvent(EventType::KeyPress, 3);
+    EXPECT_EQ(received, 3);
+    EXPECT_EQ(events.GetDispatchMode(EventType::KeyPress), EventDispatchMode::Immediate);
+    EXPECT_EQ(events.GetQueuedEventCount(EventType::KeyPress), 0u);
+}
+
+// Repeated TransformChanged events for one entity collapse into one delivery per flush
+TEST_F(EventSystemTest, QueuedEventsCoalescePerEntity)
+{
+    EventSystem& events = EventSystem::Get();
+    events.SetDispatchMode(EventType::TransformChanged, EventDispatchMode::Queued, EventCoalescing::LatestPerEntity);
+
+    std::vector<entt::entity> received;
+    events.SubscribeToEvent(EventType::TransformChanged, [&received](const EventData& data) {
+        received.push_back(std::get<entt::entity>(data));
+    });
+
+    const entt::entity a = static_cast<entt::entity>(1);
+    const entt::entity b = static_cast<entt::entity>(2);
+    for (int i = 0; i < 10; ++i)
+    {
+        events.FireEvent(EventType::TransformChanged, a);
+        events.FireEvent(EventType::TransformChanged, b);
+    }
+
+    EXPECT_TRUE(received.empty());
+    EXPECT_EQ(events.GetQueuedEventCount(EventType::TransformChanged), 2u);
+
+    events.FlushEvents();
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0], a);
+    EXPECT_EQ(received[1], b);
+
+    const EventQueueStats& stats = events.GetLastFlushStats();
+    EXPECT_EQ(stats.m_Queued, 20u);
+    EXPECT_EQ(stats.m_Coalesced, 18u);
+    EXPECT_EQ(stats.m_Dispatched, 2u);
+
+    // Nothing left for the next frame
+    events.FlushEvents();
+    EXPECT_EQ(received.size(), 2u);
+}
+
+// LatestOnly keeps just the last payload
+TEST_F(EventSystemTest, LatestOnlyDeliversLastEvent)
+{
+    EventSystem& events = EventSystem::Get();
+    events.SetDispatchMode(EventType::MouseMove, EventDispatchMode::Queued, EventCoalescing::LatestOnly);
+
+    std::vector<glm::vec2> received;
+    events.SubscribeToEvent(EventType::MouseMove, [&received](const EventData& data) {
+        received.push_back(std::get<glm::vec2>(data));
+    });
+
+    events.FireEvent(EventType::MouseMove, glm::vec2(1.0f, 2.0f));
+    events.FireEvent(EventType::MouseMove, glm::vec2(3.0f, 4.0f));
+    events.FlushEvents();
+
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], glm::vec2(3.0f, 4.0f));
+}
+
+// Events fired by a subscriber during a flush wait for the next flush
+TEST_F(EventSystemTest, EventsFiredDuringFlushAreDeferred)
+{
+    EventSystem& events = EventSystem::Get();
+    events.SetDispatchMode(EventType::SceneReset, EventDispatchMode::Queued);
+
+    int deliveries = 0;
+    events.SubscribeToEvent(EventType::SceneReset, [&deliveries](const EventData&) {
+        ++deliveries;
+        EventSystem::Get().FireEvent(EventType::SceneReset);
+    });
+
+    events.FireEvent(EventType::SceneReset);
+    events.FlushEvents();
+    EXPECT_EQ(deliveries, 1);
+    EXPECT_EQ(events.GetQueuedEventCount(EventType::SceneReset), 1u);
+
+    events.FlushEvents();
+    EXPECT_EQ(deliveries, 2);
+}
+
+// Typed events reach typed subscribers and EventData subscribers alike
+TEST_F(EventSystemTest, TypedAndVariantApisShareChannels)
+{
+    EventSystem& events = EventSystem::Get();
+
+    int typedKey = 0;
+    int variantKey = 0;
+    events.Subscribe<KeyPressEvent>([&typedKey](const KeyPressEvent& event) { typedKey = event.m_Key; });
+    events.SubscribeToEvent(EventType::KeyPress, [&variantKey](const EventData& data) {
+        variantKey = std::get<int>(data);
+    });
+    EXPECT_EQ(events.GetObserverCount(EventType::KeyPress), 2u);
+
+    events.Publish(KeyPressEvent{ 7 });
+    EXPECT_EQ(typedKey, 7);
+    EXPECT_EQ(variantKey, 7);
+
+    events.FireEvent(EventType::KeyPress, 9);
+    EXPECT_EQ(typedKey, 9);
+    EXPECT_EQ(variantKey, 9);
+
+    // Mismatched payloads are rejected rather than delivered, and assert in debug builds
+    EXPECT_DEBUG_DEATH(events.FireEvent(EventType::KeyPress, 1.5f), "payload does not match");
+    EXPECT_EQ(typedKey, 9);
+}
+
+// Typed dispatch modes and per-entity coalescing behave like the EventType ones
+TEST_F(EventSystemTest, TypedQueueCoalescesPerEntity)
+{
+    EventSystem& events = EventSystem::Get();
+    events.SetDispatchMode<TransformChangedEvent>(EventDispatchMode::Queued, EventCoalescing::LatestPerEntity);
+    EXPECT_EQ(events.GetDispatchMode(EventType::TransformChanged), EventDispatchMode::Queued);
+
+    int deliveries = 0;
+    events.Subscribe<TransformChangedEvent>([&deliveries](const TransformChangedEvent&) { ++deliveries; });
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        events.Publish(TransformChangedEvent{ static_cast<entt::entity>(i % 4) });
+    }
+    events.FlushEvents();
+    EXPECT_EQ(deliveries, 4);
+}
+
+// A subscriber added from inside a callback starts with the next publish
+TEST_F(EventSystemTest, SubscribeDuringDispatchIsDeferred)
+{
+    EventSystem& events = EventSystem::Get();
+
+    int lateKeys = 0;
+    int earlyKeys = 0;
+    events.Subscribe<KeyPressEvent>([&events, &earlyKeys, &lateKeys](const KeyPressEvent& event) {
+        earlyKeys += event.m_Key;
+        for (int i = 0; i < 8; ++i)
+        {
+            events.Subscribe<KeyPressEvent>([&lateKeys](const KeyPressEvent& late) { lateKeys += late.m_Key; });
+        }
+    });
+
+    events.Publish(KeyPressEvent{ 1 });
+    EXPECT_EQ(earlyKeys, 1);
+    EXPECT_EQ(lateKeys, 0);
+    EXPECT_EQ(events.GetObserverCount(EventType::KeyPress), 9u);
+
+    events.Publish(KeyPressEvent{ 2 });
+    EXPECT_EQ(earlyKeys, 3);
+    EXPECT_EQ(lateKeys, 16);
+}
+
+// Delegates own non-trivial captures and release them with the subscription
+TEST_F(EventSystemTest, DelegateReleasesCapturedState)
+{
+    auto counter = std::make_shared<int>(0);
+    std::weak_ptr<int> watch = counter;
+    {
+        EventDelegate<SceneResetEvent> delegate([counter](const SceneResetEvent&) { ++*counter; });
+        EventDelegate<SceneResetEvent> moved(std::move(delegate));
+        EXPECT_FALSE(static_cast<bool>(delegate));
+        moved(SceneResetEvent{});
+        EXPECT_EQ(*counter, 1);
+    }
+    EXPECT_EQ(watch.use_count(), 1);
+
+    EventSystem::Get().Subscribe<SceneResetEvent>([counter](const SceneResetEvent&) { ++*counter; });
+    EXPECT_EQ(watch.use_count(), 2);
+    EventSystem::Get().ClearAllEventSubscriptions();
+    EXPECT_EQ(watch.use_count(), 1);
+}
+
+// Clearing one type also frees the EventData callbacks adapted onto its channel
+TEST_F(EventSystemTest, ClearingOneTypeReleasesAdaptedCallbacks)
+{
+    EventSystem& events = EventSystem::Get();
+    auto counter = std::make_shared<int>(0);
+    std::weak_ptr<int> watch = counter;
+
+    events.SubscribeToEvent(EventType::KeyPress, [counter](const EventData&) { ++*counter; });
+    events.SubscribeToEvent(EventType::KeyRelease, [counter](const EventData&) { ++*counter; });
+    EXPECT_EQ(watch.use_count(), 3);
+
+    events.ClearEventSubscriptions(EventType::KeyPress);
+    EXPECT_EQ(watch.use_count(), 2);
+    EXPECT_EQ(events.GetObserverCount(EventType::KeyPress), 0u);
+
+    events.FireEvent(EventType::KeyRelease, 4);
+    EXPECT_EQ(*counter, 1);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "Geometry.hpp"
 #include "Buffer.hpp"
+#include "Components.hpp"
 
 class GeometryTest : public ::testing::Test 
 {
@@ -192,6 +193,36 @@ TEST_F(GeometryTest, TransformAabbTranslation)
     EXPECT_NEAR(max.z, 5.0f, 0.001f);  // 1 + 4 = 5
 }
 
+// Normal Matrix Tests
+TEST_F(GeometryTest, ComputeNormalMatrixKeepsNormalsPerpendicular)
+{
+    glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::scale(model, glm::vec3(4.0f, 1.0f, 0.5f));
+    
+    // Tangent and normal of a slanted plane; non-uniform scale breaks mat3(model) * normal
+    glm::vec3 tangent = glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f));
+    glm::vec3 normal  = glm::normalize(glm::vec3(1.0f, -1.0f, 0.0f));
+    
+    glm::vec3 worldTangent = glm::mat3(model) * tangent;
+    glm::vec3 worldNormal  = ComputeNormalMatrix(model) * normal;
+    
+    EXPECT_NEAR(glm::dot(worldTangent, worldNormal), 0.0f, 1e-5f);
+}
+
+TEST_F(GeometryTest, TransformComponentNormalMatrixMatchesInverseTranspose)
+{
+    TransformComponent transform(glm::vec3(1.0f, -2.0f, 3.0f), glm::vec3(20.0f, -65.0f, 110.0f), glm::vec3(2.0f, -0.5f, 7.0f));
+    
+    glm::mat3 expected = ComputeNormalMatrix(transform.m_Model);
+    for (int column = 0; column < 3; ++column)
+    {
+        for (int row = 0; row < 3; ++row)
+        {
+            EXPECT_NEAR(transform.m_NormalMatrix[column][row], expected[column][row], 1e-5f);
+        }
+    }
+}
+
 // AABB Creation Tests
 TEST_F(GeometryTest, CreateAabbBruteForce) 
 {
@@ -268,6 +299,48 @@ TEST_F(GeometryTest, CreateObbPCA)
     EXPECT_NEAR(extents[2], 3.0f, 0.1f);
 }
 
+TEST_F(GeometryTest, CreateObbPCALargeOffsetMesh) 
+{
+    // Enough vertices to take the multi-threaded path, far from the origin
+    // so a naive single-pass variance would lose precision
+    std::vector<Vertex> vertices;
+    const glm::vec3 offset(1000.0f, -500.0f, 250.0f);
+    for (int x = 0; x <= 100; ++x)
+    {
+        for (int y = 0; y <= 50; ++y)
+        {
+            for (int z = 0; z <= 20; ++z)
+            {
+                glm::vec3 p(x * 0.04f - 2.0f, y * 0.04f - 1.0f, z * 0.025f - 0.25f);
+                vertices.push_back({offset + p, glm::vec3(1.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f)});
+            }
+        }
+    }
+    
+    glm::vec3 center;
+    glm::vec3 axes[3];
+    glm::vec3 halfExtents;
+    CreateObbPCA(vertices.data(), vertices.size(), &center, axes, &halfExtents);
+    
+    EXPECT_NEAR(center.x, offset.x, 1e-2f);
+    EXPECT_NEAR(center.y, offset.y, 1e-2f);
+    EXPECT_NEAR(center.z, offset.z, 1e-2f);
+    
+    std::vector<float> extents = {halfExtents.x, halfExtents.y, halfExtents.z};
+    std::sort(extents.begin(), extents.end());
+    
+    EXPECT_NEAR(extents[0], 0.25f, 1e-2f);
+    EXPECT_NEAR(extents[1], 1.0f, 1e-2f);
+    EXPECT_NEAR(extents[2], 2.0f, 1e-2f);
+    
+    Vertex sphereCenter;
+    float radius;
+    CreateSpherePCA(vertices.data(), vertices.size(), &sphereCenter, &radius);
+    
+    EXPECT_NEAR(glm::length(sphereCenter.m_Position - offset), 0.0f, 1e-2f);
+    EXPECT_NEAR(radius, glm::length(glm::vec3(2.0f, 1.0f, 0.25f)), 1e-2f);
+}
+
 // Edge Cases
 TEST_F(GeometryTest, ClassifyPlaneAabbOnPlane) 
 {
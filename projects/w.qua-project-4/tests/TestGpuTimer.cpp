@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "GpuTimer.hpp"
+#include <GLFW/glfw3.h>
+
+// Without a context (headless mode) every call is a no-op and nothing is reported
+TEST(GpuTimerTest, InertWithoutContext)
+{
+    GpuTimer timer;
+    timer.Initialize(false);
+    EXPECT_FALSE(timer.IsAvailable());
+
+    timer.BeginFrame();
+    {
+        GpuPassScope pass(timer, "Pass: Meshes");
+    }
+    EXPECT_FALSE(timer.BeginPass("Pass: Meshes"));
+    EXPECT_TRUE(timer.GetTimings().empty());
+    EXPECT_EQ(timer.GetTotalMs(), 0.0);
+    timer.Shutdown();
+}
+
+// Hidden window providing a real GL context; tests are skipped where none can be created
+class GpuTimerContextTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!glfwInit())
+            GTEST_SKIP() << "GLFW could not be initialized (no display)";
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(64, 64, "GpuTimerTest", nullptr, nullptr);
+        if (!window)
+            GTEST_SKIP() << "No GL 3.3 context available";
+
+        glfwMakeContextCurrent(window);
+        glewExperimental = GL_TRUE;
+        if (glewInit() != GLEW_OK)
+            GTEST_SKIP() << "GLEW could not load the GL entry points";
+    }
+
+    void TearDown() override
+    {
+        if (window)
+            glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+
+    GLFWwindow* window = nullptr;
+};
+
+// A pass timed in one frame is read back kFrameLatency frames later
+TEST_F(GpuTimerContextTest, TimedPassReportsAfterFrameLatency)
+{
+    GpuTimer timer;
+    timer.Initialize(true);
+    if (!timer.IsAvailable())
+        GTEST_SKIP() << "Context has no timer query support";
+
+    for (size_t frame = 0; frame < GpuTimer::kFrameLatency; ++frame)
+    {
+        timer.BeginFrame();
+        {
+            GpuPassScope pass(timer, "Pass: Clear");
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        // Finished before its slot comes round again, so no result is dropped
+        glFinish();
+        EXPECT_TRUE(timer.GetTimings().empty());
+    }
+
+    // Reuses the first frame's slot and reads its query
+    timer.BeginFrame();
+    std::vector<GpuPassTiming> timings = timer.GetTimings();
+    ASSERT_EQ(timings.size(), 1u);
+    EXPECT_STREQ(timings[0].m_Name, "Pass: Clear");
+    EXPECT_GE(timings[0].m_LastMs, 0.0);
+    EXPECT_EQ(timings[0].m_AverageMs, timings[0].m_LastMs);
+    EXPECT_GE(timer.GetTotalMs(), 0.0);
+    EXPECT_EQ(timer.GetDroppedResults(), 0u);
+
+    timer.Shutdown();
+    EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+}
+
+// A pass that stops being issued (e.g. hidden tree cells) leaves the timings and the total
+TEST_F(GpuTimerContextTest, PassNoLongerIssuedDropsOut)
+{
+    GpuTimer timer;
+    timer.Initialize(true);
+    if (!timer.IsAvailable())
+        GTEST_SKIP() << "Context has no timer query support";
+
+    for (size_t frame = 0; frame < GpuTimer::kFrameLatency; ++frame)
+    {
+        timer.BeginFrame();
+        {
+            GpuPassScope pass(timer, "Pass: Octree Cells");
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        glFinish();
+    }
+
+    // Reads back the frames still in flight
+    for (size_t frame = 0; frame < GpuTimer::kFrameLatency; ++frame)
+    {
+        timer.BeginFrame();
+    }
+    EXPECT_EQ(timer.GetTimings().size(), 1u);
+
+    for (size_t frame = 1; frame < GpuTimer::kFrameLatency; ++frame)
+    {
+        timer.BeginFrame();
+        EXPECT_EQ(timer.GetTimings().size(), 1u);
+    }
+
+    timer.BeginFrame();
+    EXPECT_TRUE(timer.GetTimings().empty());
+    EXPECT_EQ(timer.GetTotalMs(), 0.0);
+    timer.Shutdown();
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "JobSystem.hpp"
+#include <numeric>
+
+class JobSystemTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        JobSystem::Get().Shutdown();
+        JobSystem::Get().ResetStats();
+    }
+};
+
+// Without workers jobs run inline, in submission order
+TEST_F(JobSystemTest, SingleThreadedRunsInline)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Initialize(0);
+    EXPECT_TRUE(jobs.IsSingleThreaded());
+    EXPECT_EQ(jobs.GetThreadCount(), 1u);
+
+    std::vector<int> order;
+    JobCounter counter;
+    for (int i = 0; i < 4; ++i)
+    {
+        jobs.Run(counter, [&order, i]() { order.push_back(i); });
+        EXPECT_TRUE(counter.IsDone());
+    }
+    jobs.Wait(counter);
+    EXPECT_EQ(order, std::vector<int>({ 0, 1, 2, 3 }));
+
+    // Chunk boundaries follow the grain size, visited in order
+    std::vector<std::pair<size_t, size_t>> ranges;
+    jobs.ParallelFor(10, 4, [&ranges](size_t begin, size_t end) { ranges.emplace_back(begin, end); });
+    std::vector<std::pair<size_t, size_t>> expected = { { 0, 4 }, { 4, 8 }, { 8, 10 } };
+    EXPECT_EQ(ranges, expected);
+}
+
+// Every index of a parallel loop is visited exactly once
+TEST_F(JobSystemTest, ParallelForCoversRangeOnce)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Initialize(3);
+    EXPECT_EQ(jobs.GetWorkerCount(), 3u);
+
+    const size_t count = 100000;
+    std::vector<std::atomic<int>> visits(count);
+    jobs.ParallelFor(count, 1000, [&visits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+    }
+}
+
+// Jobs forking children onto their own counter and waiting on them do not deadlock
+TEST_F(JobSystemTest, NestedForkJoin)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Initialize(2);
+
+    // Sum of [begin, end) by recursive halving, as a tree build would split its nodes
+    std::function<uint64_t(uint64_t, uint64_t)> sum = [&](uint64_t begin, uint64_t end) -> uint64_t {
+        if (end - begin <= 64)
+        {
+            uint64_t local = 0;
+            for (uint64_t i = begin; i < end; ++i)
+                local += i;
+            return local;
+        }
+
+        uint64_t middle = begin + (end - begin) / 2;
+        uint64_t upper = 0;
+        JobCounter children;
+        jobs.Run(children, [&]() { upper = sum(middle, end); });
+        uint64_t lower = sum(begin, middle);
+        jobs.Wait(children);
+        return lower + upper;
+    };
+
+    const uint64_t n = 1 << 16;
+    EXPECT_EQ(sum(0, n), n * (n - 1) / 2);
+    EXPECT_GT(jobs.GetStats().m_Executed, 0u);
+}
+
+// Restarting with a different worker count keeps the system usable
+TEST_F(JobSystemTest, ReinitializeChangesWorkerCount)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Initialize(4);
+    EXPECT_EQ(jobs.GetThreadCount(), 5u);
+
+    std::atomic<int> total{ 0 };
+    JobCounter counter;
+    for (int i = 1; i <= 100; ++i)
+    {
+        jobs.Run(counter, [&total, i]() { total += i; });
+    }
+    jobs.Wait(counter);
+    EXPECT_EQ(total.load(), 5050);
+
+    jobs.Initialize(1);
+    EXPECT_EQ(jobs.GetWorkerCount(), 1u);
+    std::vector<int> values(1000);
+    jobs.ParallelFor(values.size(), 16, [&values](size_t begin, size_t end) {
+        std::iota(values.begin() + begin, values.begin() + end, static_cast<int>(begin));
+    });
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 999 * 1000 / 2);
+
+    jobs.Shutdown();
+    EXPECT_TRUE(jobs.IsSingleThreaded());
+}
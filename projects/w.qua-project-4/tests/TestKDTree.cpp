@@ -1,9 +1,9 @@
 #include <gtest/gtest.h>
-#include <algorithm>
 #include "KDTree.hpp"
 #include "Registry.hpp"
 #include "Components.hpp"
 #include "Shapes.hpp"
+#include "SpatialTreeTestUtils.hpp"
 
 class KDTreeTest : public ::testing::Test
 {
@@ -21,15 +21,9 @@ protected:
         registry.reset();
     }
 
-    Registry::Entity CreateTestEntity(const glm::vec3& position,
-                                      const glm::vec3& scale = glm::vec3(0.1f))
+    Registry::Entity CreateTestEntity(const glm::vec3& position)
     {
-        auto entity = registry->Create();
-        registry->AddComponent<TransformComponent>(entity, position, glm::vec3(0.0f), scale);
-        auto& bounds = registry->AddComponent<BoundingComponent>(entity);
-        bounds.m_AABB = Aabb(position - scale * 0.5f, position + scale * 0.5f);
-        bounds.m_AABBComputed = true;
-        return entity;
+        return SpatialTreeTestUtils::CreateBoxEntity(*registry, position);
     }
 
     std::unique_ptr<Registry> registry;
@@ -74,8 +68,8 @@ static void CollectLeaves(const KdNode* node, std::vector<const KdNode*>& leaves
         leaves.push_back(node);
         return;
     }
-    CollectLeaves(node->left.get(),  leaves);
-    CollectLeaves(node->right.get(), leaves);
+    CollectLeaves(node->left,  leaves);
+    CollectLeaves(node->right, leaves);
 }
 
 TEST_F(KDTreeTest, Stress32Objects)
@@ -114,4 +108,4 @@ TEST_F(KDTreeTest, Stress32Objects)
     }
 
     EXPECT_EQ(totalObjects, 32u);
-} 
\ No newline at end of file
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "MeshSimplifier.hpp"
+
+class MeshSimplifierTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Closed unit UV sphere stored as a non-indexed triangle list
+        const int slices = 48;
+        const int stacks = 24;
+
+        auto point = [&](int stack, int slice)
+        {
+            if (stack == 0)      return glm::vec3(0.0f, 1.0f, 0.0f);
+            if (stack == stacks) return glm::vec3(0.0f, -1.0f, 0.0f);
+
+            float phi   = glm::pi<float>() * stack / stacks;
+            float theta = glm::two_pi<float>() * (slice % slices) / slices;
+            return glm::vec3(std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi));
+        };
+
+        auto vertex = [](const glm::vec3& p)
+        {
+            Vertex v{};
+            v.m_Position = p;
+            v.m_Normal   = p;
+            return v;
+        };
+
+        for (int i = 0; i < stacks; ++i)
+        {
+            for (int j = 0; j < slices; ++j)
+            {
+                glm::vec3 a = point(i, j), b = point(i, j + 1);
+                glm::vec3 c = point(i + 1, j), d = point(i + 1, j + 1);
+
+                if (i != 0)
+                {
+                    sphere.push_back(vertex(a)); sphere.push_back(vertex(b)); sphere.push_back(vertex(c));
+                }
+                if (i != stacks - 1)
+                {
+                    sphere.push_back(vertex(b)); sphere.push_back(vertex(d)); sphere.push_back(vertex(c));
+                }
+            }
+        }
+    }
+
+    std::vector<Vertex> sphere;
+};
+
+TEST_F(MeshSimplifierTest, FullRatioKeepsAllTriangles)
+{
+    auto result = SimplifyMeshQuadric(sphere, 1.0f);
+    EXPECT_EQ(result.size(), sphere.size());
+}
+
+TEST_F(MeshSimplifierTest, ReducesTowardsTargetRatio)
+{
+    auto result = SimplifyMeshQuadric(sphere, 0.25f);
+
+    ASSERT_EQ(result.size() % 3, 0u);
+    EXPECT_LT(result.size(), sphere.size() / 2);
+    EXPECT_GT(result.size(), sphere.size() / 8);
+}
+
+TEST_F(MeshSimplifierTest, PreservesShape)
+{
+    auto result = SimplifyMeshQuadric(sphere, 0.25f);
+
+    for (const auto& v : result)
+    {
+        EXPECT_NEAR(glm::length(v.m_Position), 1.0f, 0.05f);
+    }
+}
+
+TEST_F(MeshSimplifierTest, EmptyInputReturnsEmpty)
+{
+    std::vector<Vertex> empty;
+    EXPECT_TRUE(SimplifyMeshQuadric(empty, 0.5f).empty());
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "RenderState.hpp"
+#include "NullRenderable.hpp"
+
+// Null backend tests run without a GL context
+TEST(NullBackendTest, StateCacheCountsOnlyRealChanges)
+{
+    RenderStateCache cache;
+    cache.SetNullBackend(true);
+    cache.Invalidate();
+
+    cache.UseProgram(3);
+    cache.UseProgram(3);
+    cache.BindVertexArray(5);
+    cache.BindVertexArray(6);
+    cache.SetPolygonMode(GL_FILL);
+    cache.SetPolygonMode(GL_FILL);
+    cache.CountDraw();
+
+    const RenderStateStats& stats = cache.GetStats();
+    EXPECT_EQ(stats.m_ProgramChanges, 1u);
+    EXPECT_EQ(stats.m_VertexArrayChanges, 2u);
+    EXPECT_EQ(stats.m_PolygonModeChanges, 1u);
+    EXPECT_EQ(stats.m_DrawCalls, 1u);
+
+    cache.ResetStats();
+    EXPECT_EQ(cache.GetStats().m_ProgramChanges, 0u);
+}
+
+TEST(NullBackendTest, NullRenderableRecordsDraws)
+{
+    NullRenderable renderable(36);
+    renderable.Initialize(nullptr);
+
+    EXPECT_EQ(renderable.GetLODCount(), 1);
+    EXPECT_EQ(renderable.GetVertexCount(), 36u);
+
+    renderable.Render(glm::mat4(1.0f), glm::mat3(1.0f));
+    renderable.Render(glm::mat4(1.0f), glm::mat3(1.0f));
+
+    EXPECT_EQ(renderable.GetDrawCount(), 2u);
+    EXPECT_EQ(renderable.GetSubmittedVertexCount(), 72u);
+}
+
+TEST(NullBackendTest, NullRenderableClampsLODLevel)
+{
+    NullRenderable renderable(12);
+
+    renderable.SetLODLevel(5);
+    EXPECT_EQ(renderable.GetVertexCount(), 12u);
+
+    renderable.SetLODLevel(-1);
+    EXPECT_EQ(renderable.GetVertexCount(), 12u);
+}
@@ -3,6 +3,7 @@
 #include "Registry.hpp"
 #include "Components.hpp"
 #include "Shapes.hpp"
+#include "SpatialTreeTestUtils.hpp"
 
 class OctreeTest : public ::testing::Test
 {
@@ -21,18 +22,9 @@ protected:
     }
 
     // Helper to create a simple entity with transform and bounding box centred at 'position'
-    Registry::Entity CreateTestEntity(const glm::vec3& position,
-                                      const glm::vec3& scale = glm::vec3(0.1f))
+    Registry::Entity CreateTestEntity(const glm::vec3& position)
     {
-        auto entity = registry->Create();
-        auto& transform = registry->AddComponent<TransformComponent>(entity,
-                                                                    position,
-                                                                    glm::vec3(0.0f),
-                                                                    scale);
-        auto& bounds = registry->AddComponent<BoundingComponent>(entity);
-        bounds.m_AABB = Aabb(position - scale * 0.5f, position + scale * 0.5f);
-        bounds.m_AABBComputed = true;
-        return entity;
+        return SpatialTreeTestUtils::CreateBoxEntity(*registry, position);
     }
 
     std::unique_ptr<Registry> registry;
@@ -94,11 +86,11 @@ TEST_F(OctreeTest, Stress32Objects)
     int totalObjects = 0;
     for (int i = 0; i < 8; ++i)
     {
-        const TreeNode* child = root->children[i].get();
+        const TreeNode* child = root->children[i];
         ASSERT_NE(child, nullptr) << "Child " << i << " should exist";
         EXPECT_EQ(child->pObjects.size(), 4u) << "Child " << i << " should contain 4 objects";
         totalObjects += static_cast<int>(child->pObjects.size());
     }
 
     EXPECT_EQ(totalObjects, 32);
-} 
\ No newline at end of file
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "Profiler.hpp"
+#include <thread>
+
+class ProfilerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Profiler::Get().ClearHistory();
+        Profiler::Get().SetPaused(false);
+        Profiler::Get().SetEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        Profiler::Get().SetEnabled(false);
+        Profiler::Get().ClearHistory();
+    }
+
+    void RunFrame(const std::function<void()>& body)
+    {
+        Profiler::Get().BeginFrame();
+        body();
+        Profiler::Get().EndFrame();
+    }
+};
+
+// Disabled zones are not recorded and no frame is kept
+TEST_F(ProfilerTest, DisabledRecordsNothing)
+{
+    Profiler::Get().SetEnabled(false);
+    RunFrame([] { PROFILE_SCOPE("Ignored"); });
+    EXPECT_TRUE(Profiler::Get().GetHistory().empty());
+}
+
+// Nested zones record their depth and are contained in their parent
+TEST_F(ProfilerTest, NestedZonesRecordDepth)
+{
+    RunFrame([]
+    {
+        PROFILE_SCOPE("Outer");
+        PROFILE_SCOPE("Inner");
+    });
+
+    ASSERT_EQ(Profiler::Get().GetHistory().size(), 1u);
+    const auto& zones = Profiler::Get().GetHistory().back().m_Zones;
+    ASSERT_EQ(zones.size(), 2u);
+
+    const ProfileZoneRecord& outer = std::string(zones[0].m_Name) == "Outer" ? zones[0] : zones[1];
+    const ProfileZoneRecord& inner = std::string(zones[0].m_Name) == "Inner" ? zones[0] : zones[1];
+    EXPECT_EQ(outer.m_Depth, 0u);
+    EXPECT_EQ(inner.m_Depth, 1u);
+    EXPECT_LE(outer.m_StartNs, inner.m_StartNs);
+    EXPECT_GE(outer.m_EndNs, inner.m_EndNs);
+}
+
+// Zones from other threads land in the frame with their own thread index
+TEST_F(ProfilerTest, CollectsZonesFromWorkerThreads)
+{
+    uint32_t mainThread = 0;
+    RunFrame([&]
+    {
+        { PROFILE_SCOPE("MainZone"); }
+        std::thread worker([] { PROFILE_SCOPE("WorkerZone"); });
+        worker.join();
+    });
+
+    const auto& zones = Profiler::Get().GetHistory().back().m_Zones;
+    ASSERT_EQ(zones.size(), 2u);
+    for (const auto& zone : zones)
+    {
+        if (std::string(zone.m_Name) == "MainZone")
+            mainThread = zone.m_ThreadIndex;
+    }
+    for (const auto& zone : zones)
+    {
+        if (std::string(zone.m_Name) == "WorkerZone")
+        {
+            EXPECT_NE(zone.m_ThreadIndex, mainThread);
+        }
+    }
+}
+
+// The history is bounded and statistics count one sample per frame
+TEST_F(ProfilerTest, HistoryIsBoundedAndStatsPerFrame)
+{
+    const size_t previousSize = Profiler::Get().GetHistorySize();
+    Profiler::Get().SetHistorySize(4);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        RunFrame([]
+        {
+            { PROFILE_SCOPE("Repeated"); }
+            { PROFILE_SCOPE("Repeated"); }
+        });
+    }
+
+    EXPECT_EQ(Profiler::Get().GetHistory().size(), 4u);
+
+    auto stats = Profiler::Get().ComputeZoneStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].m_Name, "Repeated");
+    EXPECT_EQ(stats[0].m_Frames, 4u);
+    EXPECT_DOUBLE_EQ(stats[0].m_CallsPerFrame, 2.0);
+    EXPECT_LE(stats[0].m_P50Ms, stats[0].m_P95Ms);
+    EXPECT_LE(stats[0].m_P95Ms, stats[0].m_MaxMs);
+
+    Profiler::Get().SetHistorySize(previousSize);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "Registry.hpp"
+#include "Components.hpp"
+
+namespace
+{
+    bool Contains(const std::vector<Registry::Entity>& entities, Registry::Entity entity)
+    {
+        return std::find(entities.begin(), entities.end(), entity) != entities.end();
+    }
+}
+
+// Each consumer sees every change once, independently of the others
+TEST(RegistryTest, ConsumersTrackChangesIndependently)
+{
+    Registry registry;
+    registry.TrackChanges<TransformComponent>();
+    Registry::ChangeConsumerId first = registry.RegisterChangeConsumer();
+    Registry::ChangeConsumerId second = registry.RegisterChangeConsumer();
+
+    Registry::Entity a = registry.Create();
+    Registry::Entity b = registry.Create();
+    registry.AddComponent<TransformComponent>(a);
+    registry.AddComponent<TransformComponent>(b);
+
+    const Registry::ChangeSet& created = registry.ConsumeChanges(first);
+    EXPECT_EQ(created.m_Changed.size(), 2u);
+    EXPECT_TRUE(created.m_Removed.empty());
+
+    // Repeated edits of one entity are reported once
+    for (int i = 0; i < 5; ++i)
+    {
+        registry.GetComponent<TransformComponent>(a).m_Position.x += 1.0f;
+        registry.MarkChanged<TransformComponent>(a);
+    }
+
+    const Registry::ChangeSet& moved = registry.ConsumeChanges(first);
+    ASSERT_EQ(moved.m_Changed.size(), 1u);
+    EXPECT_EQ(moved.m_Changed[0], a);
+    EXPECT_TRUE(registry.ConsumeChanges(first).Empty());
+
+    // The second consumer has not consumed anything yet
+    EXPECT_EQ(registry.GetPendingChangeCount(second), 2u);
+    const Registry::ChangeSet& all = registry.ConsumeChanges(second);
+    EXPECT_TRUE(Contains(all.m_Changed, a));
+    EXPECT_TRUE(Contains(all.m_Changed, b));
+}
+
+// Destroyed entities move from the changed list to the removed list
+TEST(RegistryTest, DestroyedEntitiesAreReportedAsRemoved)
+{
+    Registry registry;
+    registry.TrackChanges<TransformComponent>();
+    Registry::ChangeConsumerId consumer = registry.RegisterChangeConsumer();
+
+    Registry::Entity a = registry.Create();
+    Registry::Entity b = registry.Create();
+    registry.AddComponent<TransformComponent>(a);
+    registry.AddComponent<TransformComponent>(b);
+    registry.ConsumeChanges(consumer);
+
+    registry.MarkChanged<TransformComponent>(a);
+    registry.Destroy(a);
+    registry.RemoveComponent<TransformComponent>(b);
+
+    const Registry::ChangeSet& changes = registry.ConsumeChanges(consumer);
+    EXPECT_TRUE(changes.m_Changed.empty());
+    EXPECT_EQ(changes.m_Removed.size(), 2u);
+    EXPECT_TRUE(Contains(changes.m_Removed, a));
+    EXPECT_TRUE(Contains(changes.m_Removed, b));
+}
+
+// An entity slot destroyed, recycled and destroyed again before a drain is reported once
+TEST(RegistryTest, RecycledEntityDestroyedTwiceBeforeDrain)
+{
+    Registry registry;
+    registry.TrackChanges<TransformComponent>();
+    Registry::ChangeConsumerId consumer = registry.RegisterChangeConsumer();
+
+    Registry::Entity first = registry.Create();
+    registry.AddComponent<TransformComponent>(first);
+    registry.ConsumeChanges(consumer);
+    registry.Destroy(first);
+
+    Registry::Entity recycled = registry.Create();
+    ASSERT_EQ(entt::to_entity(recycled), entt::to_entity(first));
+    ASSERT_NE(recycled, first);
+    registry.AddComponent<TransformComponent>(recycled);
+    registry.Destroy(recycled);
+
+    const Registry::ChangeSet& changes = registry.ConsumeChanges(consumer);
+    EXPECT_TRUE(changes.m_Changed.empty());
+    ASSERT_EQ(changes.m_Removed.size(), 1u);
+    EXPECT_EQ(changes.m_Removed[0], first);
+
+    // The slot is free again for the next cycle
+    Registry::Entity third = registry.Create();
+    registry.AddComponent<TransformComponent>(third);
+    registry.Destroy(third);
+    ASSERT_EQ(registry.ConsumeChanges(consumer).m_Removed.size(), 1u);
+}
+
+// Untracked components and unregistered consumers collect nothing
+TEST(RegistryTest, OnlyTrackedComponentsAndActiveConsumers)
+{
+    Registry registry;
+    registry.TrackChanges<TransformComponent>();
+    Registry::ChangeConsumerId consumer = registry.RegisterChangeConsumer();
+
+    Registry::Entity a = registry.Create();
+    registry.AddComponent<RenderComponent>(a);
+    EXPECT_TRUE(registry.ConsumeChanges(consumer).Empty());
+
+    registry.UnregisterChangeConsumer(consumer);
+    registry.AddComponent<TransformComponent>(a);
+
+    // The freed ID is reused and starts clean
+    Registry::ChangeConsumerId reused = registry.RegisterChangeConsumer();
+    EXPECT_EQ(reused, consumer);
+    EXPECT_EQ(registry.GetPendingChangeCount(reused), 0u);
+}
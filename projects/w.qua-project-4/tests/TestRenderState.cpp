@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "RenderState.hpp"
+#include "NullRenderable.hpp"
+#include "JobSystem.hpp"
+
+// Within a pass, filled draws precede wireframe ones and each program stays grouped
+TEST(RenderStateTest, DrawSortKeyGroupsByModeThenProgram)
+{
+    EXPECT_LT(MakeDrawSortKey(false, 9, 9), MakeDrawSortKey(true, 1, 1));
+    EXPECT_LT(MakeDrawSortKey(false, 1, 9), MakeDrawSortKey(false, 2, 1));
+    EXPECT_LT(MakeDrawSortKey(false, 1, 1), MakeDrawSortKey(false, 1, 2));
+}
+
+TEST(RenderStateTest, DrawSortKeyGroupsByPassFirst)
+{
+    uint64_t lastMesh = MakeDrawSortKey(true, 0x07FFFFFF, ~0u, RenderPass::Meshes);
+    uint64_t firstBox = MakeDrawSortKey(false, 0, 0, RenderPass::BoundingVolumes);
+    EXPECT_LT(lastMesh, firstBox);
+    EXPECT_LT(firstBox, MakeDrawSortKey(false, 0, 0, RenderPass::OctreeCells));
+
+    uint64_t key = MakeDrawSortKey(true, 42, 7, RenderPass::KDTreeCells);
+    EXPECT_EQ(GetSortKeyPass(key), RenderPass::KDTreeCells);
+    EXPECT_TRUE(GetSortKeyWireframe(key));
+    EXPECT_EQ(GetSortKeyProgram(key), 42u);
+}
+
+// Merging per-job draw lists gives the same order as one stable sort, on any worker count
+TEST(RenderStateTest, MergedDrawRunsMatchStableSort)
+{
+    NullRenderable renderable(3);
+    std::vector<DrawItem> draws;
+    std::vector<size_t> runOffsets = { 0 };
+    for (size_t run = 0; run < 7; ++run)
+    {
+        size_t first = draws.size();
+        for (size_t i = 0; i < 50 + run * 13; ++i)
+        {
+            DrawItem draw;
+            draw.m_SortKey    = MakeDrawSortKey(i % 3 == 0, static_cast<GLuint>((i * 7 + run) % 4), 1, static_cast<RenderPass>(i % 2));
+            draw.m_Renderable = &renderable;
+            draw.m_Indirect   = i % 5 == 0;
+            draw.m_Model      = glm::mat4(static_cast<float>(run * 1000 + i)); // Identifies the draw
+            draws.push_back(draw);
+        }
+        std::stable_sort(draws.begin() + first, draws.end());
+        runOffsets.push_back(draws.size());
+    }
+
+    std::vector<DrawItem> expected = draws;
+    std::stable_sort(expected.begin(), expected.end());
+
+    for (size_t workers : { size_t(0), size_t(3) })
+    {
+        JobSystem::Get().Initialize(workers);
+        std::vector<DrawItem> merged = draws;
+        std::vector<size_t> offsets = runOffsets;
+        MergeDrawRuns(merged, offsets);
+        JobSystem::Get().Shutdown();
+
+        EXPECT_EQ(offsets, std::vector<size_t>({ 0, draws.size() }));
+        ASSERT_EQ(merged.size(), expected.size());
+        for (size_t i = 0; i < merged.size(); ++i)
+        {
+            EXPECT_EQ(merged[i].m_SortKey, expected[i].m_SortKey) << "draw " << i;
+            EXPECT_EQ(merged[i].m_Model, expected[i].m_Model) << "draw " << i;
+        }
+    }
+
+    // Batched meshes lead the draws sharing their key
+    DrawItem direct;
+    direct.m_SortKey = 0;
+    DrawItem batched = direct;
+    batched.m_Indirect = true;
+    EXPECT_TRUE(batched < direct);
+    EXPECT_FALSE(direct < batched);
+}
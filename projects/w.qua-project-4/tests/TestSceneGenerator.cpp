@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "SceneGenerator.hpp"
+#include "Registry.hpp"
+#include "Components.hpp"
+
+namespace
+{
+    std::vector<glm::vec3> GeneratePositions(const SceneGeneratorConfig& config)
+    {
+        Registry registry;
+        std::vector<glm::vec3> positions;
+        for (auto entity : SceneGenerator::Generate(registry, config))
+        {
+            positions.push_back(registry.GetComponent<TransformComponent>(entity).m_Position);
+        }
+        return positions;
+    }
+}
+
+// Every distribution creates the requested number of mesh-free, bounded entities
+TEST(SceneGeneratorTest, CreatesRequestedCount)
+{
+    for (int d = 0; d < static_cast<int>(SceneDistribution::Count); ++d)
+    {
+        Registry registry;
+        SceneGeneratorConfig config;
+        config.m_ObjectCount  = 500;
+        config.m_Distribution = static_cast<SceneDistribution>(d);
+
+        auto entities = SceneGenerator::Generate(registry, config);
+        ASSERT_EQ(entities.size(), 500u) << SceneGenerator::GetDistributionName(config.m_Distribution);
+
+        for (auto entity : entities)
+        {
+            ASSERT_TRUE(registry.HasComponent<TransformComponent>(entity));
+            auto& bounds = registry.GetComponent<BoundingComponent>(entity);
+            // Every volume is filled in directly, without a mesh resource
+            EXPECT_GT(bounds.GetAABB().GetExtents().x, 0.0f);
+            EXPECT_GT(bounds.GetPCASphere().radius, 0.0f);
+            EXPECT_GT(bounds.GetOBB().halfExtents.x, 0.0f);
+        }
+    }
+}
+
+// The same seed reproduces the scene, a different seed changes it
+TEST(SceneGeneratorTest, SeedIsDeterministic)
+{
+    SceneGeneratorConfig config;
+    config.m_ObjectCount  = 200;
+    config.m_Distribution = SceneDistribution::GaussianClusters;
+
+    auto first  = GeneratePositions(config);
+    auto second = GeneratePositions(config);
+    EXPECT_EQ(first, second);
+
+    config.m_Seed += 1;
+    auto reseeded = GeneratePositions(config);
+    EXPECT_NE(first, reseeded);
+}
+
+// Uniform and grid scenes stay inside the configured cube
+TEST(SceneGeneratorTest, RespectsHalfSize)
+{
+    for (SceneDistribution d : { SceneDistribution::Uniform, SceneDistribution::Grid })
+    {
+        SceneGeneratorConfig config;
+        config.m_ObjectCount  = 1000;
+        config.m_Distribution = d;
+        config.m_HalfSize     = 10.0f;
+
+        for (const glm::vec3& p : GeneratePositions(config))
+        {
+            EXPECT_LE(std::abs(p.x), 10.0f);
+            EXPECT_LE(std::abs(p.y), 10.0f);
+            EXPECT_LE(std::abs(p.z), 10.0f);
+        }
+    }
+}
+
+// Grid cells are distinct
+TEST(SceneGeneratorTest, GridPositionsAreUnique)
+{
+    SceneGeneratorConfig config;
+    config.m_ObjectCount  = 27;
+    config.m_Distribution = SceneDistribution::Grid;
+
+    auto positions = GeneratePositions(config);
+    for (size_t i = 0; i < positions.size(); ++i)
+        for (size_t j = i + 1; j < positions.size(); ++j)
+            EXPECT_NE(positions[i], positions[j]);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <array>
+#include "SpatialSnapshot.hpp"
+#include "Octree.hpp"
+#include "Registry.hpp"
+#include "Components.hpp"
+#include "Shapes.hpp"
+#include "SpatialTreeUtils.hpp"
+#include "SpatialTreeTestUtils.hpp"
+#include "SceneGenerator.hpp"
+#include "JobSystem.hpp"
+
+class SpatialSnapshotTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        registry = std::make_unique<Registry>();
+    }
+
+    void TearDown() override
+    {
+        JobSystem::Get().Shutdown();
+        registry.reset();
+    }
+
+    // Entity with a transform and a unit local AABB, moved to 'position' and scaled by 'scale'
+    Registry::Entity CreateTestEntity(const glm::vec3& position, const glm::vec3& scale = glm::vec3(1.0f))
+    {
+        return SpatialTreeTestUtils::CreateBoxEntity(*registry, position, scale, Aabb(glm::vec3(-0.5f), glm::vec3(0.5f)));
+    }
+
+    std::unique_ptr<Registry> registry;
+};
+
+// Every bounded entity is captured with its world AABB, in aligned arrays
+TEST_F(SpatialSnapshotTest, CapturesWorldBounds)
+{
+    SpatialSnapshot snapshot;
+    snapshot.Build(*registry);
+    EXPECT_TRUE(snapshot.IsEmpty());
+    EXPECT_EQ(snapshot.GetSceneBounds().min, glm::vec3(-1.0f));
+    EXPECT_EQ(snapshot.GetSceneBounds().max, glm::vec3(1.0f));
+
+    std::vector<Registry::Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        entities.push_back(CreateTestEntity(glm::vec3(static_cast<float>(i), 0.0f, -2.0f), glm::vec3(0.5f + i)));
+    }
+    // Without bounds an entity is not part of any spatial structure
+    auto unbounded = registry->Create();
+    registry->AddComponent<TransformComponent>(unbounded, glm::vec3(100.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+
+    uint64_t version = snapshot.GetVersion();
+    snapshot.Build(*registry);
+    EXPECT_GT(snapshot.GetVersion(), version);
+    ASSERT_EQ(snapshot.GetCount(), entities.size());
+    EXPECT_EQ(snapshot.FindIndex(unbounded), SpatialSnapshot::kInvalidIndex);
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(snapshot.GetMin(axis)) % SpatialSnapshot::kAlignment, 0u);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(snapshot.GetMax(axis)) % SpatialSnapshot::kAlignment, 0u);
+    }
+
+    for (Registry::Entity entity : entities)
+    {
+        size_t index = snapshot.FindIndex(entity);
+        ASSERT_NE(index, SpatialSnapshot::kInvalidIndex);
+        EXPECT_EQ(snapshot.GetEntity(index), entity);
+
+        Aabb expected = SpatialTreeUtils::ComputeWorldAabb(*registry, entity);
+        EXPECT_EQ(snapshot.GetBounds(index).min, expected.min);
+        EXPECT_EQ(snapshot.GetBounds(index).max, expected.max);
+    }
+
+    // Destroyed entities stop resolving once the snapshot is rebuilt
+    registry->Destroy(entities.front());
+    snapshot.Build(*registry);
+    EXPECT_EQ(snapshot.GetCount(), entities.size() - 1);
+    EXPECT_EQ(snapshot.FindIndex(entities.front()), SpatialSnapshot::kInvalidIndex);
+    EXPECT_NE(snapshot.FindIndex(entities.back()), SpatialSnapshot::kInvalidIndex);
+}
+
+// The SoA frustum test agrees with the per-object test, serially and on workers
+TEST_F(SpatialSnapshotTest, ClassifyFrustumMatchesPerObjectTest)
+{
+    SceneGeneratorConfig config;
+    config.m_ObjectCount  = 40000;
+    config.m_Distribution = SceneDistribution::GaussianClusters;
+    SceneGenerator::Generate(*registry, config);
+
+    // Slanted planes around a box in the middle of the scene, so all three results occur
+    SpatialSnapshot probe;
+    probe.Build(*registry, false);
+    glm::vec3 center = probe.GetSceneBounds().GetCenter();
+    float reach = probe.GetSceneBounds().GetExtents().x * 0.4f;
+
+    glm::vec3 normals[6];
+    float distances[6];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        glm::vec3 tilt(0.0f);
+        tilt[(axis + 1) % 3] = 0.3f;
+        for (int side = 0; side < 2; ++side)
+        {
+            glm::vec3 n = glm::vec3(0.0f);
+            n[axis] = side == 0 ? 1.0f : -1.0f;
+            n = glm::normalize(n + tilt);
+            normals[axis * 2 + side]   = n;
+            distances[axis * 2 + side] = glm::dot(n, center) + reach;
+        }
+    }
+
+    for (size_t workers : { size_t(0), size_t(3) })
+    {
+        JobSystem::Get().Initialize(workers);
+        SpatialSnapshot snapshot;
+        snapshot.Build(*registry);
+
+        std::vector<SideResult> results;
+        snapshot.ClassifyFrustum(normals, distances, results);
+        ASSERT_EQ(results.size(), snapshot.GetCount());
+
+        std::array<size_t, 3> seen{};
+        for (size_t i = 0; i < snapshot.GetCount(); ++i)
+        {
+            SideResult expected = SpatialTreeUtils::ClassifyFrustumAabb(normals, distances, snapshot.GetBounds(i));
+            ASSERT_EQ(results[i], expected) << "index " << i;
+            ++seen[static_cast<int>(expected) + 1];
+        }
+        EXPECT_GT(seen[0], 0u);
+        EXPECT_GT(seen[1], 0u);
+        EXPECT_GT(seen[2], 0u);
+    }
+}
+
+// A tree reading a shared snapshot rebuilds as soon as the snapshot does
+TEST_F(SpatialSnapshotTest, SharedSnapshotRebuildsTree)
+{
+    for (int i = 0; i < 32; ++i)
+    {
+        CreateTestEntity(glm::vec3(static_cast<float>(i % 4), static_cast<float>(i / 4), 0.0f), glm::vec3(0.1f));
+    }
+
+    SpatialSnapshot snapshot;
+    snapshot.Build(*registry);
+
+    Octree octree(*registry, 4, StraddlingMethod::UseCenter, 5);
+    octree.SetSnapshot(&snapshot);
+    octree.Build();
+    EXPECT_EQ(octree.GetStats().m_ObjectReferences, 32u);
+
+    // The tree reads the snapshot only, so new entities appear once it is rebuilt
+    CreateTestEntity(glm::vec3(2.0f, 2.0f, 1.0f), glm::vec3(0.1f));
+    octree.Build();
+    EXPECT_EQ(octree.GetStats().m_ObjectReferences, 32u);
+
+    snapshot.Build(*registry);
+    octree.Build();
+    EXPECT_EQ(octree.GetStats().m_ObjectReferences, 33u);
+
+    // Detached, the tree gathers on its own again
+    octree.SetSnapshot(nullptr);
+    octree.Build();
+    EXPECT_EQ(octree.GetStats().m_ObjectReferences, 33u);
+}
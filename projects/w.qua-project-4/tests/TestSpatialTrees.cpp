@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "Octree.hpp"
+#include "KDTree.hpp"
+#include "SpatialTreeUtils.hpp"
+#include "SceneGenerator.hpp"
+#include "JobSystem.hpp"
+#include "SpatialTreeTestUtils.hpp"
+
+using SpatialTreeTestUtils::CreateBoxEntity;
+using SpatialTreeTestUtils::MakeBoxPlanes;
+
+// Per-tree construction for the shared tests
+template<typename Tree>
+struct SpatialTreeTraits;
+
+template<>
+struct SpatialTreeTraits<Octree>
+{
+    static constexpr StraddlingMethod kMethods[] = { StraddlingMethod::UseCenter, StraddlingMethod::StayAtCurrentLevel };
+    static constexpr int kMaxDepth = 8;
+
+    // 4 objects per cell to force predictable subdivision
+    static std::unique_ptr<Octree> MakeSmallLeafTree(Registry& registry)
+    {
+        return std::make_unique<Octree>(registry, 4, StraddlingMethod::UseCenter, 5);
+    }
+};
+
+template<>
+struct SpatialTreeTraits<KDTree>
+{
+    static constexpr KdSplitMethod kMethods[] = { KdSplitMethod::MedianCenter, KdSplitMethod::MedianExtent };
+    static constexpr int kMaxDepth = 32;
+
+    static std::unique_ptr<KDTree> MakeSmallLeafTree(Registry& registry)
+    {
+        return std::make_unique<KDTree>(registry, 4, KdSplitMethod::MedianCenter, 10);
+    }
+};
+
+// Compares two subtrees node by node, including object order and content bounds
+static void ExpectSameTree(const TreeNode* a, const TreeNode* b)
+{
+    ASSERT_EQ(a == nullptr, b == nullptr);
+    if (!a)
+        return;
+
+    EXPECT_EQ(a->center, b->center);
+    EXPECT_EQ(a->halfwidth, b->halfwidth);
+    EXPECT_EQ(a->level, b->level);
+    EXPECT_EQ(a->contentBounds.min, b->contentBounds.min);
+    EXPECT_EQ(a->contentBounds.max, b->contentBounds.max);
+    ASSERT_TRUE(std::equal(a->pObjects.begin(), a->pObjects.end(), b->pObjects.begin(), b->pObjects.end()));
+    for (int i = 0; i < 8; ++i)
+    {
+        ExpectSameTree(a->children[i], b->children[i]);
+    }
+}
+
+// KD nodes additionally carry their split plane and cell bounds
+static void ExpectSameTree(const KdNode* a, const KdNode* b)
+{
+    ASSERT_EQ(a == nullptr, b == nullptr);
+    if (!a)
+        return;
+
+    EXPECT_EQ(a->level, b->level);
+    EXPECT_EQ(a->axis, b->axis);
+    EXPECT_EQ(a->split, b->split);
+    EXPECT_EQ(a->bounds.min, b->bounds.min);
+    EXPECT_EQ(a->bounds.max, b->bounds.max);
+    EXPECT_EQ(a->contentBounds.min, b->contentBounds.min);
+    EXPECT_EQ(a->contentBounds.max, b->contentBounds.max);
+    ASSERT_TRUE(std::equal(a->objects.begin(), a->objects.end(), b->objects.begin(), b->objects.end()));
+    ExpectSameTree(a->left, b->left);
+    ExpectSameTree(a->right, b->right);
+}
+
+// Checks that hold for every spatial tree behind the same query and statistics interface
+template<typename Tree>
+class SpatialTreeTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        registry = std::make_unique<Registry>();
+        tree = SpatialTreeTraits<Tree>::MakeSmallLeafTree(*registry);
+    }
+
+    void TearDown() override
+    {
+        tree.reset();
+        registry.reset();
+    }
+
+    std::unique_ptr<Registry> registry;
+    std::unique_ptr<Tree>     tree;
+};
+
+using SpatialTreeTypes = ::testing::Types<Octree, KDTree>;
+TYPED_TEST_SUITE(SpatialTreeTest, SpatialTreeTypes);
+
+// Frustum queries return the same entities as testing every object, with fewer tests
+TYPED_TEST(SpatialTreeTest, QueryFrustumMatchesBruteForce)
+{
+    Registry& registry = *this->registry;
+    TypeParam& tree = *this->tree;
+
+    for (int x = 0; x < 8; ++x)
+        for (int y = 0; y < 8; ++y)
+            for (int z = 0; z < 8; ++z)
+                CreateBoxEntity(registry, glm::vec3(x, y, z) * 0.25f - glm::vec3(0.875f));
+
+    glm::vec3 normals[6];
+    float distances[6];
+    MakeBoxPlanes(glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(0.1f, 1.0f, 1.0f), normals, distances);
+
+    std::vector<Registry::Entity> expected;
+    for (auto entity : registry.View<TransformComponent, BoundingComponent>())
+    {
+        Aabb box = SpatialTreeUtils::ComputeWorldAabb(registry, entity);
+        if (SpatialTreeUtils::ClassifyFrustumAabb(normals, distances, box) != SideResult::eOUTSIDE)
+            expected.push_back(entity);
+    }
+
+    tree.SetQueryStatsEnabled(true);
+    std::vector<Registry::Entity> result;
+    tree.QueryFrustum(normals, distances, result);
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(result.begin(), result.end());
+    EXPECT_EQ(result, expected);
+    EXPECT_GT(result.size(), 0u);
+    EXPECT_LT(result.size(), 512u);
+
+    SpatialTreeStats stats = tree.GetStats();
+    EXPECT_EQ(stats.m_Queries.m_Queries, 1u);
+    EXPECT_EQ(stats.m_Queries.m_Results, result.size());
+    EXPECT_GT(stats.m_Queries.m_CulledSubtrees, 0u);
+    EXPECT_LT(stats.m_Queries.m_NodesVisited, stats.m_NodeCount);
+    EXPECT_LT(stats.m_Queries.m_PrimitivesTested, 512u);
+
+    // Counting is opt-in
+    tree.ResetQueryStats();
+    tree.SetQueryStatsEnabled(false);
+    result.clear();
+    tree.QueryFrustum(normals, distances, result);
+    EXPECT_EQ(tree.GetStats().m_Queries.m_Queries, 0u);
+}
+
+// Structure statistics account for every node, leaf and stored object
+TYPED_TEST(SpatialTreeTest, StatsAccountForEveryNode)
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        CreateBoxEntity(*this->registry, glm::vec3(static_cast<float>(i % 4), static_cast<float>((i / 4) % 4), static_cast<float>(i / 16)) * 0.5f);
+    }
+    this->tree->Build();
+
+    SpatialTreeStats stats = this->tree->GetStats();
+    ASSERT_GT(stats.m_NodeCount, 1u);
+    EXPECT_EQ(stats.m_ObjectReferences, 64u);
+
+    size_t depthTotal = 0;
+    for (size_t count : stats.m_DepthHistogram)
+        depthTotal += count;
+    EXPECT_EQ(depthTotal, stats.m_NodeCount);
+    EXPECT_EQ(stats.m_DepthHistogram.size(), stats.m_MaxDepth + 1);
+
+    size_t leafTotal = 0;
+    for (size_t count : stats.m_LeafOccupancyHistogram)
+        leafTotal += count;
+    EXPECT_EQ(leafTotal, stats.m_LeafCount);
+    EXPECT_EQ(stats.m_LeafOccupancyHistogram[0], stats.m_EmptyLeafCount);
+    EXPECT_GE(stats.GetEmptyLeafRatio(), 0.0);
+    EXPECT_LE(stats.GetEmptyLeafRatio(), 1.0);
+    EXPECT_GT(stats.m_MemoryBytes, 0u);
+}
+
+// Building subtrees as jobs yields exactly the serial tree, for every build method
+TYPED_TEST(SpatialTreeTest, ParallelBuildMatchesSerial)
+{
+    using Traits = SpatialTreeTraits<TypeParam>;
+    Registry& registry = *this->registry;
+
+    SceneGeneratorConfig config;
+    config.m_ObjectCount  = 20000;
+    config.m_Distribution = SceneDistribution::GaussianClusters;
+    SceneGenerator::Generate(registry, config);
+
+    for (auto method : Traits::kMethods)
+    {
+        JobSystem::Get().Initialize(0);
+        TypeParam serial(registry, 8, method, Traits::kMaxDepth);
+        serial.SetParallelBuild(false);
+        serial.Build();
+
+        JobSystem::Get().Initialize(3);
+        TypeParam parallel(registry, 8, method, Traits::kMaxDepth);
+        parallel.Build();
+        JobSystem::Get().Shutdown();
+
+        ExpectSameTree(serial.GetRoot(), parallel.GetRoot());
+        EXPECT_EQ(serial.GetStats().m_ObjectReferences, config.m_ObjectCount);
+        EXPECT_EQ(parallel.GetStats().m_NodeCount, serial.GetStats().m_NodeCount);
+    }
+}
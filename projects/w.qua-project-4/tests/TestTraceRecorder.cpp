@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "TraceRecorder.hpp"
+
+namespace
+{
+    ProfileFrame MakeFrame(uint64_t index, uint64_t startNs, uint64_t endNs)
+    {
+        ProfileFrame frame;
+        frame.m_Index   = index;
+        frame.m_StartNs = startNs;
+        frame.m_EndNs   = endNs;
+        return frame;
+    }
+}
+
+class TraceRecorderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_PreviousWindow = TraceRecorder::Get().GetWindowSeconds();
+        TraceRecorder::Get().Clear();
+    }
+
+    void TearDown() override
+    {
+        TraceRecorder::Get().SetWindowSeconds(m_PreviousWindow);
+        TraceRecorder::Get().Clear();
+    }
+
+    double m_PreviousWindow = 0.0;
+};
+
+// Frames that ended before the capture window are dropped
+TEST_F(TraceRecorderTest, KeepsOnlyTheCaptureWindow)
+{
+    TraceRecorder& recorder = TraceRecorder::Get();
+    recorder.SetWindowSeconds(1.0);
+
+    const uint64_t frameNs = 100'000'000; // 100 ms
+    for (uint64_t i = 0; i < 30; ++i)
+    {
+        recorder.AddFrame(MakeFrame(i, i * frameNs, (i + 1) * frameNs));
+    }
+
+    // The newest frame plus the ten whose end is within one second of it
+    EXPECT_EQ(recorder.GetFrameCount(), 11u);
+    EXPECT_NEAR(recorder.GetBufferedSeconds(), 1.1, 1e-9);
+
+    recorder.SetWindowSeconds(0.5);
+    EXPECT_EQ(recorder.GetFrameCount(), 6u);
+}
+
+// Zones, counters and thread names are written as trace events
+TEST_F(TraceRecorderTest, WritesChromeTraceEvents)
+{
+    static const char* kZoneName = "Zone \"quoted\"";
+
+    std::deque<ProfileFrame> frames;
+    frames.push_back(MakeFrame(7, 1'000, 5'000'000));
+    frames.back().m_Zones.push_back({ kZoneName, 2'000, 3'002'000, 1, 0 });
+    frames.back().m_Counters.push_back({ "Draw Calls", 4'000'000, 42.0 });
+
+    std::ostringstream out;
+    TraceRecorder::WriteChromeTrace(out, frames, { "Main", "Worker" });
+    const std::string json = out.str();
+
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"thread_name\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"Worker\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Zone \\\"quoted\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":2.000,\"dur\":3000.000"), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"C\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":42.000}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Frame 7\",\"ph\":\"i\""), std::string::npos);
+}